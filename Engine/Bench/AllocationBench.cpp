@@ -0,0 +1,153 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Bench.h"
+#include "Memory/FrameArena.h"
+#include "Memory/PoolAllocator.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Memory;
+
+// Every heap allocation of this executable goes through here so Memory/Allocators can count
+// them. The replacement is program wide, which is why this bench is built as TrinVK_AllocBench
+// instead of being linked into TrinVK_Bench where it would slow every other result down.
+// The other new and delete forms forward to these in the standard library.
+namespace {
+    std::atomic<uint64_t> g_heapAllocations{0};
+}
+
+void *operator new(size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    std::free(memory);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<size_t>(alignment);
+    if (void *memory = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) & ~(align - 1))) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+    /// A small per frame object, a particle, a command or a message
+    struct FrameObject {
+        float position[3];
+        float velocity[3];
+        uint32_t id;
+        uint32_t flags;
+    };
+
+    /// Heap allocations made by one call of body, after the warmup that lets every allocator settle
+    template<typename Body>
+    uint64_t heapAllocationsOf(Body &&body) {
+        body();
+        const uint64_t before = g_heapAllocations.load(std::memory_order_relaxed);
+        body();
+        return g_heapAllocations.load(std::memory_order_relaxed) - before;
+    }
+}
+
+TRIN_BENCHMARK("Memory/Allocators") {
+    // One frame's worth of short lived objects, made and thrown away every frame
+    constexpr uint32_t kObjects = 10'000;
+    constexpr uint32_t kMapNodes = 1'000;
+    std::vector<FrameObject *> objects(kObjects);
+    std::vector<std::shared_ptr<FrameObject>> shared(kObjects);
+
+    const auto newFrame = [&] {
+        for (uint32_t i = 0; i < kObjects; i++) {
+            objects[i] = new FrameObject{{}, {}, i, 0};
+        }
+        Bench::doNotOptimize(objects.data());
+        for (FrameObject *object : objects) {
+            delete object;
+        }
+    };
+    const auto sharedFrame = [&] {
+        for (uint32_t i = 0; i < kObjects; i++) {
+            shared[i] = std::make_shared<FrameObject>(FrameObject{{}, {}, i, 0});
+        }
+        Bench::doNotOptimize(shared.data());
+        for (auto &object : shared) {
+            object.reset();
+        }
+    };
+
+    FrameArena arena(kObjects * sizeof(FrameObject) * 2);
+    const auto arenaFrame = [&] {
+        for (uint32_t i = 0; i < kObjects; i++) {
+            objects[i] = arena.create<FrameObject>(FrameObject{{}, {}, i, 0});
+        }
+        Bench::doNotOptimize(objects.data());
+        arena.reset();
+    };
+    const auto poolFrame = [&] {
+        for (uint32_t i = 0; i < kObjects; i++) {
+            objects[i] = new (ThreadPools::allocate(sizeof(FrameObject))) FrameObject{{}, {}, i, 0};
+        }
+        Bench::doNotOptimize(objects.data());
+        for (FrameObject *object : objects) {
+            ThreadPools::deallocate(object, sizeof(FrameObject));
+        }
+    };
+
+    // Node containers, where every insert is its own allocation
+    const auto mapFrame = [&] {
+        std::map<uint32_t, uint32_t> map;
+        for (uint32_t i = 0; i < kMapNodes; i++) {
+            map.emplace(i * 7919u % kMapNodes, i);
+        }
+        Bench::doNotOptimize(map.size());
+    };
+    PoolResource pool;
+    const auto poolMapFrame = [&] {
+        std::pmr::map<uint32_t, uint32_t> map(&pool);
+        for (uint32_t i = 0; i < kMapNodes; i++) {
+            map.emplace(i * 7919u % kMapNodes, i);
+        }
+        Bench::doNotOptimize(map.size());
+    };
+
+    state.measure("10000/new", kObjects, newFrame);
+    state.counter("mallocs_per_frame", static_cast<double>(heapAllocationsOf(newFrame)));
+    state.measure("10000/make_shared", kObjects, sharedFrame);
+    state.counter("mallocs_per_frame", static_cast<double>(heapAllocationsOf(sharedFrame)));
+    state.measure("10000/frame_arena", kObjects, arenaFrame);
+    state.counter("mallocs_per_frame", static_cast<double>(heapAllocationsOf(arenaFrame)));
+    state.measure("10000/thread_pools", kObjects, poolFrame);
+    state.counter("mallocs_per_frame", static_cast<double>(heapAllocationsOf(poolFrame)));
+    state.measure("1000/std_map", kMapNodes, mapFrame);
+    state.counter("mallocs_per_frame", static_cast<double>(heapAllocationsOf(mapFrame)));
+    state.measure("1000/pool_map", kMapNodes, poolMapFrame);
+    state.counter("mallocs_per_frame", static_cast<double>(heapAllocationsOf(poolMapFrame)));
+}
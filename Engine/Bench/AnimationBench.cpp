@@ -0,0 +1,206 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "Animation/AnimationSystem.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Animation;
+
+namespace {
+    constexpr uint32_t kBones = 64;
+    constexpr uint32_t kFrames = 61;    // Two seconds at 30 keys per second, the last key matches the first
+    constexpr float kSampleRate = 30.0f;
+
+    /// Eight chains of eight off a root, the rough shape of a humanoid's spine, limbs and fingers
+    struct Rig {
+        Skeleton skeleton;
+        std::vector<BoneIndex> parents;
+        std::vector<BoneTransform> frames;     // kFrames * kBones raw keys
+        AnimationClip clip;
+
+        Rig() {
+            std::mt19937 rng(11);
+            std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+            std::vector<BoneTransform> bind(kBones);
+            std::vector<Vector3> axes(kBones);
+            parents.resize(kBones);
+            for (uint32_t bone = 0; bone < kBones; bone++) {
+                parents[bone] = bone == 0 ? kNoParentBone : static_cast<BoneIndex>(bone % 8 == 1 ? 0 : bone - 1);
+                bind[bone].translation = Vector3(unit(rng) * 0.1f, 0.2f, unit(rng) * 0.1f);
+                axes[bone] = Vector3(unit(rng), unit(rng), unit(rng)).normalize();
+            }
+            skeleton.init(parents, bind);
+
+            // Most joints swing, a few stay still like they would in a real clip, only the root moves
+            frames.resize(kFrames * kBones);
+            for (uint32_t frame = 0; frame < kFrames; frame++) {
+                const float phase = static_cast<float>(frame) / static_cast<float>(kFrames - 1) * 6.2831853f;
+                for (uint32_t bone = 0; bone < kBones; bone++) {
+                    BoneTransform key = bind[bone];
+                    if (bone % 8 != 7) {
+                        key.rotation = Quaternion::fromAxisAngle(axes[bone], std::sin(phase + bone) * 0.8f);
+                    }
+                    if (bone == 0) {
+                        key.translation = Vector3(std::sin(phase) * 0.2f, 1.0f + std::sin(phase * 2.0f) * 0.05f, 0.0f);
+                    }
+                    frames[frame * kBones + bone] = key;
+                }
+            }
+            AnimationClipCreateInfo info;
+            info.boneCount = kBones;
+            info.frameCount = kFrames;
+            info.sampleRate = kSampleRate;
+            info.frames = frames.data();
+            clip.build(info);
+        }
+
+        /// What the runtime replaces: per bone scalar slerp over raw keys and one matrix chain per bone
+        void animateScalar(float time, std::vector<Matrix4> &model, std::vector<Matrix4> &skinning) const {
+            const float position = std::fmod(time * kSampleRate, static_cast<float>(kFrames - 1));
+            const auto frame0 = static_cast<uint32_t>(position);
+            const uint32_t frame1 = std::min(frame0 + 1, kFrames - 1);
+            const float alpha = position - static_cast<float>(frame0);
+            for (uint32_t bone = 0; bone < kBones; bone++) {
+                const BoneTransform &a = frames[frame0 * kBones + bone];
+                const BoneTransform &b = frames[frame1 * kBones + bone];
+                const Quaternion rotation = Quaternion::slerp(a.rotation, b.rotation, alpha);
+                const Vector3 translation(a.translation.x + (b.translation.x - a.translation.x) * alpha,
+                                          a.translation.y + (b.translation.y - a.translation.y) * alpha,
+                                          a.translation.z + (b.translation.z - a.translation.z) * alpha);
+                const Matrix4 local = rotation.toMatrix(translation, a.scale);
+                model[bone] = parents[bone] == kNoParentBone ? local : model[parents[bone]] * local;
+                skinning[bone] = model[bone] * skeleton.getInverseBind()[bone];
+            }
+        }
+    };
+
+    /// Angle between two rotations, stable for the tiny angles acos loses to rounding
+    float angleBetween(const Quaternion &a, Quaternion b) {
+        if (a.dot(b) < 0.0f) {
+            b = {-b.x, -b.y, -b.z, -b.w};
+        }
+        const Quaternion difference(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+        const Quaternion sum(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+        return 4.0f * std::atan2(std::sqrt(difference.dot(difference)), std::sqrt(sum.dot(sum)));
+    }
+
+    /// A grid of vertices spread over the bones, four influences each
+    SkinnedMesh makeMesh(uint32_t vertexCount) {
+        SkinnedMesh mesh;
+        std::mt19937 rng(12);
+        std::uniform_int_distribution<uint32_t> bone(0, kBones - 1);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            Runtime::Asset::FloatVertex vertex{};
+            vertex.position[0] = static_cast<float>(i % 64) * 0.01f;
+            vertex.position[1] = static_cast<float>(i / 64) * 0.01f;
+            vertex.normal[2] = 1.0f;
+            mesh.vertices.push_back(vertex);
+            const auto first = static_cast<BoneIndex>(bone(rng));
+            mesh.weights.push_back({{first, static_cast<BoneIndex>(bone(rng)), static_cast<BoneIndex>(bone(rng)),
+                                     static_cast<BoneIndex>(bone(rng))}, {0.55f, 0.25f, 0.15f, 0.05f}});
+        }
+        return mesh;
+    }
+}
+
+TRIN_BENCHMARK("Animation/Characters") {
+    constexpr uint32_t kCharacters = 1000;
+    const Rig rig;
+    const AnimationClipStats &clipStats = rig.clip.getStats();
+
+    // Largest rotation error anywhere between keys, against exact slerp of the raw keys
+    LocalPose pose;
+    float worstRadians = 0.0f;
+    for (uint32_t step = 0; step < (kFrames - 1) * 4; step++) {
+        const float time = (static_cast<float>(step) + 0.5f) / (4.0f * kSampleRate);
+        rig.clip.sample(time, pose, true, AnimationInterpolation::Slerp);
+        const float position = time * kSampleRate;
+        const auto frame = static_cast<uint32_t>(position);
+        for (uint32_t bone = 0; bone < kBones; bone++) {
+            const Quaternion exact = Quaternion::slerp(rig.frames[frame * kBones + bone].rotation,
+                                                       rig.frames[(frame + 1) * kBones + bone].rotation,
+                                                       position - static_cast<float>(frame));
+            worstRadians = std::max(worstRadians, angleBetween(readBone(pose, bone).rotation, exact));
+        }
+    }
+
+    std::vector<Matrix4> model(kBones), skinning(kBones);
+    float scalarTime = 0.0f;
+    state.measure("1000/scalar_reference", kCharacters, [&] {
+        scalarTime += 1.0f / 60.0f;
+        for (uint32_t i = 0; i < kCharacters; i++) {
+            rig.animateScalar(scalarTime + static_cast<float>(i) * 0.013f, model, skinning);
+        }
+        Bench::doNotOptimize(skinning);
+    });
+
+    AnimationSystem system;
+    for (uint32_t i = 0; i < kCharacters; i++) {
+        CharacterCreateInfo info;
+        info.skeleton = &rig.skeleton;
+        info.clip = &rig.clip;
+        info.time = static_cast<float>(i) * 0.013f;
+        system.addCharacter(info);
+    }
+    state.measure("1000/nlerp_single_thread", kCharacters, [&] {
+        system.update(1.0f / 60.0f, nullptr);
+    });
+    state.measure("1000/nlerp", kCharacters, [&] {
+        system.update(1.0f / 60.0f);
+    });
+    system.setInterpolation(AnimationInterpolation::Slerp);
+    state.measure("1000/slerp", kCharacters, [&] {
+        system.update(1.0f / 60.0f);
+    });
+    state.counter("bones", system.getStats().bones);
+
+    state.counter("clip_bytes", static_cast<double>(clipStats.compressedBytes));
+    state.counter("uncompressed_bytes", static_cast<double>(clipStats.uncompressedBytes));
+    state.counter("compression_ratio",
+                  static_cast<double>(clipStats.uncompressedBytes) / static_cast<double>(clipStats.compressedBytes));
+    state.counter("animated_rotations", clipStats.rotationTracks);
+    state.counter("max_error_radians", worstRadians);
+    state.counter("threads", Runtime::Core::JobSystem::get().getThreadCount());
+}
+
+TRIN_BENCHMARK("Animation/CpuSkinning") {
+    constexpr uint32_t kCharacters = 100;
+    constexpr uint32_t kVertices = 4096;
+    const Rig rig;
+    const SkinnedMesh mesh = makeMesh(kVertices);
+
+    AnimationSystem system;
+    for (uint32_t i = 0; i < kCharacters; i++) {
+        CharacterCreateInfo info;
+        info.skeleton = &rig.skeleton;
+        info.clip = &rig.clip;
+        info.time = static_cast<float>(i) * 0.013f;
+        info.mesh = &mesh;
+        system.addCharacter(info);
+    }
+
+    // One influence past the skeleton would read beyond the skinning palette every frame
+    SkinnedMesh broken = mesh;
+    broken.weights.back().bones[3] = static_cast<BoneIndex>(kBones);
+    CharacterCreateInfo brokenInfo;
+    brokenInfo.skeleton = &rig.skeleton;
+    brokenInfo.mesh = &broken;
+    state.check(system.addCharacter(brokenInfo) == kInvalidCharacter, "mesh with an out of range bone rejected");
+    state.measure("100x4096/characters", kCharacters, [&] {
+        system.update(1.0f / 60.0f);
+    });
+    state.counter("skinned_vertices", system.getStats().skinnedVertices);
+
+    std::vector<Runtime::Asset::FloatVertex> out(kVertices);
+    const std::vector<Matrix4> &skinning = system.getSkinningMatrices(0);
+    state.measure("4096/vertices", kVertices, [&] {
+        skinVertices(skinning.data(), mesh.vertices.data(), mesh.weights.data(), kVertices, out.data());
+        Bench::doNotOptimize(out);
+    });
+}
@@ -0,0 +1,63 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "Bench.h"
+#include "Asset/MeshCooker.h"
+#include "Asset/MeshLoader.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Asset;
+
+namespace {
+    /// Wavy grid of (side + 1)^2 vertices, roughly what a terrain tile looks like
+    SourceMesh gridMesh(uint32_t side) {
+        SourceMesh mesh;
+        for (uint32_t z = 0; z <= side; z++) {
+            for (uint32_t x = 0; x <= side; x++) {
+                const float fx = static_cast<float>(x), fz = static_cast<float>(z);
+                mesh.positions.insert(mesh.positions.end(), {fx, std::sin(fx * 0.1f) * std::cos(fz * 0.1f) * 4.0f, fz});
+                mesh.uvs.insert(mesh.uvs.end(), {fx / static_cast<float>(side), fz / static_cast<float>(side)});
+            }
+        }
+        for (uint32_t z = 0; z < side; z++) {
+            for (uint32_t x = 0; x < side; x++) {
+                const uint32_t i = z * (side + 1) + x;
+                mesh.indices.insert(mesh.indices.end(), {i, i + side + 1, i + 1, i + 1, i + side + 1, i + side + 2});
+            }
+        }
+        MeshCooker::computeNormals(mesh);
+        return mesh;
+    }
+}
+
+TRIN_BENCHMARK("Asset/Mesh") {
+    const SourceMesh source = gridMesh(255);
+    const std::string path = (std::filesystem::temp_directory_path() / "trin_bench.tmesh").string();
+    const uint32_t vertices = source.getVertexCount();
+
+    MeshCookStats stats;
+    for (const bool quantize : {false, true}) {
+        const std::string variant = quantize ? "quantized" : "float";
+        state.measure("cook_" + variant, vertices, [&] {
+            SourceMesh mesh = source;
+            MeshCooker::cook(mesh, path, {quantize, true}, &stats);
+        });
+        state.counter("vertex_stride", stats.vertexStride);
+        state.counter("file_bytes_per_vertex", static_cast<double>(stats.fileBytes) / vertices);
+        state.counter("acmr", stats.acmrAfter);
+
+        state.measure("load_" + variant, vertices, [&] {
+            CookedMesh mesh;
+            if (mesh.open(path)) {
+                Bench::doNotOptimize(mesh.getVertexData().size() + mesh.getIndexData().size());
+            }
+        });
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,146 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Trin::Bench {
+    struct RunOptions {
+        uint32_t warmup = 3;
+        uint32_t repetitions = 20;
+        std::string filter;         // Only benchmarks whose name contains this run
+    };
+
+    /// Timings of one measured body, every sample is one call in nanoseconds
+    struct Result {
+        std::string name;
+        std::vector<double> samples;
+        uint64_t itemsPerRun = 0;
+        std::vector<std::pair<std::string, double>> counters;
+        std::string skipped;        // Reason, empty when the result was measured
+        std::string failed;         // Check that did not hold, any failure makes the run exit with an error
+    };
+
+/**
+ * Handed to each benchmark function.
+ *
+ * Setup runs once in the function body, measure() then times the piece that matters. A
+ * benchmark may call measure() more than once to compare variants over the same data,
+ * each call becomes its own result named "<benchmark>/<label>".
+ */
+class State {
+public:
+    State(std::string benchmark, const RunOptions &options, std::vector<Result> &results) :
+    m_benchmark(std::move(benchmark)), m_options(options), m_results(results) {}
+
+    /**
+     * @brief Calls body warmup + repetitions times and records the repetitions
+     * @param label Variant name appended to the benchmark name
+     * @param itemsPerRun Work items one call processes, 0 when throughput makes no sense
+     * @param body The code to time, setup belongs outside
+     */
+    template<typename Body>
+    void measure(const std::string &label, uint64_t itemsPerRun, Body &&body) {
+        Result result;
+        result.name = m_benchmark + "/" + label;
+        result.itemsPerRun = itemsPerRun;
+        result.samples.reserve(m_options.repetitions);
+        for (uint32_t i = 0; i < m_options.warmup; i++) {
+            body();
+        }
+        for (uint32_t i = 0; i < m_options.repetitions; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            const auto end = std::chrono::steady_clock::now();
+            result.samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        m_results.push_back(std::move(result));
+    }
+
+    /// Attaches a value to the last measured result, for sizes, ratios and other non timing data
+    void counter(const std::string &name, double value) {
+        if (m_results.empty() || m_results.back().name.rfind(m_benchmark + "/", 0) != 0) {
+            Result holder;
+            holder.name = m_benchmark + "/info";
+            m_results.push_back(std::move(holder));
+        }
+        m_results.back().counters.emplace_back(name, value);
+    }
+
+    /// Median time of the last measured result in nanoseconds, for counters derived from its timing
+    [[nodiscard]] double lastMedian() const {
+        if (m_results.empty() || m_results.back().samples.empty()) {
+            return 0.0;
+        }
+        std::vector<double> samples = m_results.back().samples;
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    /// Records that the benchmark could not run here, for example without a Vulkan device
+    void skip(const std::string &reason) {
+        Result result;
+        result.name = m_benchmark;
+        result.skipped = reason;
+        m_results.push_back(std::move(result));
+    }
+
+    /**
+     * @brief Records a failed correctness check, for benchmarks that also verify what they time
+     * @param condition What should hold
+     * @param what Shown in the results when it doesn't
+     * @return condition, so a benchmark can stop early
+     */
+    bool check(bool condition, const std::string &what) {
+        if (!condition) {
+            Result result;
+            result.name = m_benchmark;
+            result.failed = what;
+            m_results.push_back(std::move(result));
+        }
+        return condition;
+    }
+
+    [[nodiscard]] const RunOptions &getOptions() const { return m_options; }
+
+private:
+    std::string m_benchmark;
+    const RunOptions &m_options;
+    std::vector<Result> &m_results;
+};
+
+    using BenchmarkFn = void (*)(State &);
+
+    /// Adds a benchmark to the global list, used through TRIN_BENCHMARK
+    bool registerBenchmark(const char *name, BenchmarkFn fn);
+
+    /// Keeps the compiler from discarding a value that is computed only to be timed
+    template<typename T>
+    inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+}
+
+/// Defines and registers a benchmark, name is a string such as "Math/Vector3"
+#define TRIN_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define TRIN_BENCHMARK_CONCAT(a, b) TRIN_BENCHMARK_CONCAT_INNER(a, b)
+#define TRIN_BENCHMARK(name) \
+    static void TRIN_BENCHMARK_CONCAT(trinBenchmark, __LINE__)(Trin::Bench::State &state); \
+    [[maybe_unused]] static const bool TRIN_BENCHMARK_CONCAT(trinBenchmarkRegistered, __LINE__) = \
+        Trin::Bench::registerBenchmark(name, TRIN_BENCHMARK_CONCAT(trinBenchmark, __LINE__)); \
+    static void TRIN_BENCHMARK_CONCAT(trinBenchmark, __LINE__)(Trin::Bench::State &state)
+
+#endif //BENCH_H
@@ -0,0 +1,67 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <iostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "Helpers/Console.h"
+
+using namespace Trin;
+
+namespace {
+    /// Swallows everything, so the numbers are the logger and not the terminal
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char *, std::streamsize count) override { return count; }
+    };
+
+    /// Points std::cout at a NullBuffer for as long as it lives
+    class SilenceStdout {
+    public:
+        SilenceStdout() : m_previous(std::cout.rdbuf(&m_null)) {}
+        ~SilenceStdout() { std::cout.rdbuf(m_previous); }
+
+    private:
+        NullBuffer m_null;
+        std::streambuf *m_previous;
+    };
+}
+
+TRIN_BENCHMARK("Helpers/Console") {
+    constexpr uint32_t kMessages = 10000;
+    const std::string message = "Loaded texture Assets/Textures/brick_albedo.ttex in 1.25 ms";
+    SilenceStdout silence;
+
+    state.measure("print", kMessages, [&] {
+        for (uint32_t i = 0; i < kMessages; i++) {
+            Helpers::Console::print(message);
+        }
+    });
+
+    state.measure("warn", kMessages, [&] {
+        for (uint32_t i = 0; i < kMessages; i++) {
+            Helpers::Console::warn(message);
+        }
+    });
+
+    // Every thread goes through the same mutex, this is what logging from jobs costs
+    constexpr uint32_t kThreads = 4;
+    state.measure("print_contended_4", kMessages, [&] {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < kThreads; t++) {
+            threads.emplace_back([&] {
+                for (uint32_t i = 0; i < kMessages / kThreads; i++) {
+                    Helpers::Console::print(message);
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    });
+}
@@ -0,0 +1,63 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "Helpers/File.h"
+#include "Helpers/MappedFile.h"
+
+using namespace Trin;
+
+namespace {
+    /// Writes size bytes of printable text to a file in the temp directory
+    std::string writeTempFile(const char *name, size_t size) {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::ofstream out(path, std::ios::binary);
+        std::string line = "vertex 0.125 0.250 0.500 normal 0.0 1.0 0.0 uv 0.5 0.5\n";
+        for (size_t written = 0; written < size; written += line.size()) {
+            out.write(line.data(), static_cast<std::streamsize>(std::min(line.size(), size - written)));
+        }
+        return path.string();
+    }
+
+    void fileCase(Bench::State &state, const char *label, size_t size) {
+        const std::string path = writeTempFile(label, size);
+        const std::string name(label);
+
+        state.measure(name + "/file_text", size, [&] {
+            Helpers::FileObject *file = Helpers::File::file(path.c_str(), Helpers::FileType::Read);
+            if (file) {
+                const std::string text = file->text();
+                Bench::doNotOptimize(text.size());
+                file->close();
+            }
+        });
+
+        state.measure(name + "/mapped", size, [&] {
+            Helpers::MappedFile mapped;
+            if (mapped.open(path.c_str())) {
+                // Touch a byte per page so the mapping actually gets read
+                uint32_t sum = 0;
+                const std::byte *bytes = mapped.data();
+                for (size_t i = 0; i < mapped.size(); i += 4096) {
+                    sum += static_cast<uint32_t>(bytes[i]);
+                }
+                Bench::doNotOptimize(sum);
+            }
+        });
+
+        std::remove(path.c_str());
+    }
+}
+
+TRIN_BENCHMARK("Helpers/File") {
+    fileCase(state, "trin_bench_64k.txt", 64 * 1024);
+    fileCase(state, "trin_bench_4m.txt", 4 * 1024 * 1024);
+}
@@ -0,0 +1,79 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "Helpers/StringId.h"
+
+using namespace Trin;
+using namespace Trin::Helpers;
+
+TRIN_BENCHMARK("Helpers/StringId") {
+    constexpr uint32_t kNames = 4096;
+    constexpr uint32_t kLookups = 1 << 20;
+
+    std::vector<std::string> names;
+    names.reserve(kNames);
+    for (uint32_t i = 0; i < kNames; i++) {
+        names.push_back("Assets/Materials/Environment/material_" + std::to_string(i) + ".tmat");
+    }
+
+    std::unordered_map<std::string, uint32_t> byString;
+    std::unordered_map<StringId, uint32_t> byId;
+    std::vector<StringId> ids;
+    size_t stringBytes = 0;
+    for (uint32_t i = 0; i < kNames; i++) {
+        byString.emplace(names[i], i);
+        ids.push_back(StringId::intern(names[i]));
+        byId.emplace(ids.back(), i);
+        stringBytes += names[i].capacity() + sizeof(std::string);
+    }
+
+    state.measure("intern", kNames, [&] {
+        uint64_t sum = 0;
+        for (const std::string &name : names) {
+            sum += StringId::intern(name).hash();
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    // Lookups with keys the caller already holds, the usual case for asset and material names
+    state.measure("lookup_string", kLookups, [&] {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < kLookups; i++) {
+            sum += byString.find(names[(i * 7919) % kNames])->second;
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    state.measure("lookup_id", kLookups, [&] {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < kLookups; i++) {
+            sum += byId.find(ids[(i * 7919) % kNames])->second;
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    state.measure("compare_string", kLookups, [&] {
+        uint32_t equal = 0;
+        for (uint32_t i = 0; i < kLookups; i++) {
+            equal += names[i % kNames] == names[(i * 7919) % kNames];
+        }
+        Bench::doNotOptimize(equal);
+    });
+
+    state.measure("compare_id", kLookups, [&] {
+        uint32_t equal = 0;
+        for (uint32_t i = 0; i < kLookups; i++) {
+            equal += ids[i % kNames] == ids[(i * 7919) % kNames];
+        }
+        Bench::doNotOptimize(equal);
+    });
+
+    state.counter("key_bytes_string", static_cast<double>(stringBytes));
+    state.counter("key_bytes_id", static_cast<double>(kNames * sizeof(StringId)));
+}
@@ -0,0 +1,141 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "Math/Matrix4.h"
+#include "Math/Simd.h"
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+#include "Math/Vector4.h"
+
+using namespace Trin;
+using namespace Trin::Math;
+using Trin::Math::Simd::Float4;
+
+namespace {
+    constexpr uint32_t kVectorCount = 1 << 20;
+
+    template<typename T>
+    std::vector<T> randomVectors(uint32_t count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+        std::vector<T> out;
+        out.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            if constexpr (std::is_same_v<T, Vector2>) {
+                out.emplace_back(dist(rng), dist(rng));
+            } else if constexpr (std::is_same_v<T, Vector3>) {
+                out.emplace_back(dist(rng), dist(rng), dist(rng));
+            } else {
+                out.emplace_back(dist(rng), dist(rng), dist(rng), dist(rng));
+            }
+        }
+        return out;
+    }
+}
+
+TRIN_BENCHMARK("Math/Vector2") {
+    const auto a = randomVectors<Vector2>(kVectorCount, 1);
+    const auto b = randomVectors<Vector2>(kVectorCount, 2);
+
+    state.measure("dot", kVectorCount, [&] {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            sum += a[i].dot(b[i]);
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    std::vector<Vector2> out(kVectorCount);
+    state.measure("add", kVectorCount, [&] {
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            Vector2 v = a[i];
+            out[i] = v + b[i];
+        }
+        Bench::doNotOptimize(out.data());
+    });
+}
+
+TRIN_BENCHMARK("Math/Vector3") {
+    const auto a = randomVectors<Vector3>(kVectorCount, 3);
+    const auto b = randomVectors<Vector3>(kVectorCount, 4);
+
+    state.measure("dot", kVectorCount, [&] {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            sum += a[i].dot(b[i]);
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    std::vector<Vector3> out(kVectorCount);
+    state.measure("add", kVectorCount, [&] {
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            Vector3 v = a[i];
+            out[i] = v + b[i];
+        }
+        Bench::doNotOptimize(out.data());
+    });
+
+    state.measure("normalize", kVectorCount, [&] {
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            Vector3 v = a[i];
+            out[i] = v.normalize();
+        }
+        Bench::doNotOptimize(out.data());
+    });
+}
+
+TRIN_BENCHMARK("Math/Vector4") {
+    const auto a = randomVectors<Vector4>(kVectorCount, 5);
+    const auto b = randomVectors<Vector4>(kVectorCount, 6);
+
+    state.measure("dot", kVectorCount, [&] {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            sum += a[i].dot(b[i]);
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    // Same work through the Float4 wrapper, the gap is what a SIMD Vector4 would win
+    state.measure("dot_float4", kVectorCount, [&] {
+        Float4 sum;
+        for (uint32_t i = 0; i < kVectorCount; i++) {
+            sum = Simd::madd(Float4::loadu(&a[i].x), Float4::loadu(&b[i].x), sum);
+        }
+        Bench::doNotOptimize(sum.lane(0) + sum.lane(1) + sum.lane(2) + sum.lane(3));
+    });
+}
+
+TRIN_BENCHMARK("Math/Matrix4") {
+    constexpr uint32_t kCount = 1 << 16;
+    std::vector<Matrix4> matrices;
+    matrices.reserve(kCount);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    for (uint32_t i = 0; i < kCount; i++) {
+        matrices.push_back(Matrix4::trs({dist(rng), dist(rng), dist(rng)}, {dist(rng), dist(rng), dist(rng)}, {1.0f, 2.0f, 1.0f}));
+    }
+    const auto points = randomVectors<Vector3>(kCount, 8);
+
+    std::vector<Matrix4> products(kCount);
+    state.measure("multiply", kCount, [&] {
+        for (uint32_t i = 0; i + 1 < kCount; i++) {
+            Matrix4::multiply(matrices[i], matrices[i + 1], products[i]);
+        }
+        Bench::doNotOptimize(products.data());
+    });
+
+    std::vector<Vector3> transformed(kCount);
+    state.measure("transform_point", kCount, [&] {
+        for (uint32_t i = 0; i < kCount; i++) {
+            transformed[i] = matrices[i].transformPoint(points[i]);
+        }
+        Bench::doNotOptimize(transformed.data());
+    });
+}
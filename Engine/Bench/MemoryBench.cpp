@@ -0,0 +1,146 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "Memory/SlotMap.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Memory;
+
+namespace {
+    /// Roughly what a GPU buffer record holds, Vulkan handles, allocation and bookkeeping
+    struct BufferRecord {
+        uint64_t buffer = 0;
+        uint64_t memory = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t usage = 0;
+        uint32_t flags = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    std::vector<uint32_t> shuffled(uint32_t count, uint32_t seed) {
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+        return order;
+    }
+}
+
+TRIN_BENCHMARK("Memory/SlotMap") {
+    constexpr uint32_t kCount = 100'000;
+    constexpr uint32_t kLookups = 1 << 20;
+    const std::vector<uint32_t> destroyOrder = shuffled(kCount, 1);
+    std::vector<uint32_t> lookupOrder(kLookups);
+    std::mt19937 rng(2);
+    for (uint32_t &index : lookupOrder) {
+        index = rng() % kCount;
+    }
+
+    SlotMap<BufferRecord> buffers;
+    std::vector<Handle<BufferRecord>> handles(kCount);
+    std::vector<std::shared_ptr<BufferRecord>> pointers(kCount);
+
+    state.measure("handle/create_destroy", kCount, [&] {
+        for (uint32_t i = 0; i < kCount; i++) {
+            handles[i] = buffers.create(BufferRecord{i, 0, 0, 256});
+        }
+        for (const uint32_t i : destroyOrder) {
+            buffers.destroy(handles[i]);
+        }
+    });
+
+    state.measure("shared_ptr/create_destroy", kCount, [&] {
+        for (uint32_t i = 0; i < kCount; i++) {
+            pointers[i] = std::make_shared<BufferRecord>(BufferRecord{i, 0, 0, 256});
+        }
+        for (const uint32_t i : destroyOrder) {
+            pointers[i].reset();
+        }
+    });
+
+    // Live sets for the lookup runs, created in order then churned so neither side stays in allocation order
+    for (uint32_t i = 0; i < kCount; i++) {
+        handles[i] = buffers.create(BufferRecord{i, 0, 0, 256});
+        pointers[i] = std::make_shared<BufferRecord>(BufferRecord{i, 0, 0, 256});
+    }
+    for (uint32_t i = 0; i < kCount; i += 3) {
+        const uint32_t victim = destroyOrder[i];
+        buffers.destroy(handles[victim]);
+        handles[victim] = buffers.create(BufferRecord{victim, 0, 0, 256});
+        pointers[victim] = std::make_shared<BufferRecord>(BufferRecord{victim, 0, 0, 256});
+    }
+
+    state.measure("handle/lookup", kLookups, [&] {
+        uint64_t sum = 0;
+        for (const uint32_t i : lookupOrder) {
+            sum += buffers.get(handles[i])->size;
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    state.measure("shared_ptr/lookup", kLookups, [&] {
+        uint64_t sum = 0;
+        for (const uint32_t i : lookupOrder) {
+            sum += pointers[i]->size;
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    // Handing a reference to every draw record of a frame, copies are where the refcount shows up
+    std::vector<Handle<BufferRecord>> handleCopies;
+    std::vector<std::shared_ptr<BufferRecord>> pointerCopies;
+    state.measure("handle/copy", kCount, [&] {
+        handleCopies = handles;
+        Bench::doNotOptimize(handleCopies.data());
+    });
+    state.measure("shared_ptr/copy", kCount, [&] {
+        pointerCopies = pointers;
+        Bench::doNotOptimize(pointerCopies.data());
+    });
+
+    // Every value visited once, the dense array against chasing each pointer
+    state.measure("handle/iterate", kCount, [&] {
+        uint64_t sum = 0;
+        for (const BufferRecord &record : buffers.values()) {
+            sum += record.size;
+        }
+        Bench::doNotOptimize(sum);
+    });
+    state.measure("shared_ptr/iterate", kCount, [&] {
+        uint64_t sum = 0;
+        for (const auto &pointer : pointers) {
+            sum += pointer->size;
+        }
+        Bench::doNotOptimize(sum);
+    });
+
+    // Release with three frames in flight, values are destroyed once their frame completes
+    constexpr uint64_t kFramesInFlight = 3;
+    state.measure("handle/release_collect", kCount, [&] {
+        uint64_t frame = 0;
+        uint64_t destroyed = 0;
+        for (uint32_t i = 0; i < kCount; i++) {
+            if (i % 1000 == 0) {
+                frame++;
+                if (frame > kFramesInFlight) {
+                    buffers.collect(frame - kFramesInFlight, [&](BufferRecord &) { destroyed++; });
+                }
+            }
+            buffers.release(handles[i], frame);
+            handles[i] = buffers.create(BufferRecord{i, 0, 0, 256});
+        }
+        buffers.collect(frame, [&](BufferRecord &) { destroyed++; });
+        Bench::doNotOptimize(destroyed);
+    });
+
+    state.counter("handle_bytes", sizeof(Handle<BufferRecord>));
+    state.counter("shared_ptr_bytes", sizeof(std::shared_ptr<BufferRecord>));
+}
@@ -0,0 +1,137 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "Physics/Broadphase.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Physics;
+
+namespace {
+    /// Boxes on a mostly flat map at a fixed density, so every size sees a similar pair count per body
+    struct BodyField {
+        std::vector<Vector3> position;
+        std::vector<Vector3> velocity;
+        std::vector<Vector3> half;
+        float side = 0.0f;
+
+        BodyField(uint32_t count, uint32_t seed) {
+            std::mt19937 rng(seed);
+            side = std::sqrt(static_cast<float>(count)) * 1.5f;
+            std::uniform_real_distribution<float> across(0.0f, side);
+            std::uniform_real_distribution<float> height(0.0f, 10.0f);
+            std::uniform_real_distribution<float> speed(-0.1f, 0.1f);
+            std::uniform_real_distribution<float> size(0.25f, 1.0f);
+            for (uint32_t i = 0; i < count; i++) {
+                position.emplace_back(across(rng), height(rng), across(rng));
+                velocity.emplace_back(speed(rng), speed(rng) * 0.1f, speed(rng));
+                half.emplace_back(size(rng), size(rng), size(rng));
+            }
+        }
+
+        [[nodiscard]] AABB bounds(uint32_t i) const {
+            const Vector3 &p = position[i];
+            const Vector3 &h = half[i];
+            return {Vector3(p.x - h.x, p.y - h.y, p.z - h.z), Vector3(p.x + h.x, p.y + h.y, p.z + h.z)};
+        }
+
+        /// One frame of motion, bodies bounce off the edges of the map
+        void step() {
+            for (size_t i = 0; i < position.size(); i++) {
+                Vector3 &p = position[i];
+                Vector3 &v = velocity[i];
+                p.set(p.x + v.x, p.y + v.y, p.z + v.z);
+                if (p.x < 0.0f || p.x > side) v.x = -v.x;
+                if (p.y < 0.0f || p.y > 10.0f) v.y = -v.y;
+                if (p.z < 0.0f || p.z > side) v.z = -v.z;
+            }
+        }
+    };
+
+    std::string sizeLabel(uint32_t count) {
+        return count >= 1'000'000 ? std::to_string(count / 1'000'000) + "M" : std::to_string(count / 1000) + "k";
+    }
+}
+
+TRIN_BENCHMARK("Physics/Broadphase") {
+    for (const uint32_t count : {10'000u, 100'000u, 1'000'000u}) {
+        const std::string label = sizeLabel(count);
+        BodyField field(count, 5);
+        Broadphase broadphase;
+        for (uint32_t i = 0; i < count; i++) {
+            broadphase.add(field.bounds(i), i);
+        }
+        broadphase.updatePairs();
+        const uint64_t pairs = broadphase.getPairs().size();
+
+        // Quadratic, only practical at the smallest size
+        if (count <= 10'000) {
+            std::vector<AABB> boxes(count);
+            for (uint32_t i = 0; i < count; i++) {
+                boxes[i] = field.bounds(i);
+            }
+            uint64_t naivePairs = 0;
+            state.measure(label + "/naive", pairs, [&] {
+                naivePairs = 0;
+                for (uint32_t i = 0; i < count; i++) {
+                    for (uint32_t j = i + 1; j < count; j++) {
+                        naivePairs += boxes[i].overlaps(boxes[j]);
+                    }
+                }
+                Bench::doNotOptimize(naivePairs);
+            });
+            state.counter("naive_pairs", static_cast<double>(naivePairs));
+            // The naive count is the ground truth, a broadphase that disagrees makes its timings meaningless
+            if (!state.check(naivePairs == pairs, "broadphase found " + std::to_string(pairs) + " pairs at " + label +
+                                                      ", the naive test found " + std::to_string(naivePairs))) {
+                return;
+            }
+        }
+
+        // Every body moves every frame, the motion itself is a small part of the time
+        uint64_t added = 0, removed = 0, swaps = 0, frames = 0;
+        state.measure(label + "/frame", pairs, [&] {
+            field.step();
+            for (uint32_t i = 0; i < count; i++) {
+                broadphase.update(i, field.bounds(i));
+            }
+            broadphase.updatePairs();
+            const BroadphaseStats &stats = broadphase.getStats();
+            added += stats.added;
+            removed += stats.removed;
+            swaps += stats.swaps;
+            frames++;
+        });
+        state.counter("pairs", static_cast<double>(broadphase.getPairs().size()));
+        state.counter("added_per_frame", static_cast<double>(added) / static_cast<double>(frames));
+        state.counter("removed_per_frame", static_cast<double>(removed) / static_cast<double>(frames));
+        state.counter("swaps_per_frame", static_cast<double>(swaps) / static_cast<double>(frames));
+        state.counter("axis", broadphase.getStats().axis);
+
+        state.measure(label + "/frame_single_thread", pairs, [&] {
+            field.step();
+            for (uint32_t i = 0; i < count; i++) {
+                broadphase.update(i, field.bounds(i));
+            }
+            broadphase.updatePairs(nullptr);
+        });
+
+        // Worst case for the incremental sort, every body lands somewhere new
+        BodyField scattered(count, 6);
+        state.measure(label + "/teleport_all", pairs, [&] {
+            std::swap(field.position, scattered.position);
+            for (uint32_t i = 0; i < count; i++) {
+                broadphase.update(i, field.bounds(i));
+            }
+            broadphase.updatePairs();
+        });
+        state.counter("resorted", broadphase.getStats().resorted);
+    }
+    state.counter("threads", Runtime::Core::JobSystem::get().getThreadCount());
+}
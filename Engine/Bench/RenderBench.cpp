@@ -0,0 +1,470 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "Asset/TextureFile.h"
+#include "Render/DrawBatcher.h"
+#include "Render/OcclusionCuller.h"
+#include "Render/TextureStreamer.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Render;
+using Trin::Runtime::Asset::TextureFile;
+
+namespace {
+    constexpr uint32_t kRgba8 = 37;     // VK_FORMAT_R8G8B8A8_UNORM
+
+    /// Square RGBA8 texture with its whole mip chain down to 1x1
+    bool writeTexture(const std::string &path, uint32_t size) {
+        std::vector<std::vector<std::byte>> mips;
+        for (uint32_t edge = size; edge > 0; edge /= 2) {
+            mips.emplace_back(TextureFile::getMipSize(kRgba8, edge, edge), std::byte{0x7f});
+        }
+        return TextureFile::write(path, kRgba8, size, size, mips);
+    }
+
+    /// What DrawBatcher::build should produce, from std::sort and a merge that looks at one draw at a time
+    struct ReferenceBatches {
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> instances;
+        std::vector<IndexedIndirectCommand> commands;
+        std::vector<DrawStateGroup> groups;
+    };
+
+    ReferenceBatches referenceBatches(const std::vector<DrawItem> &items, const std::vector<MeshRange> &meshes) {
+        // Ties broken by submission order, the radix sort is stable
+        std::vector<std::pair<uint64_t, uint32_t>> sorted;
+        for (uint32_t i = 0; i < items.size(); i++) {
+            const DrawItem &item = items[i];
+            sorted.emplace_back(DrawKey::make(item.pipeline, item.material, item.mesh, item.depth), i);
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        ReferenceBatches reference;
+        for (uint32_t i = 0; i < sorted.size(); i++) {
+            const DrawItem &item = items[sorted[i].second];
+            reference.keys.push_back(sorted[i].first);
+            reference.instances.push_back(item.objectIndex);
+
+            const bool sameBatch = i > 0 && items[sorted[i - 1].second].pipeline == item.pipeline &&
+                                   items[sorted[i - 1].second].material == item.material &&
+                                   items[sorted[i - 1].second].mesh == item.mesh;
+            if (sameBatch) {
+                reference.commands.back().instanceCount++;
+                continue;
+            }
+            const MeshRange &mesh = meshes[item.mesh];
+            reference.commands.push_back({mesh.indexCount, 1, mesh.firstIndex, mesh.vertexOffset, i});
+
+            if (reference.groups.empty() || reference.groups.back().pipeline != item.pipeline ||
+                reference.groups.back().material != item.material) {
+                reference.groups.push_back({item.pipeline, item.material,
+                                            static_cast<uint32_t>(reference.commands.size() - 1), 0});
+            }
+            reference.groups.back().commandCount++;
+        }
+        return reference;
+    }
+
+    bool sameCommands(const std::vector<IndexedIndirectCommand> &a, const std::vector<IndexedIndirectCommand> &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto &x, const auto &y) {
+            return x.indexCount == y.indexCount && x.instanceCount == y.instanceCount &&
+                   x.firstIndex == y.firstIndex && x.vertexOffset == y.vertexOffset &&
+                   x.firstInstance == y.firstInstance;
+        });
+    }
+
+    bool sameGroups(const std::vector<DrawStateGroup> &a, const std::vector<DrawStateGroup> &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto &x, const auto &y) {
+            return x.pipeline == y.pipeline && x.material == y.material && x.firstCommand == y.firstCommand &&
+                   x.commandCount == y.commandCount;
+        });
+    }
+
+    /// Unit cube from -0.5 to 0.5, twelve triangles
+    void cubeMesh(std::vector<Vector3> &vertices, std::vector<uint32_t> &indices) {
+        vertices.clear();
+        for (int i = 0; i < 8; i++) {
+            vertices.emplace_back(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f);
+        }
+        indices = {0, 2, 1, 1, 2, 3,  4, 5, 6, 5, 7, 6,  0, 1, 4, 1, 5, 4,
+                   2, 6, 3, 3, 6, 7,  0, 4, 2, 2, 4, 6,  1, 3, 5, 3, 7, 5};
+    }
+
+    /**
+     * Stand-in for a command buffer, every vkCmd* call appends one packet. Both paths pay per
+     * call the same way, so this measures the engine side of submission. A real driver adds
+     * its own cost per call on top, which only widens the gap.
+     */
+    struct CommandStream {
+        std::vector<uint32_t> words;
+
+        void bindState(uint32_t pipeline, uint32_t material) {
+            words.insert(words.end(), {1u, pipeline, material});
+        }
+
+        void drawIndexed(const MeshRange &mesh, uint32_t firstInstance) {
+            words.insert(words.end(), {2u, mesh.indexCount, 1u, mesh.firstIndex,
+                                       static_cast<uint32_t>(mesh.vertexOffset), firstInstance});
+        }
+
+        void drawIndexedIndirectCount(uint32_t firstCommand, uint32_t countIndex, uint32_t maxDraws) {
+            words.insert(words.end(), {3u, firstCommand, countIndex, maxDraws});
+        }
+    };
+}
+
+TRIN_BENCHMARK("Render/OcclusionCuller") {
+    {
+        // Known occluder first, an identity view projection puts a 64x64 buffer's pixel p at
+        // NDC p / 32 - 1. The quad's edges run exactly through the centers of columns and rows
+        // 16 and 48, which the top-left rule gives to the left and top edges only
+        constexpr float kLeft = 16.5f / 32.0f - 1.0f, kRight = 48.5f / 32.0f - 1.0f;
+        const std::vector<Vector3> quad = {{kLeft, kLeft, 0.5f}, {kRight, kLeft, 0.5f},
+                                           {kRight, kRight, 0.5f}, {kLeft, kRight, 0.5f}};
+        const std::vector<uint32_t> quadIndices = {0, 1, 2, 0, 2, 3};
+        const auto pixels = [](float first, float last) { return std::pair(first / 32.0f - 1.0f, last / 32.0f - 1.0f); };
+
+        OcclusionCuller known(64, 64);
+        known.beginFrame(Matrix4::identity());
+        known.addOccluder(quad, quadIndices, Matrix4::identity());
+        known.rasterize(nullptr);
+
+        const std::vector<float> &depth = known.getDepthBuffer();
+        state.check(std::count(depth.begin(), depth.end(), 0.5f) == 32 * 32, "quad covers exactly 32x32 pixels");
+        state.check(depth[32 * 64 + 16] == 0.5f && depth[16 * 64 + 32] == 0.5f, "left and top edges own their pixels");
+        state.check(depth[32 * 64 + 48] == 1.0f && depth[48 * 64 + 32] == 1.0f, "right and bottom edges do not");
+
+        const auto box = [&](std::pair<float, float> x, std::pair<float, float> y, float near, float far) {
+            return AABB({x.first, y.first, near}, {x.second, y.second, far});
+        };
+        const auto center = pixels(26.0f, 38.0f), rightColumn = pixels(48.1f, 48.9f);
+        const auto leftColumn = pixels(16.1f, 16.9f), middleRow = pixels(32.1f, 32.6f);
+        state.check(!known.isVisible(box(center, center, 0.6f, 0.9f)), "box behind the quad culled");
+        state.check(known.isVisible(box(center, center, 0.2f, 0.3f)), "box in front of the quad kept");
+        state.check(known.isVisible(box(pixels(52.0f, 60.0f), center, 0.6f, 0.9f)), "box beside the quad kept");
+        state.check(known.isVisible(box(pixels(40.0f, 56.0f), center, 0.6f, 0.9f)), "box straddling an edge kept");
+        state.check(!known.isVisible(box(leftColumn, middleRow, 0.6f, 0.9f)), "box in the left edge column culled");
+        state.check(known.isVisible(box(rightColumn, middleRow, 0.6f, 0.9f)), "box in the right edge column kept");
+    }
+
+    // Synthetic city, a grid of tall buildings with props scattered between and behind them
+    constexpr int kBlocks = 16;
+    constexpr float kBlockSize = 40.0f;
+    constexpr uint32_t kProps = 100'000;
+
+    std::vector<Vector3> cubeVertices;
+    std::vector<uint32_t> cubeIndices;
+    cubeMesh(cubeVertices, cubeIndices);
+
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> height(20.0f, 80.0f);
+    std::vector<Matrix4> buildings;
+    for (int x = 0; x < kBlocks; x++) {
+        for (int z = 0; z < kBlocks; z++) {
+            const float h = height(rng);
+            const Vector3 center((static_cast<float>(x) - kBlocks * 0.5f) * kBlockSize, h * 0.5f,
+                                 static_cast<float>(z) * kBlockSize + 20.0f);
+            buildings.push_back(Matrix4::trs(center, {0.0f, 0.0f, 0.0f}, {28.0f, h, 28.0f}));
+        }
+    }
+
+    std::uniform_real_distribution<float> spreadX(-kBlocks * kBlockSize * 0.5f, kBlocks * kBlockSize * 0.5f);
+    std::uniform_real_distribution<float> spreadZ(10.0f, kBlocks * kBlockSize);
+    std::vector<AABB> props;
+    props.reserve(kProps);
+    for (uint32_t i = 0; i < kProps; i++) {
+        const Vector3 base(spreadX(rng), 0.0f, spreadZ(rng));
+        props.emplace_back(Vector3(base.x - 1.0f, 0.0f, base.z - 1.0f), Vector3(base.x + 1.0f, 3.0f, base.z + 1.0f));
+    }
+
+    // Street level camera looking down the avenue
+    const Matrix4 projection = Matrix4::perspective(1.2f, 16.0f / 9.0f, 0.5f, 2000.0f);
+    const Matrix4 view = Matrix4::lookAt({4.0f, 2.0f, 0.0f}, {4.0f, 2.0f, 100.0f}, {0.0f, 1.0f, 0.0f});
+    Matrix4 viewProjection;
+    Matrix4::multiply(projection, view, viewProjection);
+
+    OcclusionCuller culler;
+    std::vector<uint8_t> visible;
+    const auto drawOccluders = [&] {
+        culler.beginFrame(viewProjection);
+        for (const Matrix4 &world : buildings) {
+            culler.addOccluder(cubeVertices, cubeIndices, world);
+        }
+        culler.rasterize();
+    };
+    state.measure("rasterize", static_cast<uint64_t>(buildings.size()), drawOccluders);
+
+    state.measure("test", kProps, [&] {
+        culler.testVisibility(props, visible);
+    });
+
+    // Stats add up over a frame, so take them from one clean frame
+    drawOccluders();
+    culler.testVisibility(props, visible);
+    const OcclusionStats &stats = culler.getStats();
+    state.counter("culled_percent", stats.culledPercent());
+    state.counter("raster_ms", stats.rasterMs);
+    state.counter("test_ms", stats.testMs);
+}
+
+TRIN_BENCHMARK("Render/DrawBatcher") {
+    constexpr uint32_t kDraws = 100'000;
+    constexpr uint32_t kMeshes = 256;
+
+    std::vector<MeshRange> meshes(kMeshes);
+    for (uint32_t i = 0; i < kMeshes; i++) {
+        meshes[i] = {36 * (1 + i % 8), 36 * i * 8, static_cast<int32_t>(i * 24)};
+    }
+
+    // Typical scene, few pipelines, a few dozen materials and lots of repeated meshes
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> pipeline(0, 3);
+    std::uniform_int_distribution<uint32_t> material(0, 47);
+    std::uniform_int_distribution<uint32_t> mesh(0, kMeshes - 1);
+    std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+
+    DrawBatcher batcher;
+    batcher.setMeshes(meshes);
+    std::vector<DrawItem> items;
+    items.reserve(kDraws);
+    for (uint32_t i = 0; i < kDraws; i++) {
+        items.push_back({pipeline(rng), material(rng), mesh(rng), depth(rng), i});
+        batcher.add(items.back());
+    }
+
+    // Same commands, groups and instance order as sorting and merging the slow way, on both sort paths
+    const ReferenceBatches reference = referenceBatches(items, meshes);
+    for (Runtime::Core::JobSystem *jobs : {&Runtime::Core::JobSystem::get(), static_cast<Runtime::Core::JobSystem *>(nullptr)}) {
+        batcher.build(jobs);
+        state.check(batcher.getSortedKeys() == reference.keys, "sorted keys match std::sort");
+        state.check(batcher.getInstances() == reference.instances, "instance order matches std::sort");
+        state.check(sameCommands(batcher.getCommands(), reference.commands), "commands match the naive merge");
+        state.check(sameGroups(batcher.getGroups(), reference.groups), "groups match the naive merge");
+    }
+
+    // A mesh id past the table, or one that does not fit the key, never reaches build()
+    state.check(!batcher.add({0, 0, kMeshes, 0.5f, kDraws}), "unregistered mesh rejected");
+    state.check(!batcher.add({1u << DrawKey::kPipelineBits, 0, 0, 0.5f, kDraws}), "oversized pipeline rejected");
+    state.check(batcher.getItemCount() == kDraws, "rejected draws not queued");
+
+    state.measure("build", kDraws, [&] {
+        batcher.build();
+    });
+
+    state.measure("build_single_thread", kDraws, [&] {
+        batcher.build(nullptr);
+    });
+
+    // One vkCmdDrawIndexed per item before, one indirect call per state group after
+    state.counter("draws_before", kDraws);
+    state.counter("commands_after", static_cast<double>(batcher.getCommands().size()));
+    state.counter("draw_calls_after", static_cast<double>(batcher.getGroups().size()));
+
+    // Whole submission of a frame, from the queued items to recorded commands
+    items.clear();
+    for (uint32_t i = 0; i < kDraws; i++) {
+        items.push_back({pipeline(rng), material(rng), mesh(rng), depth(rng), i});
+    }
+    CommandStream stream;
+    stream.words.reserve(kDraws * 10);
+    const auto drawsPerMs = [&] { return static_cast<double>(kDraws) / (state.lastMedian() * 1e-6); };
+
+    state.measure("per_item_draws", kDraws, [&] {
+        stream.words.clear();
+        uint32_t boundPipeline = UINT32_MAX, boundMaterial = UINT32_MAX;
+        for (const DrawItem &item : items) {
+            if (item.pipeline != boundPipeline || item.material != boundMaterial) {
+                boundPipeline = item.pipeline;
+                boundMaterial = item.material;
+                stream.bindState(boundPipeline, boundMaterial);
+            }
+            stream.drawIndexed(meshes[item.mesh], item.objectIndex);
+        }
+        Bench::doNotOptimize(stream.words.data());
+    });
+    state.counter("draws_per_ms", drawsPerMs());
+    state.counter("calls", kDraws);
+    const double perItemNs = state.lastMedian();
+
+    // Build, copy into the mapped buffers, then one bind and one indirect call per group
+    std::vector<IndexedIndirectCommand> commandBuffer(kDraws);
+    std::vector<uint32_t> countBuffer(kDraws);
+    std::vector<uint32_t> instanceBuffer(kDraws);
+    state.measure("batched_indirect", kDraws, [&] {
+        batcher.clear();
+        for (const DrawItem &item : items) {
+            batcher.add(item);
+        }
+        batcher.build();
+
+        const auto &commands = batcher.getCommands();
+        const auto &groups = batcher.getGroups();
+        std::copy(commands.begin(), commands.end(), commandBuffer.begin());
+        std::copy(batcher.getInstances().begin(), batcher.getInstances().end(), instanceBuffer.begin());
+        stream.words.clear();
+        for (uint32_t i = 0; i < groups.size(); i++) {
+            countBuffer[i] = groups[i].commandCount;
+            stream.bindState(groups[i].pipeline, groups[i].material);
+            stream.drawIndexedIndirectCount(groups[i].firstCommand, i, groups[i].commandCount);
+        }
+        Bench::doNotOptimize(stream.words.data());
+    });
+    state.counter("draws_per_ms", drawsPerMs());
+    state.counter("calls", static_cast<double>(batcher.getGroups().size()));
+    // Driver time per call above which batching wins, real drivers spend well over this per vkCmdDrawIndexed
+    state.counter("break_even_ns_per_call", (state.lastMedian() - perItemNs) /
+                                            static_cast<double>(kDraws - batcher.getGroups().size()));
+}
+
+TRIN_BENCHMARK("Render/TextureStreamer") {
+    // 256x256 RGBA8, mip 2 (64px) and everything smaller make up the pinned tail
+    constexpr uint32_t kSize = 256;
+    constexpr uint32_t kTailMip = 2;
+    constexpr uint32_t kMipCount = 9;
+    constexpr uint32_t kFiles = 4;
+    std::vector<std::string> paths;
+    for (uint32_t i = 0; i < kFiles; i++) {
+        paths.push_back((std::filesystem::temp_directory_path() / ("trin_bench_" + std::to_string(i) + ".ttex")).string());
+        if (!state.check(writeTexture(paths.back(), kSize), "writing " + paths.back())) {
+            return;
+        }
+    }
+    uint64_t tailBytes = 0;
+    for (uint32_t mip = kTailMip; mip < kMipCount; mip++) {
+        tailBytes += TextureFile::getMipSize(kRgba8, kSize >> mip, kSize >> mip);
+    }
+    const uint64_t mip1Bytes = TextureFile::getMipSize(kRgba8, kSize / 2, kSize / 2);
+
+    // Policy checks against the mock backend. The budget fits every tail plus mip 1 of two
+    // textures, so a third texture asking for detail has to take it from the least recently seen
+    {
+        MockTextureBackend backend;
+        TextureStreamerConfig config;
+        config.budgetBytes = kFiles * tailBytes + 2 * mip1Bytes;
+        TextureStreamer streamer(backend, config);
+
+        std::vector<uint32_t> ids;
+        for (const std::string &path : paths) {
+            ids.push_back(streamer.add(path));
+            if (!state.check(ids.back() != TextureStreamer::kInvalidTexture, "adding " + path)) {
+                return;
+            }
+        }
+        streamer.flush();
+        for (const uint32_t id : ids) {
+            state.check(streamer.getResidentMip(id) == kTailMip && backend.getResidentMip(id) == kTailMip,
+                        "only the mip tail is resident after add");
+        }
+
+        uint64_t frame = 0;
+        const auto runFrame = [&](std::initializer_list<uint32_t> seen) {
+            frame++;
+            for (const uint32_t texture : seen) {
+                streamer.reportScreenSize(ids[texture], static_cast<float>(kSize));
+            }
+            std::vector<uint32_t> before;
+            for (const uint32_t id : ids) {
+                before.push_back(streamer.getResidentMip(id));
+            }
+            streamer.update(frame);
+            const TextureStreamerStats &stats = streamer.getStats();
+            state.check(stats.residentBytes + stats.pendingBytes <= config.budgetBytes,
+                        "resident plus pending bytes stay under the budget");
+            streamer.flush();
+            state.check(backend.getAllocatedBytes() <= config.budgetBytes, "backend memory stays under the budget");
+            for (size_t i = 0; i < ids.size(); i++) {
+                state.check(streamer.getResidentMip(ids[i]) + 1 >= before[i], "one mip level per request");
+            }
+        };
+        const auto resident = [&](uint32_t texture) { return streamer.getResidentMip(ids[texture]); };
+
+        // Wanting mip 0 still streams mip 1 first
+        runFrame({0});
+        state.check(resident(0) == 1, "texture 0 streams mip 1 before mip 0");
+        runFrame({1});
+        state.check(resident(0) == 1 && resident(1) == 1, "textures 0 and 1 hold mip 1");
+
+        // Let the feedback of both go stale, then new demand evicts the least recently seen first
+        for (int i = 0; i < 6; i++) {
+            runFrame({});
+        }
+        runFrame({2});
+        state.check(resident(0) == kTailMip && resident(1) == 1 && resident(2) == 1,
+                    "texture 0, seen longest ago, is evicted first");
+        runFrame({3});
+        state.check(resident(1) == kTailMip && resident(3) == 1, "texture 1 is evicted next");
+        state.check(streamer.getStats().evictedMips == 2, "exactly two mips evicted");
+
+        for (const uint32_t id : ids) {
+            bool tail = streamer.getResidentMip(id) <= kTailMip;
+            for (uint32_t mip = kTailMip; mip < kMipCount; mip++) {
+                tail = tail && backend.hasMip(id, mip);
+            }
+            state.check(tail, "the mip tail is never evicted");
+        }
+    }
+
+    // The tail is pinned even when the budget has no room for anything
+    {
+        MockTextureBackend backend;
+        TextureStreamerConfig config;
+        config.budgetBytes = 0;
+        TextureStreamer streamer(backend, config);
+        const uint32_t id = streamer.add(paths[0]);
+        for (uint64_t frame = 1; frame <= 4; frame++) {
+            streamer.reportScreenSize(id, static_cast<float>(kSize));
+            streamer.update(frame);
+            streamer.flush();
+        }
+        state.check(streamer.getResidentMip(id) == kTailMip && backend.getAllocatedBytes() == tailBytes,
+                    "a zero budget loads the tail and nothing else");
+    }
+
+    // Throughput of a busy scene, 64 textures with a changing quarter of them on screen
+    constexpr uint32_t kTextures = 64;
+    constexpr uint32_t kFramesPerRun = 8;
+    MockTextureBackend backend;
+    TextureStreamerConfig config;
+    config.budgetBytes = kTextures * tailBytes + 16 * mip1Bytes;
+    TextureStreamer streamer(backend, config);
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < kTextures; i++) {
+        ids.push_back(streamer.add(paths[i % kFiles]));
+    }
+    streamer.flush();
+
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<uint32_t> pick(0, kTextures - 1);
+    std::uniform_real_distribution<float> screen(16.0f, 512.0f);
+    uint64_t frame = 0;
+    state.measure("update_flush", kTextures * kFramesPerRun, [&] {
+        for (uint32_t i = 0; i < kFramesPerRun; i++) {
+            for (uint32_t seen = 0; seen < kTextures / 4; seen++) {
+                streamer.reportScreenSize(ids[pick(rng)], screen(rng));
+            }
+            streamer.update(++frame);
+            streamer.flush();
+        }
+    });
+    const TextureStreamerStats &stats = streamer.getStats();
+    state.check(stats.residentBytes <= config.budgetBytes, "resident bytes stay under the budget");
+    state.counter("requests", static_cast<double>(stats.requests));
+    state.counter("evicted_mips", static_cast<double>(stats.evictedMips));
+    state.counter("budget_stalls", static_cast<double>(stats.budgetStalls));
+    state.counter("uploaded_mb", static_cast<double>(backend.getUploadedBytes()) / (1024.0 * 1024.0));
+
+    for (const std::string &path : paths) {
+        std::remove(path.c_str());
+    }
+}
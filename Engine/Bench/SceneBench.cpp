@@ -0,0 +1,226 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "Scene/BoundingVolumeHierarchy.h"
+#include "Scene/TransformHierarchy.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Scene;
+
+TRIN_BENCHMARK("Scene/BoundingVolumeHierarchy") {
+    {
+        // Rays along the axes of a 4x4x4 grid of unit boxes, several starting exactly on the planes
+        // where neighboring boxes touch, so a zero direction component meets a zero offset
+        BoundingVolumeHierarchy grid;
+        std::vector<AABB> cells;
+        for (uint32_t i = 0; i < 64; i++) {
+            const Vector3 min(static_cast<float>(i % 4), static_cast<float>(i / 4 % 4), static_cast<float>(i / 16));
+            cells.emplace_back(min, Vector3(min.x + 1.0f, min.y + 1.0f, min.z + 1.0f));
+            grid.insert(cells.back(), i);
+        }
+        grid.build();
+
+        // Boxes are closed, a ray running along a face touches both boxes sharing it
+        const auto expected = [&](const Ray &ray, float maxDistance) {
+            const float origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+            const float direction[3] = {ray.direction.x, ray.direction.y, ray.direction.z};
+            std::vector<uint32_t> hits;
+            for (uint32_t i = 0; i < cells.size(); i++) {
+                const float min[3] = {cells[i].min.x, cells[i].min.y, cells[i].min.z};
+                const float max[3] = {cells[i].max.x, cells[i].max.y, cells[i].max.z};
+                float tNear = 0.0f, tFar = maxDistance;
+                for (int axis = 0; axis < 3; axis++) {
+                    if (direction[axis] == 0.0f) {
+                        if (origin[axis] < min[axis] || origin[axis] > max[axis]) {
+                            tNear = 1.0f;
+                            tFar = 0.0f;
+                        }
+                        continue;
+                    }
+                    const float t0 = (min[axis] - origin[axis]) / direction[axis];
+                    const float t1 = (max[axis] - origin[axis]) / direction[axis];
+                    tNear = std::max(tNear, std::min(t0, t1));
+                    tFar = std::min(tFar, std::max(t0, t1));
+                }
+                if (tNear <= tFar) {
+                    hits.push_back(i);
+                }
+            }
+            return hits;
+        };
+
+        const Ray rays[] = {
+            {{-1.0f, 1.0f, 0.5f}, {1.0f, 0.0f, 0.0f}},      // Along the face between rows 0 and 1
+            {{-1.0f, 1.0f, 2.0f}, {1.0f, 0.0f, 0.0f}},      // Along the edge shared by four boxes
+            {{2.0f, 5.0f, 3.5f}, {-0.0f, -1.0f, 0.0f}},     // Negative zero on x
+            {{0.5f, 0.5f, -1.0f}, {0.0f, 0.0f, 1.0f}},
+            {{4.0f, 2.5f, 2.5f}, {-1.0f, 0.0f, 0.0f}},      // Starting on the grid's outer face
+            {{5.0f, 0.5f, 0.5f}, {0.0f, 1.0f, 0.0f}},       // Parallel and outside, hits nothing
+        };
+        std::vector<uint32_t> hits;
+        bool allMatch = true;
+        for (const Ray &ray : rays) {
+            hits.clear();
+            grid.queryRay(ray, 100.0f, hits);
+            std::sort(hits.begin(), hits.end());
+            allMatch = allMatch && hits == expected(ray, 100.0f);
+        }
+        state.check(allMatch, "axis aligned rays hit the same boxes as the scalar slab test");
+        hits.clear();
+        grid.queryRay(rays[0], 100.0f, hits);
+        state.check(hits.size() == 8, "ray along a shared face hits both rows");
+    }
+
+    const uint32_t kBoxes = 1'000'000;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+    std::vector<AABB> boxes;
+    boxes.reserve(kBoxes);
+    BoundingVolumeHierarchy bvh;
+    for (uint32_t i = 0; i < kBoxes; i++) {
+        const Vector3 center(position(rng), position(rng) * 0.05f, position(rng));
+        const Vector3 half(size(rng), size(rng), size(rng));
+        boxes.emplace_back(Vector3(center.x - half.x, center.y - half.y, center.z - half.z),
+                           Vector3(center.x + half.x, center.y + half.y, center.z + half.z));
+        bvh.insert(boxes.back(), i);
+    }
+
+    state.measure("build", kBoxes, [&] {
+        bvh.build();
+    });
+    const float builtCost = bvh.getSahCost();
+    state.counter("sah_cost", builtCost);
+
+    const Matrix4 projection = Matrix4::perspective(1.0f, 16.0f / 9.0f, 0.1f, 1500.0f);
+    const Matrix4 view = Matrix4::lookAt({0.0f, 20.0f, 0.0f}, {300.0f, 0.0f, 400.0f}, {0.0f, 1.0f, 0.0f});
+    Matrix4 viewProjection;
+    Matrix4::multiply(projection, view, viewProjection);
+    const Frustum frustum = Frustum::fromMatrix(viewProjection);
+
+    std::vector<uint32_t> visible;
+    visible.reserve(kBoxes);
+    state.measure("frustum_brute_force", kBoxes, [&] {
+        visible.clear();
+        for (uint32_t i = 0; i < kBoxes; i++) {
+            if (frustum.intersects(boxes[i])) {
+                visible.push_back(i);
+            }
+        }
+    });
+    const size_t bruteVisible = visible.size();
+
+    state.measure("frustum_query", kBoxes, [&] {
+        visible.clear();
+        bvh.queryFrustum(frustum, visible);
+    });
+    state.counter("visible", static_cast<double>(visible.size()));
+    state.counter("brute_force_visible", static_cast<double>(bruteVisible));
+
+    state.measure("frustum_query_parallel", kBoxes, [&] {
+        visible.clear();
+        bvh.queryFrustumParallel(frustum, visible);
+    });
+    state.counter("threads", Runtime::Core::JobSystem::get().getThreadCount());
+
+    // Move a tenth of the boxes every frame, then let refit push the changes up
+    std::uniform_real_distribution<float> nudge(-1.0f, 1.0f);
+    state.measure("update_refit_10pct", kBoxes / 10, [&] {
+        for (uint32_t i = 0; i < kBoxes; i += 10) {
+            AABB &box = boxes[i];
+            const Vector3 offset(nudge(rng), 0.0f, nudge(rng));
+            box = AABB(Vector3(box.min.x + offset.x, box.min.y, box.min.z + offset.z),
+                       Vector3(box.max.x + offset.x, box.max.y, box.max.z + offset.z));
+            bvh.update(i, box);
+        }
+        bvh.refit();
+    });
+    state.counter("sah_cost_growth", bvh.getSahCost() / builtCost);
+    state.counter("needs_rebuild", bvh.needsRebuild() ? 1.0 : 0.0);
+}
+
+namespace {
+    /// A forest of small trees, every node hangs off a random earlier node of its tree like props in a level
+    void buildScene(TransformHierarchy &hierarchy, std::vector<TransformId> &ids, uint32_t count, std::mt19937 &rng) {
+        constexpr uint32_t kNodesPerTree = 100;
+        ids.clear();
+        uint32_t treeStart = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (i % kNodesPerTree == 0) {
+                treeStart = i;
+                ids.push_back(hierarchy.create(kInvalidTransform, Matrix4::translation({static_cast<float>(i), 0.0f, 0.0f})));
+                continue;
+            }
+            const TransformId parent = ids[treeStart + rng() % (i - treeStart)];
+            ids.push_back(hierarchy.create(parent, Matrix4::translation({0.0f, 1.0f, 0.5f})));
+        }
+    }
+}
+
+TRIN_BENCHMARK("Scene/TransformHierarchy") {
+    for (const uint32_t count : {10'000u, 100'000u}) {
+        const std::string prefix = std::to_string(count) + "/";
+        const uint32_t moving = count / 100;
+        std::mt19937 rng(21);
+
+        // Creation order is random within each tree, so the first update has to restore the depth first layout
+        std::vector<TransformId> ids;
+        state.measure(prefix + "build", count, [&] {
+            TransformHierarchy hierarchy;
+            buildScene(hierarchy, ids, count, rng);
+            hierarchy.update(nullptr);
+        });
+
+        TransformHierarchy hierarchy;
+        buildScene(hierarchy, ids, count, rng);
+        hierarchy.update();
+
+        std::vector<TransformId> movers(moving);
+        for (TransformId &id : movers) {
+            id = ids[rng() % count];
+        }
+        float angle = 0.0f;
+        state.measure(prefix + "update_1pct", moving, [&] {
+            angle += 0.01f;
+            for (const TransformId id : movers) {
+                hierarchy.setLocal(id, Matrix4::trs({0.0f, 1.0f, 0.5f}, {0.0f, angle, 0.0f}, {1.0f, 1.0f, 1.0f}));
+            }
+            hierarchy.update();
+        });
+        state.counter("nodes_updated", hierarchy.getLastStats().nodesUpdated);
+        state.counter("subtrees_updated", hierarchy.getLastStats().subtreesUpdated);
+
+        // Every root moved, the cost of recomputing the whole scene
+        state.measure(prefix + "update_all", count, [&] {
+            for (uint32_t i = 0; i < count; i += 100) {
+                hierarchy.setLocal(ids[i], Matrix4::translation({static_cast<float>(i), angle, 0.0f}));
+            }
+            hierarchy.update();
+        });
+        state.counter("nodes_updated", hierarchy.getLastStats().nodesUpdated);
+
+        // Spawn and despawn 1% of the leaves, each at a random parent, then one update settles the layout
+        state.measure(prefix + "churn_1pct", moving, [&] {
+            for (uint32_t i = 0; i < moving; i++) {
+                const TransformId parent = ids[rng() % count];
+                TransformId &slot = ids[count - 1 - i];
+                if (hierarchy.isValid(slot) && slot != parent) {
+                    hierarchy.destroy(slot);
+                }
+                if (hierarchy.isValid(parent)) {
+                    slot = hierarchy.create(parent, Matrix4::translation({0.0f, 1.0f, 0.5f}));
+                }
+            }
+            hierarchy.update();
+        });
+        state.counter("nodes", hierarchy.size());
+    }
+}
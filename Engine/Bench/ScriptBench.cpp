@@ -0,0 +1,242 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <array>
+#include <span>
+
+#include "Bench.h"
+#include "Helpers/Console.h"
+#include "Script/ScriptBuilder.h"
+#include "Script/ScriptMath.h"
+#include "Script/ScriptVM.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Script;
+
+namespace {
+    /// fib(n) = n < 2 ? n : fib(n - 1) + fib(n - 2), the usual call heavy microbenchmark
+    Value buildFib(ScriptVM &vm) {
+        const uint16_t global = vm.defineGlobal("fib");
+        FunctionBuilder fib(vm, "fib", 1, 4);
+        const auto recurse = fib.label();
+        fib.emitBx(Op::LoadI, 1, 2);
+        fib.emit(Op::Lt, 1, 0, 1);
+        fib.jump(Op::JmpIfNot, 1, recurse);
+        fib.emit(Op::Return, 0, 1);
+        fib.bind(recurse);
+        fib.emitBx(Op::GetGlobal, 1, global);
+        fib.emit(Op::AddI, 2, 0, static_cast<uint8_t>(-1));
+        fib.emit(Op::Call, 1, 1);
+        fib.emitBx(Op::GetGlobal, 2, global);
+        fib.emit(Op::AddI, 3, 0, static_cast<uint8_t>(-2));
+        fib.emit(Op::Call, 2, 1);
+        fib.emit(Op::Add, 1, 1, 2);
+        fib.emit(Op::Return, 1, 1);
+        const Value function = fib.finish();
+        vm.setGlobal(global, function);
+        return function;
+    }
+
+    /// Sums i * i for i in [1, n] with a numeric for loop
+    Value buildLoop(ScriptVM &vm) {
+        FunctionBuilder loop(vm, "loop", 1, 6);
+        const auto body = loop.label();
+        const auto test = loop.label();
+        loop.emitBx(Op::LoadI, 1, 0);
+        loop.emitBx(Op::LoadI, 2, 1);
+        loop.emit(Op::Move, 3, 0);
+        loop.emitBx(Op::LoadI, 4, 1);
+        loop.jump(Op::ForPrep, 2, test);
+        loop.bind(body);
+        loop.emit(Op::Mul, 5, 2, 2);
+        loop.emit(Op::Add, 1, 1, 5);
+        loop.bind(test);
+        loop.jump(Op::ForLoop, 2, body);
+        loop.emit(Op::Return, 1, 1);
+        return loop.finish();
+    }
+
+    /// make(d) builds a complete binary tree of arrays, check(node) counts its nodes
+    std::pair<Value, Value> buildTrees(ScriptVM &vm) {
+        const uint16_t makeGlobal = vm.defineGlobal("make");
+        const uint16_t checkGlobal = vm.defineGlobal("check");
+
+        FunctionBuilder make(vm, "make", 1, 4);
+        const auto leaf = make.label();
+        make.emit(Op::NewArray, 1, 2);
+        make.emitBx(Op::LoadI, 2, 0);
+        make.emit(Op::Le, 2, 0, 2);
+        make.jump(Op::JmpIf, 2, leaf);
+        for (int child = 0; child < 2; child++) {
+            make.emitBx(Op::GetGlobal, 2, makeGlobal);
+            make.emit(Op::AddI, 3, 0, static_cast<uint8_t>(-1));
+            make.emit(Op::Call, 2, 1);
+            make.emit(Op::Push, 1, 2);
+        }
+        make.bind(leaf);
+        make.emit(Op::Return, 1, 1);
+
+        FunctionBuilder check(vm, "check", 1, 5);
+        const auto inner = check.label();
+        check.emit(Op::Len, 1, 0);
+        check.emitBx(Op::LoadI, 2, 0);
+        check.emit(Op::Eq, 2, 1, 2);
+        check.jump(Op::JmpIfNot, 2, inner);
+        check.emitBx(Op::LoadI, 1, 1);
+        check.emit(Op::Return, 1, 1);
+        check.bind(inner);
+        check.emitBx(Op::GetGlobal, 2, checkGlobal);
+        check.emitBx(Op::LoadI, 3, 0);
+        check.emit(Op::GetIndex, 3, 0, 3);
+        check.emit(Op::Call, 2, 1);
+        check.emitBx(Op::GetGlobal, 3, checkGlobal);
+        check.emitBx(Op::LoadI, 4, 1);
+        check.emit(Op::GetIndex, 4, 0, 4);
+        check.emit(Op::Call, 3, 1);
+        check.emit(Op::Add, 2, 2, 3);
+        check.emit(Op::AddI, 2, 2, 1);
+        check.emit(Op::Return, 2, 1);
+
+        const Value makeFn = make.finish();
+        const Value checkFn = check.finish();
+        vm.setGlobal(makeGlobal, makeFn);
+        vm.setGlobal(checkGlobal, checkFn);
+        return {makeFn, checkFn};
+    }
+
+    /// Instructions one call dispatches, so items per second in the results reads as ops per second
+    uint64_t countInstructions(ScriptVM &vm, Value function, std::span<const Value> args) {
+        const uint64_t before = vm.getExecutedInstructions();
+        if (!vm.call(function, args)) {
+            Helpers::Console::error(vm.getError());
+        }
+        return vm.getExecutedInstructions() - before;
+    }
+
+    /**
+     * Loop of n iterations around a body, the loop counter takes R0 .. R3 so the body can
+     * use R4 and up. Used to compare natives against the same work written in bytecode.
+     */
+    template<typename Body>
+    Value buildLoopAround(ScriptVM &vm, const char *name, uint8_t registers, Body &&emitBody) {
+        FunctionBuilder loop(vm, name, 1, registers);
+        const auto body = loop.label();
+        const auto test = loop.label();
+        loop.emit(Op::Move, 1, 0);
+        loop.emitBx(Op::LoadI, 0, 1);
+        loop.emitBx(Op::LoadI, 2, 1);
+        for (uint8_t reg = 4; reg < registers; reg++) {
+            loop.loadNumber(reg, 0.25 * reg);
+        }
+        loop.jump(Op::ForPrep, 0, test);
+        loop.bind(body);
+        emitBody(loop);
+        loop.bind(test);
+        loop.jump(Op::ForLoop, 0, body);
+        loop.emit(Op::Return, 4, 1);
+        return loop.finish();
+    }
+}
+
+TRIN_BENCHMARK("Script/Interpreter") {
+    ScriptVM vm;
+
+    const Value fib = buildFib(vm);
+    const std::array fibArgs = {Value::number(25)};
+    state.measure("fib25", countInstructions(vm, fib, fibArgs), [&] {
+        Value result;
+        vm.call(fib, fibArgs, &result);
+        Bench::doNotOptimize(result);
+    });
+
+    const Value loop = buildLoop(vm);
+    const std::array loopArgs = {Value::number(1'000'000)};
+    state.measure("for_loop_1M", countInstructions(vm, loop, loopArgs), [&] {
+        Value result;
+        vm.call(loop, loopArgs, &result);
+        Bench::doNotOptimize(result);
+    });
+
+    const auto [make, check] = buildTrees(vm);
+    const std::array treeArgs = {Value::number(14)};
+    const uint64_t cyclesBefore = vm.getHeap().getStats().cycles;
+    uint64_t treeInstructions = vm.getExecutedInstructions();
+    Value sample;
+    vm.call(make, treeArgs, &sample);
+    const std::array sampleArgs = {sample};
+    vm.call(check, sampleArgs);
+    treeInstructions = vm.getExecutedInstructions() - treeInstructions;
+    state.measure("binary_trees14", treeInstructions, [&] {
+        // Nothing allocates between the two calls, the tree only needs to survive inside check
+        Value tree;
+        Value nodes;
+        vm.call(make, treeArgs, &tree);
+        const std::array checkArgs = {tree};
+        vm.call(check, checkArgs, &nodes);
+        Bench::doNotOptimize(nodes);
+    });
+    const ScriptHeapStats &stats = vm.getHeap().getStats();
+    state.counter("gc_cycles", static_cast<double>(stats.cycles - cyclesBefore));
+    state.counter("gc_steps", static_cast<double>(stats.steps));
+    state.counter("arena_kb", static_cast<double>(stats.arenaBytes) / 1024.0);
+}
+
+TRIN_BENCHMARK("Script/Native") {
+    constexpr uint32_t kIterations = 1'000'000;
+    ScriptVM vm;
+    bindMath(vm);
+    vm.bind("bench.noop", [] {});
+    const std::array args = {Value::number(kIterations)};
+
+    // Call overhead on its own, a native with nothing to do against an empty script function
+    const Value noopNative = buildLoopAround(vm, "noop_native", 5, [](FunctionBuilder &body) {
+        body.native(4, "bench.noop");
+    });
+    FunctionBuilder empty(vm, "empty", 0, 1);
+    empty.emit(Op::Return, 0, 0);
+    const uint16_t emptyGlobal = vm.defineGlobal("empty");
+    vm.setGlobal(emptyGlobal, empty.finish());
+    const Value noopScript = buildLoopAround(vm, "noop_script", 5, [&](FunctionBuilder &body) {
+        body.emitBx(Op::GetGlobal, 4, emptyGlobal);
+        body.emit(Op::Call, 4, 0);
+    });
+
+    state.measure("noop/native_call", kIterations, [&] {
+        vm.call(noopNative, args);
+    });
+    state.measure("noop/script_call", kIterations, [&] {
+        vm.call(noopScript, args);
+    });
+
+    // v = normalize(v + d), through Trin::Math against the same math in bytecode
+    const Value vectorNative = buildLoopAround(vm, "vec3_native", 10, [](FunctionBuilder &body) {
+        body.native(4, "vec3.add");
+        body.native(4, "vec3.normalize");
+    });
+    const Value vectorScript = buildLoopAround(vm, "vec3_script", 12, [](FunctionBuilder &body) {
+        body.emit(Op::Add, 4, 4, 7);
+        body.emit(Op::Add, 5, 5, 8);
+        body.emit(Op::Add, 6, 6, 9);
+        body.emit(Op::Mul, 10, 4, 4);
+        body.emit(Op::Mul, 11, 5, 5);
+        body.emit(Op::Add, 10, 10, 11);
+        body.emit(Op::Mul, 11, 6, 6);
+        body.emit(Op::Add, 10, 10, 11);
+        body.native(10, "math.sqrt");
+        body.emit(Op::Div, 4, 4, 10);
+        body.emit(Op::Div, 5, 5, 10);
+        body.emit(Op::Div, 6, 6, 10);
+    });
+
+    state.measure("vec3/native", kIterations, [&] {
+        vm.call(vectorNative, args);
+    });
+    state.counter("instructions_per_iteration",
+                  static_cast<double>(countInstructions(vm, vectorNative, args)) / kIterations);
+    state.measure("vec3/script", kIterations, [&] {
+        vm.call(vectorScript, args);
+    });
+    state.counter("instructions_per_iteration",
+                  static_cast<double>(countInstructions(vm, vectorScript, args)) / kIterations);
+}
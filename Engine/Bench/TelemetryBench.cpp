@@ -0,0 +1,146 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Bench.h"
+#include "Core/Telemetry.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Core;
+
+#ifndef _WIN32
+namespace {
+    /// Leaves a segment behind the way a run in process writer would, true when it was created
+    bool fakeSegment(const char *name, pid_t writer) {
+        const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        void *memory = MAP_FAILED;
+        if (ftruncate(fd, sizeof(TelemetryLayout::Segment)) == 0) {
+            memory = mmap(nullptr, sizeof(TelemetryLayout::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(name);
+            return false;
+        }
+        auto *segment = static_cast<TelemetryLayout::Segment *>(memory);
+        segment->magic = TelemetryLayout::kMagic;
+        segment->processId = static_cast<uint32_t>(writer);
+        munmap(memory, sizeof(TelemetryLayout::Segment));
+        return true;
+    }
+
+    bool segmentExists(const char *name) {
+        const int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        close(fd);
+        return true;
+    }
+}
+#endif
+
+TRIN_BENCHMARK("Core/Telemetry") {
+    constexpr uint32_t kUpdates = 1 << 20;
+    constexpr uint32_t kThreads = 4;
+    const TelemetryCounter counter = Telemetry::counter("bench.counter");
+    const TelemetryGauge gauge = Telemetry::gauge("bench.gauge");
+    const TelemetryHistogram histogram = Telemetry::histogram("bench.histogram");
+
+    state.measure("counter_add", kUpdates, [&] {
+        for (uint32_t i = 0; i < kUpdates; i++) {
+            Telemetry::add(counter);
+        }
+    });
+
+    state.measure("gauge_set", kUpdates, [&] {
+        for (uint32_t i = 0; i < kUpdates; i++) {
+            Telemetry::set(gauge, i);
+        }
+    });
+
+    state.measure("histogram_record", kUpdates, [&] {
+        for (uint32_t i = 0; i < kUpdates; i++) {
+            Telemetry::record(histogram, i & 4095);
+        }
+    });
+
+    // What the per-thread slabs avoid, every thread hammering one shared atomic
+    std::atomic<uint64_t> shared{0};
+    state.measure("contended/shared_atomic_x4", kUpdates * kThreads, [&] {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < kThreads; t++) {
+            threads.emplace_back([&] {
+                for (uint32_t i = 0; i < kUpdates; i++) {
+                    shared.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    });
+    state.measure("contended/telemetry_x4", kUpdates * kThreads, [&] {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < kThreads; t++) {
+            threads.emplace_back([&] {
+                for (uint32_t i = 0; i < kUpdates; i++) {
+                    Telemetry::add(counter);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    });
+
+#ifndef _WIN32
+    // open() may only replace a segment whose writer exited, never one a running process still publishes to
+    if (!Telemetry::isOpen()) {
+        constexpr const char *kOwned = "/trinvk-telemetry-bench-owned";
+        if (fakeSegment(kOwned, getpid())) {
+            state.check(!Telemetry::open(kOwned), "open refuses a segment with a live writer");
+            state.check(segmentExists(kOwned), "a live writer's segment is left in place");
+            shm_unlink(kOwned);
+        }
+
+        constexpr const char *kAbandoned = "/trinvk-telemetry-bench-abandoned";
+        const pid_t child = fork();
+        if (child == 0) {
+            _exit(0);
+        }
+        waitpid(child, nullptr, 0);
+        if (child > 0 && fakeSegment(kAbandoned, child)) {
+            state.check(Telemetry::open(kAbandoned), "open replaces a segment whose writer exited");
+            Telemetry::close();
+            state.check(!segmentExists(kAbandoned), "close removes the segment it created");
+            shm_unlink(kAbandoned);
+        }
+    }
+#endif
+
+    // Publishing without a segment open is a no-op, so give it one for the duration
+    if (!Telemetry::isOpen() && !Telemetry::open("/trinvk-telemetry-bench")) {
+        state.skip("could not create a shared memory segment");
+        return;
+    }
+    uint64_t frame = 0;
+    state.measure("publish", 1, [&] {
+        Telemetry::publish(frame++);
+    });
+    Telemetry::close();
+}
@@ -0,0 +1,63 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <vector>
+
+#include "Bench.h"
+#include "Core/VulkanContext.h"
+
+using namespace Trin;
+using namespace Trin::Runtime::Core;
+
+namespace {
+    /// True when the loader exposes a CPU implementation such as lavapipe or SwiftShader
+    bool hasSoftwareDevice() {
+        VkApplicationInfo appInfo{};
+        appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        appInfo.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+        VkInstanceCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        createInfo.pApplicationInfo = &appInfo;
+
+        VkInstance instance = VK_NULL_HANDLE;
+        if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS) {
+            return false;
+        }
+        uint32_t count = 0;
+        vkEnumeratePhysicalDevices(instance, &count, nullptr);
+        std::vector<VkPhysicalDevice> devices(count);
+        vkEnumeratePhysicalDevices(instance, &count, devices.data());
+
+        bool found = false;
+        for (VkPhysicalDevice device : devices) {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(device, &properties);
+            found |= properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+        }
+        vkDestroyInstance(instance, nullptr);
+        return found;
+    }
+}
+
+TRIN_BENCHMARK("Core/VulkanContext") {
+    if (!hasSoftwareDevice()) {
+        state.skip("no software Vulkan device");
+        return;
+    }
+
+    // Headless on the CPU device so the number means the same thing on every machine
+    VulkanCreateInfo info;
+    info.applicationName = "TrinVK_Bench";
+    info.requiredDeviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+
+    bool failed = false;
+    state.measure("init_shutdown", 0, [&] {
+        VulkanContext context;
+        failed |= !context.init(info);
+        context.shutdown();
+    });
+    if (failed) {
+        state.counter("failed_inits", 1);
+    }
+}
@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Compares two TrinVK_Bench JSON files and flags results that got slower.
+
+Usage: compare_bench.py baseline.json current.json [--threshold 10] [--metric median_ns]
+
+Exits with 1 when any result failed a check or regressed by more than the threshold, so it
+can gate CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as file:
+        data = json.load(file)
+    return {result["name"]: result for result in data.get("results", [])}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percent slowdown that counts as a regression (default 10)")
+    parser.add_argument("--metric", default="median_ns",
+                        help="timing field to compare, e.g. median_ns, p90_ns, min_ns")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    for name, result in sorted(current.items()):
+        if "failed" in result:
+            print(f"{name:<48} FAILED: {result['failed']}")
+            regressions += 1
+
+    print(f"{'benchmark':<48} {'baseline':>14} {'current':>14} {'change':>9}")
+    for name in sorted(set(baseline) | set(current)):
+        before = baseline.get(name)
+        after = current.get(name)
+        if before is None:
+            print(f"{name:<48} {'':>14} {'':>14} {'new':>9}")
+            continue
+        if after is None:
+            print(f"{name:<48} {'':>14} {'':>14} {'missing':>9}")
+            continue
+        if args.metric not in before or args.metric not in after:
+            # Skipped on one side or counters only, nothing to time
+            continue
+
+        old, new = before[args.metric], after[args.metric]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<48} {old:>14.1f} {new:>14.1f} {change:>+8.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{regressions} result(s) failed or regressed by more than {args.threshold}% on {args.metric}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,227 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+namespace Trin::Bench {
+    namespace {
+        struct Registration {
+            const char *name;
+            BenchmarkFn fn;
+        };
+
+        std::vector<Registration> &registry() {
+            static std::vector<Registration> benchmarks;
+            return benchmarks;
+        }
+
+        struct Summary {
+            double min = 0, mean = 0, median = 0, p90 = 0, p99 = 0, max = 0, stddev = 0;
+        };
+
+        /// Linear interpolation between the closest ranks
+        double percentile(const std::vector<double> &sorted, double fraction) {
+            if (sorted.empty()) {
+                return 0.0;
+            }
+            const double rank = fraction * static_cast<double>(sorted.size() - 1);
+            const auto lower = static_cast<size_t>(rank);
+            const size_t upper = std::min(lower + 1, sorted.size() - 1);
+            return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+        }
+
+        Summary summarize(std::vector<double> samples) {
+            Summary summary;
+            if (samples.empty()) {
+                return summary;
+            }
+            std::sort(samples.begin(), samples.end());
+            double total = 0.0;
+            for (const double sample : samples) {
+                total += sample;
+            }
+            summary.min = samples.front();
+            summary.max = samples.back();
+            summary.mean = total / static_cast<double>(samples.size());
+            summary.median = percentile(samples, 0.5);
+            summary.p90 = percentile(samples, 0.9);
+            summary.p99 = percentile(samples, 0.99);
+            double variance = 0.0;
+            for (const double sample : samples) {
+                variance += (sample - summary.mean) * (sample - summary.mean);
+            }
+            summary.stddev = std::sqrt(variance / static_cast<double>(samples.size()));
+            return summary;
+        }
+
+        std::string escape(const std::string &text) {
+            std::string out;
+            for (const char c : text) {
+                if (c == '"' || c == '\\') {
+                    out.push_back('\\');
+                }
+                out.push_back(c);
+            }
+            return out;
+        }
+
+        std::string formatTime(double ns) {
+            char buffer[32];
+            if (ns >= 1e6) {
+                std::snprintf(buffer, sizeof(buffer), "%.3f ms", ns / 1e6);
+            } else if (ns >= 1e3) {
+                std::snprintf(buffer, sizeof(buffer), "%.3f us", ns / 1e3);
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+            }
+            return buffer;
+        }
+
+        void printTable(const std::vector<Result> &results) {
+            std::printf("%-48s %12s %12s %12s %14s\n", "benchmark", "median", "p90", "p99", "items/s");
+            for (const Result &result : results) {
+                if (!result.skipped.empty()) {
+                    std::printf("%-48s skipped: %s\n", result.name.c_str(), result.skipped.c_str());
+                    continue;
+                }
+                if (!result.failed.empty()) {
+                    std::printf("%-48s FAILED: %s\n", result.name.c_str(), result.failed.c_str());
+                    continue;
+                }
+                if (!result.samples.empty()) {
+                    const Summary summary = summarize(result.samples);
+                    char throughput[32] = "";
+                    if (result.itemsPerRun > 0 && summary.median > 0) {
+                        std::snprintf(throughput, sizeof(throughput), "%.3g", result.itemsPerRun * 1e9 / summary.median);
+                    }
+                    std::printf("%-48s %12s %12s %12s %14s\n", result.name.c_str(), formatTime(summary.median).c_str(),
+                                formatTime(summary.p90).c_str(), formatTime(summary.p99).c_str(), throughput);
+                }
+                for (const auto &[name, value] : result.counters) {
+                    std::printf("%-48s   %s = %.6g\n", "", name.c_str(), value);
+                }
+            }
+        }
+
+        bool writeJson(const std::string &path, const std::vector<Result> &results, const RunOptions &options) {
+            std::ofstream out(path);
+            if (!out) {
+                std::cerr << "Failed to open " << path << std::endl;
+                return false;
+            }
+
+            out.precision(10);
+            out << "{\n  \"schema\": 1,\n  \"timestamp\": " << std::time(nullptr)
+                << ",\n  \"warmup\": " << options.warmup << ",\n  \"repetitions\": " << options.repetitions
+                << ",\n  \"results\": [";
+            for (size_t i = 0; i < results.size(); i++) {
+                const Result &result = results[i];
+                out << (i ? "," : "") << "\n    {\"name\": \"" << escape(result.name) << "\"";
+                if (!result.skipped.empty()) {
+                    out << ", \"skipped\": \"" << escape(result.skipped) << "\"}";
+                    continue;
+                }
+                if (!result.failed.empty()) {
+                    out << ", \"failed\": \"" << escape(result.failed) << "\"}";
+                    continue;
+                }
+                if (!result.samples.empty()) {
+                    const Summary summary = summarize(result.samples);
+                    out << ", \"samples\": " << result.samples.size()
+                        << ", \"min_ns\": " << summary.min << ", \"mean_ns\": " << summary.mean
+                        << ", \"median_ns\": " << summary.median << ", \"p90_ns\": " << summary.p90
+                        << ", \"p99_ns\": " << summary.p99 << ", \"max_ns\": " << summary.max
+                        << ", \"stddev_ns\": " << summary.stddev;
+                    if (result.itemsPerRun > 0) {
+                        out << ", \"items\": " << result.itemsPerRun
+                            << ", \"ns_per_item\": " << summary.median / static_cast<double>(result.itemsPerRun)
+                            << ", \"items_per_second\": " << result.itemsPerRun * 1e9 / summary.median;
+                    }
+                }
+                out << ", \"counters\": {";
+                for (size_t c = 0; c < result.counters.size(); c++) {
+                    out << (c ? ", " : "") << "\"" << escape(result.counters[c].first) << "\": " << result.counters[c].second;
+                }
+                out << "}}";
+            }
+            out << "\n  ]\n}\n";
+            return static_cast<bool>(out);
+        }
+
+        void printUsage(const char *program) {
+            std::cout << "Usage: " << program << " [--filter text] [--warmup n] [--repetitions n] [--json file] [--list]" << std::endl;
+        }
+    }
+
+    bool registerBenchmark(const char *name, BenchmarkFn fn) {
+        registry().push_back({name, fn});
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    using namespace Trin::Bench;
+
+    RunOptions options;
+    std::string jsonPath;
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options.warmup = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue) {
+            options.repetitions = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    auto benchmarks = registry();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](const Registration &a, const Registration &b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+
+    std::vector<Result> results;
+    for (const Registration &benchmark : benchmarks) {
+        if (!options.filter.empty() && std::string(benchmark.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (list) {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+        std::cerr << "running " << benchmark.name << std::endl;
+        State state(benchmark.name, options, results);
+        benchmark.fn(state);
+    }
+    if (list) {
+        return 0;
+    }
+
+    printTable(results);
+    if (!jsonPath.empty() && !writeJson(jsonPath, results, options)) {
+        return -1;
+    }
+    const bool failed = std::any_of(results.begin(), results.end(), [](const Result &result) {
+        return !result.failed.empty();
+    });
+    return failed ? -1 : 0;
+}
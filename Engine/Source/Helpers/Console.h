@@ -60,7 +60,7 @@ private:
     Console() = default;
     ~Console() = default;
 
-    static std::mutex sm_console_mutex;
+    inline static std::mutex sm_console_mutex;
 
     /**
      * @brief Internal behavior for the public static print functions
@@ -12,8 +12,8 @@
 namespace Trin::Helpers {
     class FileObject {
     public:
-        FileObject(std::ifstream &fileif, std::ofstream &fileof):
-        fileif(fileif), fileof(fileof)
+        FileObject(std::ifstream &&fileif, std::ofstream &&fileof):
+        fileif(std::move(fileif)), fileof(std::move(fileof))
         {}
 
         ~FileObject() {
@@ -48,8 +48,9 @@ namespace Trin::Helpers {
         }
 
     private:
-        std::ifstream &fileif;
-        std::ofstream &fileof;
+        // Owned, the streams opened in File::file() go out of scope when it returns
+        mutable std::ifstream fileif;
+        mutable std::ofstream fileof;
     };
 
     enum class FileType {
@@ -75,12 +76,15 @@ namespace Trin::Helpers {
                     fileOf = std::ofstream(path, std::ios::in | std::ios::out);
                     break;
             }
-            if (!fileStream || !fileStream.is_open() || (!fileOf || !fileOf.is_open())) {
+            // Only the streams the requested type opened have to be valid
+            const bool readFailed = type != FileType::Write && (!fileStream || !fileStream.is_open());
+            const bool writeFailed = type != FileType::Read && (!fileOf || !fileOf.is_open());
+            if (readFailed || writeFailed) {
                 std::cerr << "Failed to open file: " << path << std::endl;
                 return nullptr;
             }
 
-            return new FileObject(fileStream, fileOf);
+            return new FileObject(std::move(fileStream), std::move(fileOf));
         }
     };
 }
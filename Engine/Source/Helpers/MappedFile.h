@@ -0,0 +1,143 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Trin::Helpers {
+    /// Read only memory mapping of a whole file, pages are loaded by the OS as they are touched
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        ~MappedFile() {
+            close();
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept {
+            *this = std::move(other);
+        }
+
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                close();
+                std::swap(m_data, other.m_data);
+                std::swap(m_size, other.m_size);
+#ifdef _WIN32
+                std::swap(m_file, other.m_file);
+                std::swap(m_mapping, other.m_mapping);
+#endif
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Maps a file into memory
+         * @param path File to map
+         * @return False when the file could not be opened or is empty
+         */
+        bool open(const char *path) {
+            close();
+#ifdef _WIN32
+            m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+                close();
+                return false;
+            }
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping) {
+                close();
+                return false;
+            }
+            m_data = static_cast<const std::byte *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = static_cast<size_t>(size.QuadPart);
+#else
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0) {
+                return false;
+            }
+            struct stat info{};
+            if (fstat(fd, &info) != 0 || info.st_size == 0) {
+                ::close(fd);
+                return false;
+            }
+            void *mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            // The mapping keeps its own reference to the file
+            ::close(fd);
+            if (mapped == MAP_FAILED) {
+                return false;
+            }
+            m_data = static_cast<const std::byte *>(mapped);
+            m_size = static_cast<size_t>(info.st_size);
+#endif
+            if (!m_data) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close() {
+#ifdef _WIN32
+            if (m_data) {
+                UnmapViewOfFile(m_data);
+            }
+            if (m_mapping) {
+                CloseHandle(m_mapping);
+            }
+            if (m_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(m_file);
+            }
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data) {
+                munmap(const_cast<std::byte *>(m_data), m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        [[nodiscard]] const std::byte *data() const { return m_data; }
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] bool isOpen() const { return m_data != nullptr; }
+
+    private:
+        const std::byte *m_data = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+}
+
+#endif //MAPPEDFILE_H
@@ -0,0 +1,213 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef STRINGID_H
+#define STRINGID_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+
+namespace Trin::Helpers {
+    /// 64 bit FNV-1a, usable at compile time so literal ids cost nothing at runtime
+    constexpr uint64_t fnv1a(std::string_view text) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const char c : text) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+        // Zero is reserved for the empty id
+        return hash == 0 ? 1 : hash;
+    }
+
+/**
+ * Process wide table mapping hashes back to the strings they came from.
+ *
+ * Open addressing over arrays of atomic slots, so interning from any thread never takes a
+ * lock. When the newest array is three quarters full a twice as large one is put in front
+ * of it under a mutex, older arrays stay readable so nothing is ever moved. Each unique
+ * string is copied once and never freed.
+ */
+class StringIdTable {
+public:
+    static constexpr uint32_t kInitialCapacity = 1u << 12;
+
+    static StringIdTable &get() {
+        static StringIdTable table;
+        return table;
+    }
+
+    /// Records the text for a hash, a hash that is already known keeps its first text
+    void insert(uint64_t hash, std::string_view text) {
+        if (find(hash)) {
+            return;
+        }
+        for (;;) {
+            Table *table = m_newest.load(std::memory_order_acquire);
+            for (uint32_t probe = 0; probe < table->capacity; probe++) {
+                Slot &slot = table->slots[(hash + probe) & (table->capacity - 1)];
+                uint64_t current = slot.hash.load(std::memory_order_acquire);
+                if (current == 0 && slot.hash.compare_exchange_strong(current, hash, std::memory_order_acq_rel)) {
+                    // This thread claimed the slot, publish a copy of the string
+                    auto *copy = new char[text.size() + 1];
+                    std::memcpy(copy, text.data(), text.size());
+                    copy[text.size()] = '\0';
+                    slot.text.store(copy, std::memory_order_release);
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+                    if (table->used.fetch_add(1, std::memory_order_relaxed) + 1 >= table->capacity / 4 * 3) {
+                        grow(table);
+                    }
+                    return;
+                }
+                if (current == hash) {
+                    return;
+                }
+            }
+            // Every slot was taken between the check and here, wait for the larger table
+            grow(table);
+        }
+    }
+
+    /// Text for a hash, nullptr when it was never interned or another thread is still publishing it
+    [[nodiscard]] const char *find(uint64_t hash) const {
+        for (const Table *table = m_newest.load(std::memory_order_acquire); table; table = table->older) {
+            // Tables never pass three quarters full, so a miss ends at an empty slot soon
+            for (uint32_t probe = 0; probe < table->capacity; probe++) {
+                const Slot &slot = table->slots[(hash + probe) & (table->capacity - 1)];
+                const uint64_t current = slot.hash.load(std::memory_order_acquire);
+                if (current == hash) {
+                    return slot.text.load(std::memory_order_acquire);
+                }
+                if (current == 0) {
+                    break;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] uint32_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> hash{0};
+        std::atomic<const char *> text{nullptr};
+    };
+
+    struct Table {
+        uint32_t capacity;
+        std::atomic<uint32_t> used{0};
+        const Table *older;
+        Slot *slots;
+
+        Table(uint32_t capacity, const Table *older) : capacity(capacity), older(older), slots(new Slot[capacity]) {}
+    };
+
+    StringIdTable() : m_newest(new Table(kInitialCapacity, nullptr)) {}
+
+    void grow(const Table *full) {
+        std::lock_guard lock(m_growMutex);
+        // Another thread may have grown it while this one waited
+        if (m_newest.load(std::memory_order_relaxed) == full) {
+            m_newest.store(new Table(full->capacity * 2, full), std::memory_order_release);
+        }
+    }
+
+    std::atomic<Table *> m_newest;
+    std::atomic<uint32_t> m_size{0};
+    std::mutex m_growMutex;
+};
+
+    namespace Detail {
+        /// A string literal as a template argument, so every distinct literal gets its own instantiation
+        template<size_t N>
+        struct StringLiteral {
+            char text[N];
+
+            constexpr StringLiteral(const char (&literal)[N]) {
+                for (size_t i = 0; i < N; i++) {
+                    text[i] = literal[i];
+                }
+            }
+
+            [[nodiscard]] constexpr std::string_view view() const { return {text, N - 1}; }
+        };
+
+#ifndef NDEBUG
+        /// Initialized once per literal at startup, so str() knows every _sid without any cost at the use site
+        template<StringLiteral Text>
+        inline const bool kLiteralRecorded = (StringIdTable::get().insert(fnv1a(Text.view()), Text.view()), true);
+#endif
+    }
+
+/**
+ * Hashed name that compares as a single integer.
+ *
+ * Literals can be hashed at compile time with the _sid suffix, debug builds record their
+ * text too. Building an id from a runtime string only hashes it, go through intern() when
+ * the text is needed later so lookups on hot paths never touch the table.
+ */
+class StringId {
+public:
+    constexpr StringId() = default;
+
+    constexpr explicit StringId(std::string_view text) : m_hash(fnv1a(text)) {}
+
+    /// Hashes and records the text so str() can always find it
+    static StringId intern(std::string_view text) {
+        StringId id(text);
+        StringIdTable::get().insert(id.m_hash, text);
+        return id;
+    }
+
+    static constexpr StringId fromHash(uint64_t hash) {
+        StringId id;
+        id.m_hash = hash;
+        return id;
+    }
+
+    [[nodiscard]] constexpr uint64_t hash() const { return m_hash; }
+    [[nodiscard]] constexpr bool valid() const { return m_hash != 0; }
+
+    /// Reverse lookup, "<unknown>" when the string was never recorded
+    [[nodiscard]] const char *str() const {
+        const char *text = StringIdTable::get().find(m_hash);
+        return text ? text : "<unknown>";
+    }
+
+    constexpr bool operator==(const StringId &other) const { return m_hash == other.m_hash; }
+    constexpr bool operator!=(const StringId &other) const { return m_hash != other.m_hash; }
+    constexpr bool operator<(const StringId &other) const { return m_hash < other.m_hash; }
+
+private:
+    uint64_t m_hash = 0;
+};
+
+    inline namespace Literals {
+        /// "name"_sid hashes at compile time
+        template<Detail::StringLiteral Text>
+        constexpr StringId operator""_sid() {
+            constexpr uint64_t kHash = fnv1a(Text.view());
+#ifndef NDEBUG
+            if (!std::is_constant_evaluated()) {
+                (void)Detail::kLiteralRecorded<Text>;
+            }
+#endif
+            return StringId::fromHash(kHash);
+        }
+    }
+}
+
+template<>
+struct std::hash<Trin::Helpers::StringId> {
+    size_t operator()(const Trin::Helpers::StringId &id) const noexcept {
+        return static_cast<size_t>(id.hash());
+    }
+};
+
+#endif //STRINGID_H
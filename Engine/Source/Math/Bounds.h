@@ -0,0 +1,137 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Matrix4.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+namespace Trin::Math {
+    /// Axis aligned bounding box, an empty box has min above max
+    struct AABB {
+        Vector3 min{FLT_MAX, FLT_MAX, FLT_MAX};
+        Vector3 max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        AABB() = default;
+        AABB(const Vector3 &min, const Vector3 &max) : min(min), max(max) {}
+
+        [[nodiscard]] bool empty() const {
+            return min.x > max.x || min.y > max.y || min.z > max.z;
+        }
+
+        [[nodiscard]] Vector3 center() const {
+            return {(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f};
+        }
+
+        [[nodiscard]] Vector3 extent() const {
+            return {(max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f};
+        }
+
+        [[nodiscard]] float surfaceArea() const {
+            if (empty()) {
+                return 0.0f;
+            }
+            const float dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+            return 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+
+        void expand(const Vector3 &p) {
+            min.set(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+            max.set(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+        }
+
+        void expand(const AABB &other) {
+            expand(other.min);
+            expand(other.max);
+        }
+
+        [[nodiscard]] bool overlaps(const AABB &other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        static AABB merge(const AABB &a, const AABB &b) {
+            AABB out = a;
+            out.expand(b);
+            return out;
+        }
+    };
+
+    /// Plane stored as normal and distance, points with dot(normal, p) + d >= 0 are in front
+    struct Plane {
+        Vector3 normal;
+        float d = 0.0f;
+
+        [[nodiscard]] float distance(const Vector3 &p) const {
+            return normal.dot(p) + d;
+        }
+    };
+
+    struct Sphere {
+        Vector3 center;
+        float radius = 0.0f;
+    };
+
+    struct Ray {
+        Vector3 origin;
+        Vector3 direction;
+    };
+
+    /// Six inward facing planes: left, right, bottom, top, near, far
+    struct Frustum {
+        Plane planes[6];
+
+        /**
+         * @brief Pulls the planes out of a combined projection * view matrix
+         * @param viewProjection Clip space transform using Vulkan's [0, 1] depth range
+         */
+        static Frustum fromMatrix(const Matrix4 &viewProjection) {
+            const auto row = [&](int r) {
+                return Vector4(viewProjection.at(0, r), viewProjection.at(1, r),
+                               viewProjection.at(2, r), viewProjection.at(3, r));
+            };
+            const Vector4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+            const Vector4 raw[6] = {
+                {r3.x + r0.x, r3.y + r0.y, r3.z + r0.z, r3.w + r0.w},
+                {r3.x - r0.x, r3.y - r0.y, r3.z - r0.z, r3.w - r0.w},
+                {r3.x + r1.x, r3.y + r1.y, r3.z + r1.z, r3.w + r1.w},
+                {r3.x - r1.x, r3.y - r1.y, r3.z - r1.z, r3.w - r1.w},
+                r2,
+                {r3.x - r2.x, r3.y - r2.y, r3.z - r2.z, r3.w - r2.w},
+            };
+
+            Frustum out;
+            for (int i = 0; i < 6; i++) {
+                const float length = std::sqrt(raw[i].x * raw[i].x + raw[i].y * raw[i].y + raw[i].z * raw[i].z);
+                const float inv = length > 0.0f ? 1.0f / length : 0.0f;
+                out.planes[i].normal = Vector3(raw[i].x * inv, raw[i].y * inv, raw[i].z * inv);
+                out.planes[i].d = raw[i].w * inv;
+            }
+            return out;
+        }
+
+        /// Scalar reference test, true when any part of the box may be visible
+        [[nodiscard]] bool intersects(const AABB &box) const {
+            const Vector3 c = box.center();
+            const Vector3 e = box.extent();
+            for (const Plane &plane : planes) {
+                const float r = std::fabs(plane.normal.x) * e.x + std::fabs(plane.normal.y) * e.y +
+                                std::fabs(plane.normal.z) * e.z;
+                if (plane.distance(c) + r < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
+
+#endif //BOUNDS_H
@@ -0,0 +1,214 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef MATRIX4_H
+#define MATRIX4_H
+
+#include <cmath>
+#include <cstddef>
+
+#include "Simd.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+namespace Trin::Math {
+    /// Column-major 4x4 matrix, laid out the way Vulkan shaders expect it
+    class alignas(16) Matrix4 {
+    public:
+        Matrix4() {
+            *this = identity();
+        }
+
+        explicit Matrix4(const float *values) {
+            for (int i = 0; i < 16; i++) {
+                m[i] = values[i];
+            }
+        }
+
+        float m[16];
+
+        [[nodiscard]] float &at(int column, int row) { return m[column * 4 + row]; }
+        [[nodiscard]] float at(int column, int row) const { return m[column * 4 + row]; }
+
+        [[nodiscard]] Simd::Float4 column(int index) const { return Simd::Float4::load(&m[index * 4]); }
+
+        /**
+         * @brief Multiplies two matrices using the packed SIMD path
+         * @param a Left hand side, applied last
+         * @param b Right hand side, applied first
+         * @param out Result, may alias neither a nor b
+         */
+        static void multiply(const Matrix4 &a, const Matrix4 &b, Matrix4 &out) {
+            const Simd::Float4 c0 = a.column(0);
+            const Simd::Float4 c1 = a.column(1);
+            const Simd::Float4 c2 = a.column(2);
+            const Simd::Float4 c3 = a.column(3);
+
+            for (int j = 0; j < 4; j++) {
+                const Simd::Float4 bj = b.column(j);
+                Simd::Float4 r = c0 * bj.splat<0>();
+                r = Simd::madd(c1, bj.splat<1>(), r);
+                r = Simd::madd(c2, bj.splat<2>(), r);
+                r = Simd::madd(c3, bj.splat<3>(), r);
+                r.store(&out.m[j * 4]);
+            }
+        }
+
+        Matrix4 operator*(const Matrix4 &other) const {
+            Matrix4 out(nullptr);
+            multiply(*this, other, out);
+            return out;
+        }
+
+        [[nodiscard]] Vector4 transform(const Vector4 &v) const {
+            Simd::Float4 r = column(0) * Simd::Float4(v.x);
+            r = Simd::madd(column(1), Simd::Float4(v.y), r);
+            r = Simd::madd(column(2), Simd::Float4(v.z), r);
+            r = Simd::madd(column(3), Simd::Float4(v.w), r);
+            return {r.lane(0), r.lane(1), r.lane(2), r.lane(3)};
+        }
+
+        [[nodiscard]] Vector3 transformPoint(const Vector3 &p) const {
+            const Vector4 r = transform({p.x, p.y, p.z, 1.0f});
+            return {r.x, r.y, r.z};
+        }
+
+        [[nodiscard]] Vector3 getTranslation() const {
+            return {m[12], m[13], m[14]};
+        }
+
+        /// Inverse of a matrix whose last row is (0, 0, 0, 1), identity when the 3x3 part is singular
+        [[nodiscard]] Matrix4 inverseAffine() const {
+            const float c00 = m[5] * m[10] - m[6] * m[9];
+            const float c01 = m[6] * m[8] - m[4] * m[10];
+            const float c02 = m[4] * m[9] - m[5] * m[8];
+            const float determinant = m[0] * c00 + m[1] * c01 + m[2] * c02;
+            if (determinant == 0.0f) {
+                return identity();
+            }
+            const float inverse = 1.0f / determinant;
+
+            Matrix4 out(nullptr);
+            out.m[0] = c00 * inverse;
+            out.m[1] = (m[2] * m[9] - m[1] * m[10]) * inverse;
+            out.m[2] = (m[1] * m[6] - m[2] * m[5]) * inverse;
+            out.m[3] = 0.0f;
+            out.m[4] = c01 * inverse;
+            out.m[5] = (m[0] * m[10] - m[2] * m[8]) * inverse;
+            out.m[6] = (m[2] * m[4] - m[0] * m[6]) * inverse;
+            out.m[7] = 0.0f;
+            out.m[8] = c02 * inverse;
+            out.m[9] = (m[1] * m[8] - m[0] * m[9]) * inverse;
+            out.m[10] = (m[0] * m[5] - m[1] * m[4]) * inverse;
+            out.m[11] = 0.0f;
+            out.m[12] = -(out.m[0] * m[12] + out.m[4] * m[13] + out.m[8] * m[14]);
+            out.m[13] = -(out.m[1] * m[12] + out.m[5] * m[13] + out.m[9] * m[14]);
+            out.m[14] = -(out.m[2] * m[12] + out.m[6] * m[13] + out.m[10] * m[14]);
+            out.m[15] = 1.0f;
+            return out;
+        }
+
+        static Matrix4 identity() {
+            Matrix4 out(nullptr);
+            for (int i = 0; i < 16; i++) {
+                out.m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+            }
+            return out;
+        }
+
+        static Matrix4 translation(const Vector3 &t) {
+            Matrix4 out = identity();
+            out.m[12] = t.x;
+            out.m[13] = t.y;
+            out.m[14] = t.z;
+            return out;
+        }
+
+        static Matrix4 scale(const Vector3 &s) {
+            Matrix4 out = identity();
+            out.m[0] = s.x;
+            out.m[5] = s.y;
+            out.m[10] = s.z;
+            return out;
+        }
+
+        /**
+         * @brief Builds translation * rotation * scale in one pass
+         * @param t Translation
+         * @param euler Rotation in radians, applied in Z, Y, X order
+         * @param s Per axis scale
+         */
+        static Matrix4 trs(const Vector3 &t, const Vector3 &euler, const Vector3 &s) {
+            const float cx = std::cos(euler.x), sx = std::sin(euler.x);
+            const float cy = std::cos(euler.y), sy = std::sin(euler.y);
+            const float cz = std::cos(euler.z), sz = std::sin(euler.z);
+
+            Matrix4 out(nullptr);
+            out.m[0] = cy * cz * s.x;
+            out.m[1] = (sx * sy * cz + cx * sz) * s.x;
+            out.m[2] = (-cx * sy * cz + sx * sz) * s.x;
+            out.m[3] = 0.0f;
+
+            out.m[4] = -cy * sz * s.y;
+            out.m[5] = (-sx * sy * sz + cx * cz) * s.y;
+            out.m[6] = (cx * sy * sz + sx * cz) * s.y;
+            out.m[7] = 0.0f;
+
+            out.m[8] = sy * s.z;
+            out.m[9] = -sx * cy * s.z;
+            out.m[10] = cx * cy * s.z;
+            out.m[11] = 0.0f;
+
+            out.m[12] = t.x;
+            out.m[13] = t.y;
+            out.m[14] = t.z;
+            out.m[15] = 1.0f;
+            return out;
+        }
+
+        /// Right handed perspective with a [0, 1] depth range and Y pointing down, matching Vulkan clip space
+        static Matrix4 perspective(float fovY, float aspect, float nearPlane, float farPlane) {
+            const float f = 1.0f / std::tan(fovY * 0.5f);
+            Matrix4 out(nullptr);
+            for (float &value : out.m) {
+                value = 0.0f;
+            }
+            out.m[0] = f / aspect;
+            out.m[5] = -f;
+            out.m[10] = farPlane / (nearPlane - farPlane);
+            out.m[11] = -1.0f;
+            out.m[14] = (nearPlane * farPlane) / (nearPlane - farPlane);
+            return out;
+        }
+
+        static Matrix4 lookAt(const Vector3 &eye, const Vector3 &target, const Vector3 &up) {
+            Vector3 f(target.x - eye.x, target.y - eye.y, target.z - eye.z);
+            f.normalize();
+            Vector3 s(f.y * up.z - f.z * up.y, f.z * up.x - f.x * up.z, f.x * up.y - f.y * up.x);
+            s.normalize();
+            const Vector3 u(s.y * f.z - s.z * f.y, s.z * f.x - s.x * f.z, s.x * f.y - s.y * f.x);
+
+            Matrix4 out = identity();
+            out.m[0] = s.x;
+            out.m[4] = s.y;
+            out.m[8] = s.z;
+            out.m[1] = u.x;
+            out.m[5] = u.y;
+            out.m[9] = u.z;
+            out.m[2] = -f.x;
+            out.m[6] = -f.y;
+            out.m[10] = -f.z;
+            out.m[12] = -s.dot(eye);
+            out.m[13] = -u.dot(eye);
+            out.m[14] = f.dot(eye);
+            return out;
+        }
+
+    private:
+        // Leaves the contents uninitialized for the hot paths that overwrite every element anyway
+        explicit Matrix4(std::nullptr_t) {}
+    };
+}
+
+#endif //MATRIX4_H
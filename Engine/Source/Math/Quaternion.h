@@ -0,0 +1,170 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include <cmath>
+
+#include "Matrix4.h"
+#include "Simd.h"
+#include "Vector3.h"
+
+namespace Trin::Math {
+    /// Unit quaternion rotation, w is the real part
+    class Quaternion {
+    public:
+        Quaternion() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+        Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        float x;
+        float y;
+        float z;
+        float w;
+
+        static Quaternion identity() { return {}; }
+
+        /// Rotation of radians around axis, which must be normalized
+        static Quaternion fromAxisAngle(const Vector3 &axis, float radians) {
+            const float s = std::sin(radians * 0.5f);
+            return {axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f)};
+        }
+
+        [[nodiscard]] float dot(const Quaternion &other) const {
+            return x * other.x + y * other.y + z * other.z + w * other.w;
+        }
+
+        [[nodiscard]] Quaternion normalized() const {
+            const float length = std::sqrt(dot(*this));
+            if (length <= 0.0f) {
+                return identity();
+            }
+            const float inverse = 1.0f / length;
+            return {x * inverse, y * inverse, z * inverse, w * inverse};
+        }
+
+        [[nodiscard]] Quaternion conjugate() const { return {-x, -y, -z, w}; }
+
+        /// Rotation by other first, then by this one
+        Quaternion operator*(const Quaternion &other) const {
+            return {w * other.x + x * other.w + y * other.z - z * other.y,
+                    w * other.y - x * other.z + y * other.w + z * other.x,
+                    w * other.z + x * other.y - y * other.x + z * other.w,
+                    w * other.w - x * other.x - y * other.y - z * other.z};
+        }
+
+        [[nodiscard]] Vector3 rotate(const Vector3 &v) const {
+            // v + 2w(q x v) + 2q x (q x v), without building the matrix
+            const Vector3 q(x, y, z);
+            const Vector3 t = q.cross(v);
+            const Vector3 t2(t.x * 2.0f, t.y * 2.0f, t.z * 2.0f);
+            const Vector3 u = q.cross(t2);
+            return {v.x + w * t2.x + u.x, v.y + w * t2.y + u.y, v.z + w * t2.z + u.z};
+        }
+
+        /// Normalized linear blend along the shorter arc, cheap and close to slerp for nearby keys
+        static Quaternion nlerp(const Quaternion &a, const Quaternion &b, float t) {
+            const float sign = a.dot(b) < 0.0f ? -1.0f : 1.0f;
+            const float s = 1.0f - t;
+            const float u = t * sign;
+            return Quaternion(a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u).normalized();
+        }
+
+        /// Constant speed blend along the shorter arc
+        static Quaternion slerp(const Quaternion &a, const Quaternion &b, float t) {
+            float cosine = a.dot(b);
+            const float sign = cosine < 0.0f ? -1.0f : 1.0f;
+            cosine *= sign;
+            if (cosine > 0.9995f) {
+                return nlerp(a, b, t);
+            }
+            const float angle = std::acos(cosine);
+            const float inverseSine = 1.0f / std::sin(angle);
+            const float s = std::sin((1.0f - t) * angle) * inverseSine;
+            const float u = std::sin(t * angle) * inverseSine * sign;
+            return {a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u};
+        }
+
+        /// Builds translation * rotation * scale
+        [[nodiscard]] Matrix4 toMatrix(const Vector3 &translation = Vector3::zero(),
+                                       const Vector3 &scale = Vector3::one()) const {
+            const float xx = x * x, yy = y * y, zz = z * z;
+            const float xy = x * y, xz = x * z, yz = y * z;
+            const float wx = w * x, wy = w * y, wz = w * z;
+
+            Matrix4 out;
+            out.m[0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+            out.m[1] = 2.0f * (xy + wz) * scale.x;
+            out.m[2] = 2.0f * (xz - wy) * scale.x;
+
+            out.m[4] = 2.0f * (xy - wz) * scale.y;
+            out.m[5] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+            out.m[6] = 2.0f * (yz + wx) * scale.y;
+
+            out.m[8] = 2.0f * (xz + wy) * scale.z;
+            out.m[9] = 2.0f * (yz - wx) * scale.z;
+            out.m[10] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+
+            out.m[12] = translation.x;
+            out.m[13] = translation.y;
+            out.m[14] = translation.z;
+            return out;
+        }
+    };
+
+    namespace Simd {
+        /// Four quaternions in structure of arrays form, one per lane
+        struct Quaternion4 {
+            Float4 x;
+            Float4 y;
+            Float4 z;
+            Float4 w;
+        };
+
+        inline Float4 dot(const Quaternion4 &a, const Quaternion4 &b) {
+            return madd(a.x, b.x, madd(a.y, b.y, madd(a.z, b.z, a.w * b.w)));
+        }
+
+        inline Quaternion4 normalize(const Quaternion4 &q) {
+            const Float4 inverse = Float4(1.0f) / Float4::sqrt(dot(q, q));
+            return {q.x * inverse, q.y * inverse, q.z * inverse, q.w * inverse};
+        }
+
+        /// Lane wise Quaternion::nlerp
+        inline Quaternion4 nlerp(const Quaternion4 &a, const Quaternion4 &b, Float4 t) {
+            const Float4 s = Float4(1.0f) - t;
+            const Float4 u = Float4::select(t, Float4(0.0f) - t, dot(a, b) < Float4(0.0f));
+            return normalize({madd(a.x, s, b.x * u), madd(a.y, s, b.y * u),
+                              madd(a.z, s, b.z * u), madd(a.w, s, b.w * u)});
+        }
+
+        /**
+         * @brief Lane wise slerp, within about 1e-3 radians of Quaternion::slerp
+         *
+         * Runs nlerp with t bent by a cubic whose strength is fitted to the angle between the
+         * keys, which undoes most of nlerp's speed up in the middle of the arc without any
+         * trigonometry.
+         */
+        inline Quaternion4 slerp(const Quaternion4 &a, const Quaternion4 &b, Float4 t) {
+            const Float4 d = Float4::abs(dot(a, b));
+            const Float4 k0 = madd(d, madd(d, madd(d, Float4(-1.43519f), Float4(3.55645f)), Float4(-3.2452f)),
+                                   Float4(1.0904f));
+            const Float4 k1 = madd(d, madd(d, Float4(0.215638f), Float4(-1.06021f)), Float4(0.848013f));
+            const Float4 centered = t - Float4(0.5f);
+            const Float4 k = madd(k0 * centered, centered, k1);
+            const Float4 bent = madd(t * centered * (t - Float4(1.0f)), k, t);
+            return nlerp(a, b, bent);
+        }
+
+        /// Lane wise Quaternion::operator*
+        inline Quaternion4 multiply(const Quaternion4 &a, const Quaternion4 &b) {
+            return {madd(a.w, b.x, madd(a.x, b.w, a.y * b.z - a.z * b.y)),
+                    madd(a.w, b.y, madd(a.z, b.x, a.y * b.w - a.x * b.z)),
+                    madd(a.w, b.z, madd(a.x, b.y, a.z * b.w - a.y * b.x)),
+                    a.w * b.w - madd(a.x, b.x, madd(a.y, b.y, a.z * b.z))};
+        }
+    }
+}
+
+#endif //QUATERNION_H
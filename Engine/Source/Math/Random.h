@@ -0,0 +1,68 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+namespace Trin::Math {
+    /**
+     * Small seeded generator (xoroshiro128++), the same seed gives the same sequence on every
+     * platform and compiler, unlike the distributions in <random>.
+     */
+    class Random {
+    public:
+        explicit Random(uint64_t seed = 0) {
+            reseed(seed);
+        }
+
+        void reseed(uint64_t seed) {
+            // Two rounds of mixing so neighbouring seeds, such as frame numbers, still start far apart
+            m_state[0] = mix(seed);
+            m_state[1] = mix(m_state[0]);
+        }
+
+        uint64_t next() {
+            const uint64_t s0 = m_state[0];
+            uint64_t s1 = m_state[1];
+            const uint64_t result = rotl(s0 + s1, 17) + s0;
+            s1 ^= s0;
+            m_state[0] = rotl(s0, 49) ^ s1 ^ (s1 << 21);
+            m_state[1] = rotl(s1, 28);
+            return result;
+        }
+
+        /// Uniform in [0, bound)
+        uint32_t range(uint32_t bound) {
+            return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+        }
+
+        /// Uniform in [0, 1)
+        float nextFloat() {
+            return static_cast<float>(next() >> 40) * 0x1.0p-24f;
+        }
+
+        float range(float min, float max) {
+            return min + (max - min) * nextFloat();
+        }
+
+        /// SplitMix64 finalizer, turns any 64 bit value into a well spread seed
+        static constexpr uint64_t mix(uint64_t value) {
+            value += 0x9E3779B97F4A7C15ull;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+    private:
+        static constexpr uint64_t rotl(uint64_t value, int shift) {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        uint64_t m_state[2]{};
+    };
+}
+
+#endif //RANDOM_H
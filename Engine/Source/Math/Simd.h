@@ -0,0 +1,158 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRIN_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace Trin::Math::Simd {
+    /// Four packed floats, backed by SSE when it is available
+    /// and a plain array otherwise so the same code runs everywhere
+    struct alignas(16) Float4 {
+#ifdef TRIN_SIMD_SSE
+        __m128 v;
+
+        Float4() : v(_mm_setzero_ps()) {}
+        Float4(__m128 value) : v(value) {}
+        explicit Float4(float scalar) : v(_mm_set1_ps(scalar)) {}
+        Float4(float x, float y, float z, float w) : v(_mm_setr_ps(x, y, z, w)) {}
+
+        static Float4 load(const float *p) { return _mm_load_ps(p); }
+        static Float4 loadu(const float *p) { return _mm_loadu_ps(p); }
+        void store(float *p) const { _mm_store_ps(p, v); }
+        void storeu(float *p) const { _mm_storeu_ps(p, v); }
+
+        [[nodiscard]] float lane(int i) const {
+            alignas(16) float out[4];
+            _mm_store_ps(out, v);
+            return out[i];
+        }
+
+        friend Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+        friend Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+        friend Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+        friend Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.v, b.v); }
+        friend Float4 operator&(Float4 a, Float4 b) { return _mm_and_ps(a.v, b.v); }
+        friend Float4 operator|(Float4 a, Float4 b) { return _mm_or_ps(a.v, b.v); }
+        friend Float4 operator<(Float4 a, Float4 b) { return _mm_cmplt_ps(a.v, b.v); }
+        friend Float4 operator<=(Float4 a, Float4 b) { return _mm_cmple_ps(a.v, b.v); }
+        friend Float4 operator>(Float4 a, Float4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+        friend Float4 operator>=(Float4 a, Float4 b) { return _mm_cmpge_ps(a.v, b.v); }
+
+        static Float4 min(Float4 a, Float4 b) { return _mm_min_ps(a.v, b.v); }
+        static Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+        static Float4 abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+        static Float4 sqrt(Float4 a) { return _mm_sqrt_ps(a.v); }
+
+        /// Picks b where the mask lane is set, a otherwise
+        static Float4 select(Float4 a, Float4 b, Float4 mask) {
+            return _mm_or_ps(_mm_andnot_ps(mask.v, a.v), _mm_and_ps(mask.v, b.v));
+        }
+
+        /// Bit i is set when lane i of a comparison result is true
+        [[nodiscard]] int mask() const { return _mm_movemask_ps(v); }
+
+        /// Broadcasts lane I to every lane
+        template<int I>
+        [[nodiscard]] Float4 splat() const { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I)); }
+#else
+        float v[4];
+
+        Float4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+        explicit Float4(float scalar) : v{scalar, scalar, scalar, scalar} {}
+        Float4(float x, float y, float z, float w) : v{x, y, z, w} {}
+
+        static Float4 load(const float *p) { return {p[0], p[1], p[2], p[3]}; }
+        static Float4 loadu(const float *p) { return load(p); }
+        void store(float *p) const { for (int i = 0; i < 4; i++) p[i] = v[i]; }
+        void storeu(float *p) const { store(p); }
+
+        [[nodiscard]] float lane(int i) const { return v[i]; }
+
+        template<typename Op>
+        static Float4 map(Float4 a, Float4 b, Op op) {
+            return {op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])};
+        }
+
+        static float bits(bool value) {
+            const uint32_t raw = value ? 0xFFFFFFFFu : 0u;
+            float out;
+            std::memcpy(&out, &raw, sizeof(out));
+            return out;
+        }
+
+        static uint32_t raw(float value) {
+            uint32_t out;
+            std::memcpy(&out, &value, sizeof(out));
+            return out;
+        }
+
+        friend Float4 operator+(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x + y; }); }
+        friend Float4 operator-(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x - y; }); }
+        friend Float4 operator*(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x * y; }); }
+        friend Float4 operator/(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x / y; }); }
+        friend Float4 operator&(Float4 a, Float4 b) {
+            return map(a, b, [](float x, float y) { return bits(raw(x) & raw(y)); });
+        }
+        friend Float4 operator|(Float4 a, Float4 b) {
+            return map(a, b, [](float x, float y) { return bits(raw(x) | raw(y)); });
+        }
+        friend Float4 operator<(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return bits(x < y); }); }
+        friend Float4 operator<=(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return bits(x <= y); }); }
+        friend Float4 operator>(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return bits(x > y); }); }
+        friend Float4 operator>=(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return bits(x >= y); }); }
+
+        static Float4 min(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+        static Float4 max(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x < y ? y : x; }); }
+        static Float4 abs(Float4 a) { return {std::fabs(a.v[0]), std::fabs(a.v[1]), std::fabs(a.v[2]), std::fabs(a.v[3])}; }
+        static Float4 sqrt(Float4 a) { return {std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3])}; }
+
+        static Float4 select(Float4 a, Float4 b, Float4 mask) {
+            Float4 out;
+            for (int i = 0; i < 4; i++) out.v[i] = raw(mask.v[i]) ? b.v[i] : a.v[i];
+            return out;
+        }
+
+        [[nodiscard]] int mask() const {
+            int out = 0;
+            for (int i = 0; i < 4; i++) out |= static_cast<int>(raw(v[i]) >> 31) << i;
+            return out;
+        }
+
+        template<int I>
+        [[nodiscard]] Float4 splat() const { return Float4(v[I]); }
+#endif
+    };
+
+    /// Fused multiply-add helper, a * b + c
+    inline Float4 madd(Float4 a, Float4 b, Float4 c) {
+        return a * b + c;
+    }
+
+    /// Transposes the 4x4 block whose rows are a, b, c and d, in place
+    inline void transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+#ifdef TRIN_SIMD_SSE
+        _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+#else
+        Float4 *rows[4] = {&a, &b, &c, &d};
+        for (int i = 0; i < 4; i++) {
+            for (int j = i + 1; j < 4; j++) {
+                const float value = rows[i]->v[j];
+                rows[i]->v[j] = rows[j]->v[i];
+                rows[j]->v[i] = value;
+            }
+        }
+#endif
+    }
+}
+
+#endif //SIMD_H
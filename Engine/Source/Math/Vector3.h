@@ -83,6 +83,12 @@ namespace Trin::Math {
           return this->x * other.x + this->y * other.y + this->z * other.z;
         }
 
+        [[nodiscard]] Vector3 cross(const Vector3 &other) const {
+            return {this->y * other.z - this->z * other.y,
+                    this->z * other.x - this->x * other.z,
+                    this->x * other.y - this->y * other.x};
+        }
+
         [[nodiscard]] float magnitude() const {
           return sqrt(this->x * this->x + this->y * this->y + this->z * this->z);
         }
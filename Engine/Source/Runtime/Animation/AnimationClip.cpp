@@ -0,0 +1,291 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "AnimationClip.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Helpers/Console.h"
+#include "Math/Simd.h"
+#include "Memory/MemoryTracker.h"
+
+namespace Trin::Runtime::Animation {
+    using Simd::Float4;
+    using Simd::Quaternion4;
+
+    namespace {
+        float component(const Quaternion &q, uint32_t index) {
+            return index == 0 ? q.x : index == 1 ? q.y : index == 2 ? q.z : q.w;
+        }
+
+        float component(const Vector3 &v, uint32_t index) {
+            return index == 0 ? v.x : index == 1 ? v.y : v.z;
+        }
+
+        /// Four consecutive keys as floats, still quantized
+        template<typename T>
+        Float4 widen(const T *keys) {
+            return {static_cast<float>(keys[0]), static_cast<float>(keys[1]),
+                    static_cast<float>(keys[2]), static_cast<float>(keys[3])};
+        }
+
+        /// Repeats the last track until the count is a multiple of four, the extra lanes write the same value twice
+        void padTracks(std::vector<BoneIndex> &bones) {
+            while (!bones.empty() && bones.size() % 4 != 0) {
+                bones.push_back(bones.back());
+            }
+        }
+
+        template<typename T>
+        size_t bytesOf(const std::vector<T> &values) {
+            return values.size() * sizeof(T);
+        }
+    }
+
+    AnimationClip::~AnimationClip() {
+        release();
+    }
+
+    bool AnimationClip::build(const AnimationClipCreateInfo &info) {
+        release();
+        if (!info.frames || info.frameCount == 0 || info.boneCount == 0 || info.sampleRate <= 0.0f) {
+            Helpers::Console::error("Animation clip needs at least one frame of one bone and a positive sample rate");
+            return false;
+        }
+        if (info.boneCount >= kNoParentBone) {
+            Helpers::Console::error("Animation clip has more bones than a skeleton can hold");
+            return false;
+        }
+
+        m_boneCount = info.boneCount;
+        m_frameCount = info.frameCount;
+        m_sampleRate = info.sampleRate;
+        m_duration = static_cast<float>(info.frameCount - 1) / info.sampleRate;
+
+        m_restPose.assign((info.boneCount + 3) / 4, {});
+        for (uint32_t bone = 0; bone < m_restPose.size() * 4; bone++) {
+            BoneTransform transform;
+            if (bone < info.boneCount) {
+                transform = info.frames[bone];
+                transform.rotation = transform.rotation.normalized();
+            }
+            writeBone(m_restPose, bone, transform);
+        }
+        m_stats.rotationTracks = compressRotations(info, m_rotations);
+        m_stats.translationTracks = compressVectors(info, false, m_translations);
+        m_stats.scaleTracks = compressVectors(info, true, m_scales);
+        m_stats.compressedBytes = bytesOf(m_restPose) + bytesOf(m_rotations.bones) + bytesOf(m_rotations.keys);
+        for (const VectorTracks *tracks : {&m_translations, &m_scales}) {
+            m_stats.compressedBytes += bytesOf(tracks->bones) + bytesOf(tracks->origin) + bytesOf(tracks->step) +
+                                       bytesOf(tracks->keys);
+        }
+        m_stats.uncompressedBytes = static_cast<size_t>(m_frameCount) * m_boneCount * 10 * sizeof(float);
+        Memory::MemoryTracker::onAllocate(Memory::MemoryTag::Animation, m_stats.compressedBytes);
+        return true;
+    }
+
+    uint32_t AnimationClip::compressRotations(const AnimationClipCreateInfo &info, RotationTracks &tracks) {
+        const uint32_t bones = info.boneCount;
+        const uint32_t frames = info.frameCount;
+
+        // q and -q are the same rotation, keep neighbouring keys on one side so blends take the short way
+        std::vector<Quaternion> keys(static_cast<size_t>(frames) * bones);
+        for (uint32_t bone = 0; bone < bones; bone++) {
+            Quaternion previous = info.frames[bone].rotation.normalized();
+            for (uint32_t frame = 0; frame < frames; frame++) {
+                Quaternion key = info.frames[static_cast<size_t>(frame) * bones + bone].rotation.normalized();
+                if (key.dot(previous) < 0.0f) {
+                    key = {-key.x, -key.y, -key.z, -key.w};
+                }
+                keys[static_cast<size_t>(frame) * bones + bone] = key;
+                previous = key;
+            }
+        }
+
+        for (uint32_t bone = 0; bone < bones; bone++) {
+            const Quaternion &first = keys[bone];
+            for (uint32_t frame = 1; frame < frames; frame++) {
+                const Quaternion &key = keys[static_cast<size_t>(frame) * bones + bone];
+                if (std::fabs(key.x - first.x) > info.rotationTolerance ||
+                    std::fabs(key.y - first.y) > info.rotationTolerance ||
+                    std::fabs(key.z - first.z) > info.rotationTolerance ||
+                    std::fabs(key.w - first.w) > info.rotationTolerance) {
+                    tracks.bones.push_back(static_cast<BoneIndex>(bone));
+                    break;
+                }
+            }
+        }
+        const auto animatedTracks = static_cast<uint32_t>(tracks.bones.size());
+        padTracks(tracks.bones);
+
+        const size_t groups = tracks.bones.size() / 4;
+        tracks.keys.resize(frames * groups * 16);
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            for (size_t track = 0; track < tracks.bones.size(); track++) {
+                const Quaternion &key = keys[static_cast<size_t>(frame) * bones + tracks.bones[track]];
+                int16_t *out = &tracks.keys[(frame * groups + track / 4) * 16 + track % 4];
+                for (uint32_t c = 0; c < 4; c++) {
+                    out[c * 4] = static_cast<int16_t>(std::lround(std::clamp(component(key, c), -1.0f, 1.0f) * 32767.0f));
+                }
+            }
+        }
+        return animatedTracks;
+    }
+
+    uint32_t AnimationClip::compressVectors(const AnimationClipCreateInfo &info, bool scale, VectorTracks &tracks) {
+        const uint32_t bones = info.boneCount;
+        const uint32_t frames = info.frameCount;
+        const float tolerance = scale ? info.scaleTolerance : info.translationTolerance;
+        const auto value = [&](uint32_t frame, uint32_t bone) -> const Vector3 & {
+            const BoneTransform &transform = info.frames[static_cast<size_t>(frame) * bones + bone];
+            return scale ? transform.scale : transform.translation;
+        };
+
+        std::vector<float> low, high;
+        for (uint32_t bone = 0; bone < bones; bone++) {
+            float trackLow[3], trackHigh[3];
+            bool animated = false;
+            for (uint32_t c = 0; c < 3; c++) {
+                trackLow[c] = trackHigh[c] = component(value(0, bone), c);
+            }
+            for (uint32_t frame = 1; frame < frames; frame++) {
+                for (uint32_t c = 0; c < 3; c++) {
+                    const float v = component(value(frame, bone), c);
+                    animated |= std::fabs(v - component(value(0, bone), c)) > tolerance;
+                    trackLow[c] = std::min(trackLow[c], v);
+                    trackHigh[c] = std::max(trackHigh[c], v);
+                }
+            }
+            if (animated) {
+                tracks.bones.push_back(static_cast<BoneIndex>(bone));
+                low.insert(low.end(), trackLow, trackLow + 3);
+                high.insert(high.end(), trackHigh, trackHigh + 3);
+            }
+        }
+        const auto animatedTracks = static_cast<uint32_t>(tracks.bones.size());
+        padTracks(tracks.bones);
+
+        const size_t groups = tracks.bones.size() / 4;
+        tracks.origin.resize(groups * 12);
+        tracks.step.resize(groups * 12);
+        for (size_t track = 0; track < tracks.bones.size(); track++) {
+            const size_t source = std::min<size_t>(track, animatedTracks - 1);
+            for (uint32_t c = 0; c < 3; c++) {
+                const size_t slot = (track / 4) * 12 + c * 4 + track % 4;
+                tracks.origin[slot] = low[source * 3 + c];
+                tracks.step[slot] = (high[source * 3 + c] - low[source * 3 + c]) / 65535.0f;
+            }
+        }
+
+        tracks.keys.resize(frames * groups * 12);
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            for (size_t track = 0; track < tracks.bones.size(); track++) {
+                const Vector3 &key = value(frame, tracks.bones[track]);
+                const size_t slot = (track / 4) * 12 + track % 4;
+                uint16_t *out = &tracks.keys[frame * groups * 12 + slot];
+                for (uint32_t c = 0; c < 3; c++) {
+                    const float step = tracks.step[slot + c * 4];
+                    const float units = step > 0.0f ? (component(key, c) - tracks.origin[slot + c * 4]) / step : 0.0f;
+                    out[c * 4] = static_cast<uint16_t>(std::lround(std::clamp(units, 0.0f, 65535.0f)));
+                }
+            }
+        }
+        return animatedTracks;
+    }
+
+    void AnimationClip::release() {
+        if (m_stats.compressedBytes > 0) {
+            Memory::MemoryTracker::onFree(Memory::MemoryTag::Animation, m_stats.compressedBytes);
+        }
+        m_restPose.clear();
+        m_rotations = {};
+        m_translations = {};
+        m_scales = {};
+        m_stats = {};
+        m_boneCount = 0;
+        m_frameCount = 0;
+    }
+
+    void AnimationClip::sample(float time, LocalPose &pose, bool loop, AnimationInterpolation interpolation) const {
+        pose = m_restPose;
+        if (m_frameCount == 0) {
+            return;
+        }
+
+        const auto last = static_cast<float>(m_frameCount - 1);
+        float position = time * m_sampleRate;
+        if (loop && last > 0.0f) {
+            position = std::fmod(position, last);
+            if (position < 0.0f) {
+                position += last;
+            }
+        }
+        // Also catches NaN, which would otherwise turn into a wild frame index
+        if (!(position > 0.0f)) {
+            position = 0.0f;
+        }
+        position = std::min(position, last);
+        const auto frame0 = static_cast<uint32_t>(position);
+        const uint32_t frame1 = std::min(frame0 + 1, m_frameCount - 1);
+        const float alpha = position - static_cast<float>(frame0);
+
+        const size_t groups = m_rotations.bones.size() / 4;
+        const int16_t *keys0 = m_rotations.keys.data() + frame0 * groups * 16;
+        const int16_t *keys1 = m_rotations.keys.data() + frame1 * groups * 16;
+        const Float4 snorm(1.0f / 32767.0f);
+        const Float4 t(alpha);
+        alignas(16) float lanes[4][4];
+        for (size_t group = 0; group < groups; group++) {
+            const int16_t *a = keys0 + group * 16;
+            const int16_t *b = keys1 + group * 16;
+            const Quaternion4 from{widen(a) * snorm, widen(a + 4) * snorm, widen(a + 8) * snorm, widen(a + 12) * snorm};
+            const Quaternion4 to{widen(b) * snorm, widen(b + 4) * snorm, widen(b + 8) * snorm, widen(b + 12) * snorm};
+            const Quaternion4 blended = interpolation == AnimationInterpolation::Slerp
+                                            ? Simd::slerp(from, to, t)
+                                            : Simd::nlerp(from, to, t);
+            blended.x.store(lanes[0]);
+            blended.y.store(lanes[1]);
+            blended.z.store(lanes[2]);
+            blended.w.store(lanes[3]);
+            for (uint32_t lane = 0; lane < 4; lane++) {
+                const BoneIndex bone = m_rotations.bones[group * 4 + lane];
+                BoneGroup &target = pose[bone >> 2];
+                for (uint32_t c = 0; c < 4; c++) {
+                    target.rotation[c][bone & 3] = lanes[c][lane];
+                }
+            }
+        }
+
+        sampleVectors(m_translations, false, frame0, frame1, alpha, pose);
+        sampleVectors(m_scales, true, frame0, frame1, alpha, pose);
+    }
+
+    void AnimationClip::sampleVectors(const VectorTracks &tracks, bool scale, uint32_t frame0, uint32_t frame1,
+                                      float alpha, LocalPose &pose) const {
+        const size_t groups = tracks.bones.size() / 4;
+        const uint16_t *keys0 = tracks.keys.data() + frame0 * groups * 12;
+        const uint16_t *keys1 = tracks.keys.data() + frame1 * groups * 12;
+        const Float4 t(alpha);
+        alignas(16) float lanes[3][4];
+        for (size_t group = 0; group < groups; group++) {
+            for (uint32_t c = 0; c < 3; c++) {
+                const size_t slot = group * 12 + c * 4;
+                const Float4 origin = Float4::loadu(&tracks.origin[slot]);
+                const Float4 step = Float4::loadu(&tracks.step[slot]);
+                const Float4 from = Simd::madd(widen(keys0 + slot), step, origin);
+                const Float4 to = Simd::madd(widen(keys1 + slot), step, origin);
+                Simd::madd(to - from, t, from).store(lanes[c]);
+            }
+            for (uint32_t lane = 0; lane < 4; lane++) {
+                const BoneIndex bone = tracks.bones[group * 4 + lane];
+                BoneGroup &target = pose[bone >> 2];
+                float (&values)[3][4] = scale ? target.scale : target.translation;
+                for (uint32_t c = 0; c < 3; c++) {
+                    values[c][bone & 3] = lanes[c][lane];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,114 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef ANIMATIONCLIP_H
+#define ANIMATIONCLIP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Skeleton.h"
+
+namespace Trin::Runtime::Animation {
+    enum class AnimationInterpolation : uint8_t {
+        Nlerp,      // Normalized lerp, speeds up slightly mid way between keys
+        Slerp,      // Constant angular speed, through the polynomial fit in Simd::slerp
+    };
+
+    struct AnimationClipCreateInfo {
+        uint32_t boneCount = 0;
+        uint32_t frameCount = 0;
+        float sampleRate = 30.0f;                   // Keys per second, the same for every bone
+        const BoneTransform *frames = nullptr;      // frameCount * boneCount transforms, frame after frame
+        // A channel that never strays further than this from its first key is stored once, at full precision
+        float rotationTolerance = 1e-4f;            // Per quaternion component
+        float translationTolerance = 1e-4f;
+        float scaleTolerance = 1e-4f;
+    };
+
+    struct AnimationClipStats {
+        uint32_t rotationTracks = 0;    // Animated channels, the rest are constant
+        uint32_t translationTracks = 0;
+        uint32_t scaleTracks = 0;
+        size_t compressedBytes = 0;
+        size_t uncompressedBytes = 0;   // Every key of every channel as plain floats
+    };
+
+/**
+ * Keyframed animation of a whole skeleton, compressed for sampling many bones at once.
+ *
+ * Channels that barely move are dropped to a single value in a rest pose. The animated ones
+ * are gathered into tracks of four bones and quantized key by key: rotations to 16 bits per
+ * component, translations and scales to 16 bits inside each track's range. Keys are laid out
+ * frame after frame, so sampling reads two contiguous runs of memory, decodes and blends four
+ * tracks per SIMD operation and scatters the lanes into the pose.
+ */
+class AnimationClip {
+public:
+    AnimationClip() = default;
+    ~AnimationClip();
+
+    AnimationClip(const AnimationClip &) = delete;
+    AnimationClip &operator=(const AnimationClip &) = delete;
+
+    /**
+     * @brief Compresses raw keys into the clip, replacing whatever it held
+     * @return False when the frames are missing or the skeleton is too big
+     */
+    bool build(const AnimationClipCreateInfo &info);
+
+    /**
+     * @brief Samples every bone of the clip
+     * @param time Seconds since the start, wrapped when looping and clamped otherwise
+     * @param pose Overwritten, resized to the clip's bone groups
+     * @param loop Wraps time around the clip instead of holding the last key, which should match the first
+     * @param interpolation How rotations are blended between keys
+     */
+    void sample(float time, LocalPose &pose, bool loop = true,
+                AnimationInterpolation interpolation = AnimationInterpolation::Nlerp) const;
+
+    [[nodiscard]] float getDuration() const { return m_duration; }
+    [[nodiscard]] uint32_t getBoneCount() const { return m_boneCount; }
+    [[nodiscard]] uint32_t getFrameCount() const { return m_frameCount; }
+    [[nodiscard]] const AnimationClipStats &getStats() const { return m_stats; }
+
+private:
+    /// Animated rotations, keys are snorm16 in [frame][track group][component][lane] order
+    struct RotationTracks {
+        std::vector<BoneIndex> bones;   // Padded to a multiple of four by repeating the last track
+        std::vector<int16_t> keys;
+    };
+
+    /// Animated translations or scales, keys are unorm16 inside [origin, origin + 65535 * step]
+    struct VectorTracks {
+        std::vector<BoneIndex> bones;
+        std::vector<float> origin;      // [track group][component][lane]
+        std::vector<float> step;
+        std::vector<uint16_t> keys;     // [frame][track group][component][lane]
+    };
+
+    // Both return how many channels are animated, before padding
+    static uint32_t compressRotations(const AnimationClipCreateInfo &info, RotationTracks &tracks);
+    static uint32_t compressVectors(const AnimationClipCreateInfo &info, bool scale, VectorTracks &tracks);
+    void sampleVectors(const VectorTracks &tracks, bool scale, uint32_t frame0, uint32_t frame1, float alpha,
+                       LocalPose &pose) const;
+    void release();
+
+    uint32_t m_boneCount = 0;
+    uint32_t m_frameCount = 0;
+    float m_sampleRate = 0.0f;
+    float m_duration = 0.0f;
+
+    LocalPose m_restPose;               // First key of every channel, the constant ones are never overwritten
+    RotationTracks m_rotations;
+    VectorTracks m_translations;
+    VectorTracks m_scales;
+
+    AnimationClipStats m_stats;
+};
+
+}
+
+#endif //ANIMATIONCLIP_H
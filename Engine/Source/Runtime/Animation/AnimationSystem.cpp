@@ -0,0 +1,152 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "AnimationSystem.h"
+
+#include <cmath>
+#include <string>
+
+#include "Helpers/Console.h"
+#include "Math/Simd.h"
+
+namespace Trin::Runtime::Animation {
+    using Simd::Float4;
+
+    void skinVertices(const Matrix4 *skinning, const Asset::FloatVertex *vertices, const SkinWeights *weights,
+                      uint32_t count, Asset::FloatVertex *out) {
+        alignas(16) float position[4];
+        alignas(16) float normal[4];
+        for (uint32_t i = 0; i < count; i++) {
+            const Asset::FloatVertex &vertex = vertices[i];
+            const SkinWeights &influence = weights[i];
+
+            // Blend the matrices first, one transform per vertex instead of one per influence
+            Float4 columns[4];
+            for (int column = 0; column < 4; column++) {
+                Float4 blended = skinning[influence.bones[0]].column(column) * Float4(influence.weights[0]);
+                for (int k = 1; k < 4; k++) {
+                    blended = Simd::madd(skinning[influence.bones[k]].column(column), Float4(influence.weights[k]),
+                                         blended);
+                }
+                columns[column] = blended;
+            }
+
+            Simd::madd(columns[0], Float4(vertex.position[0]),
+                       Simd::madd(columns[1], Float4(vertex.position[1]),
+                                  Simd::madd(columns[2], Float4(vertex.position[2]), columns[3]))).store(position);
+            Simd::madd(columns[0], Float4(vertex.normal[0]),
+                       Simd::madd(columns[1], Float4(vertex.normal[1]),
+                                  columns[2] * Float4(vertex.normal[2]))).store(normal);
+
+            const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+            Asset::FloatVertex &target = out[i];
+            for (int c = 0; c < 3; c++) {
+                target.position[c] = position[c];
+                target.normal[c] = normal[c] * inverse;
+            }
+            target.uv[0] = vertex.uv[0];
+            target.uv[1] = vertex.uv[1];
+        }
+    }
+
+    CharacterId AnimationSystem::addCharacter(const CharacterCreateInfo &info) {
+        if (!info.skeleton || info.skeleton->getBoneCount() == 0) {
+            Helpers::Console::error("Character needs a skeleton with at least one bone");
+            return kInvalidCharacter;
+        }
+        if (info.clip && info.clip->getBoneCount() != info.skeleton->getBoneCount()) {
+            Helpers::Console::error("Character clip was made for a different skeleton");
+            return kInvalidCharacter;
+        }
+        if (info.mesh && info.mesh->weights.size() != info.mesh->vertices.size()) {
+            Helpers::Console::error("Character mesh needs skin weights for every vertex");
+            return kInvalidCharacter;
+        }
+        if (info.mesh) {
+            // Skinning reads all four influences, a zero weight still indexes the palette
+            const uint32_t boneCount = info.skeleton->getBoneCount();
+            for (size_t vertex = 0; vertex < info.mesh->weights.size(); vertex++) {
+                for (const BoneIndex bone : info.mesh->weights[vertex].bones) {
+                    if (bone >= boneCount) {
+                        Helpers::Console::error("Character mesh vertex " + std::to_string(vertex) + " uses bone " +
+                                                std::to_string(bone) + " but the skeleton has " +
+                                                std::to_string(boneCount));
+                        return kInvalidCharacter;
+                    }
+                }
+            }
+        }
+
+        Character character;
+        character.skeleton = info.skeleton;
+        character.clip = info.clip;
+        character.mesh = info.mesh;
+        character.time = info.time;
+        character.speed = info.speed;
+        character.loop = info.loop;
+        character.local = info.skeleton->getBindPose();
+        character.model.resize(info.skeleton->getBoneCount());
+        character.skinning.resize(info.skeleton->getBoneCount());
+        if (info.mesh) {
+            character.vertices.resize(info.mesh->vertices.size());
+        }
+        m_characters.push_back(std::move(character));
+        return static_cast<CharacterId>(m_characters.size() - 1);
+    }
+
+    void AnimationSystem::play(CharacterId id, const AnimationClip *clip, float time) {
+        Character &character = m_characters[id];
+        if (clip && clip->getBoneCount() != character.skeleton->getBoneCount()) {
+            Helpers::Console::error("Character clip was made for a different skeleton");
+            return;
+        }
+        character.clip = clip;
+        character.time = time;
+        if (!clip) {
+            character.local = character.skeleton->getBindPose();
+        }
+    }
+
+    void AnimationSystem::update(float deltaSeconds, Core::JobSystem *jobs) {
+        const auto count = static_cast<uint32_t>(m_characters.size());
+        const auto animateRange = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                animate(m_characters[i], deltaSeconds);
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(count, kCharactersPerTask, animateRange);
+        } else {
+            animateRange(0, count);
+        }
+
+        m_stats = {};
+        m_stats.characters = count;
+        for (const Character &character : m_characters) {
+            m_stats.bones += character.skeleton->getBoneCount();
+            m_stats.skinnedVertices += static_cast<uint32_t>(character.vertices.size());
+        }
+    }
+
+    void AnimationSystem::animate(Character &character, float deltaSeconds) const {
+        const Skeleton &skeleton = *character.skeleton;
+        if (character.clip) {
+            character.time += deltaSeconds * character.speed;
+            // Keep the clock inside the clip so it never loses precision over a long session
+            const float duration = character.clip->getDuration();
+            if (character.loop && duration > 0.0f) {
+                character.time = std::fmod(character.time, duration);
+            }
+            character.clip->sample(character.time, character.local, character.loop, m_interpolation);
+        }
+
+        skeleton.localToModel(character.local, character.model.data());
+        skeleton.skinningMatrices(character.model.data(), character.skinning.data());
+        if (character.mesh) {
+            skinVertices(character.skinning.data(), character.mesh->vertices.data(), character.mesh->weights.data(),
+                         static_cast<uint32_t>(character.vertices.size()), character.vertices.data());
+        }
+    }
+}
@@ -0,0 +1,121 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef ANIMATIONSYSTEM_H
+#define ANIMATIONSYSTEM_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "AnimationClip.h"
+#include "Skeleton.h"
+#include "Asset/MeshFormat.h"
+#include "Core/JobSystem.h"
+
+namespace Trin::Runtime::Animation {
+    using CharacterId = uint32_t;
+    constexpr CharacterId kInvalidCharacter = std::numeric_limits<CharacterId>::max();
+
+    /// Up to four influences per vertex, unused slots have a zero weight
+    struct SkinWeights {
+        BoneIndex bones[4];
+        float weights[4];
+    };
+
+    /// Bind pose vertices and their influences, shared by every character wearing the mesh
+    struct SkinnedMesh {
+        std::vector<Asset::FloatVertex> vertices;
+        std::vector<SkinWeights> weights;
+    };
+
+    struct CharacterCreateInfo {
+        const Skeleton *skeleton = nullptr;
+        const AnimationClip *clip = nullptr;    // Holds the bind pose while null
+        float time = 0.0f;
+        float speed = 1.0f;
+        bool loop = true;
+        const SkinnedMesh *mesh = nullptr;      // Skinned on the CPU every update when set
+    };
+
+    struct AnimationStats {
+        uint32_t characters = 0;
+        uint32_t bones = 0;             // Summed over every character
+        uint32_t skinnedVertices = 0;
+    };
+
+    /**
+     * @brief Linear blend skinning, normals are renormalized afterwards
+     * @param skinning One matrix per bone, from Skeleton::skinningMatrices
+     * @param vertices Bind pose vertices, uvs are copied through
+     * @param weights Influences of each vertex
+     * @param count Vertices to skin
+     * @param out Skinned vertices, laid out for a vertex buffer
+     */
+    void skinVertices(const Matrix4 *skinning, const Asset::FloatVertex *vertices, const SkinWeights *weights,
+                      uint32_t count, Asset::FloatVertex *out);
+
+/**
+ * Animates every character each update: samples its clip, builds model space and skinning
+ * matrices, and optionally skins its mesh on the CPU.
+ *
+ * Characters only read shared skeletons, clips and meshes and write their own buffers, so
+ * they are split across the job system in batches with no locking.
+ */
+class AnimationSystem {
+public:
+    /// Returns kInvalidCharacter when the skeleton is missing or disagrees with the clip or mesh
+    CharacterId addCharacter(const CharacterCreateInfo &info);
+
+    /// Switches clip, null returns the character to its bind pose
+    void play(CharacterId id, const AnimationClip *clip, float time = 0.0f);
+
+    void setSpeed(CharacterId id, float speed) { m_characters[id].speed = speed; }
+    void setInterpolation(AnimationInterpolation interpolation) { m_interpolation = interpolation; }
+
+    /**
+     * @brief Advances every character and rebuilds its matrices and skinned vertices
+     * @param deltaSeconds Time since the last update
+     * @param jobs Pool to spread the characters over, nullptr animates them on the calling thread
+     */
+    void update(float deltaSeconds, Core::JobSystem *jobs = &Core::JobSystem::get());
+
+    [[nodiscard]] const std::vector<Matrix4> &getModelPose(CharacterId id) const { return m_characters[id].model; }
+    [[nodiscard]] const std::vector<Matrix4> &getSkinningMatrices(CharacterId id) const {
+        return m_characters[id].skinning;
+    }
+    /// Empty unless the character was given a mesh
+    [[nodiscard]] const std::vector<Asset::FloatVertex> &getSkinnedVertices(CharacterId id) const {
+        return m_characters[id].vertices;
+    }
+    [[nodiscard]] const AnimationStats &getStats() const { return m_stats; }
+    [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_characters.size()); }
+
+private:
+    struct Character {
+        const Skeleton *skeleton = nullptr;
+        const AnimationClip *clip = nullptr;
+        const SkinnedMesh *mesh = nullptr;
+        float time = 0.0f;
+        float speed = 1.0f;
+        bool loop = true;
+        LocalPose local;
+        std::vector<Matrix4> model;
+        std::vector<Matrix4> skinning;
+        std::vector<Asset::FloatVertex> vertices;
+    };
+
+    // Characters per job, a 64 bone character takes a few microseconds
+    static constexpr uint32_t kCharactersPerTask = 16;
+
+    void animate(Character &character, float deltaSeconds) const;
+
+    std::vector<Character> m_characters;
+    AnimationInterpolation m_interpolation = AnimationInterpolation::Nlerp;
+    AnimationStats m_stats;
+};
+
+}
+
+#endif //ANIMATIONSYSTEM_H
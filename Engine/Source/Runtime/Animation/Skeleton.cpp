@@ -0,0 +1,97 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "Skeleton.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Helpers/Console.h"
+#include "Math/Simd.h"
+
+namespace Trin::Runtime::Animation {
+    using Simd::Float4;
+
+    bool Skeleton::init(std::vector<BoneIndex> parents, const std::vector<BoneTransform> &bindPose) {
+        if (parents.size() != bindPose.size() || parents.size() >= kNoParentBone) {
+            Helpers::Console::error("Skeleton needs one bind transform per bone and fewer than 65535 bones");
+            return false;
+        }
+        for (size_t bone = 0; bone < parents.size(); bone++) {
+            if (parents[bone] != kNoParentBone && parents[bone] >= bone) {
+                Helpers::Console::error("Skeleton bone " + std::to_string(bone) + " comes before its parent");
+                return false;
+            }
+        }
+
+        m_parents = std::move(parents);
+        // Spare lanes of the last group hold identity transforms so they never produce NaNs
+        m_bindPose.assign((m_parents.size() + 3) / 4, {});
+        for (uint32_t bone = 0; bone < m_bindPose.size() * 4; bone++) {
+            writeBone(m_bindPose, bone, bone < bindPose.size() ? bindPose[bone] : BoneTransform{});
+        }
+
+        std::vector<Matrix4> model(m_parents.size());
+        localToModel(m_bindPose, model.data());
+        m_inverseBind.resize(m_parents.size());
+        for (size_t bone = 0; bone < model.size(); bone++) {
+            m_inverseBind[bone] = model[bone].inverseAffine();
+        }
+        return true;
+    }
+
+    void Skeleton::localToModel(const LocalPose &local, Matrix4 *model) const {
+        const auto boneCount = static_cast<uint32_t>(m_parents.size());
+        const Float4 one(1.0f);
+        const Float4 two(2.0f);
+        Matrix4 matrices[4];
+
+        for (uint32_t group = 0; group * 4 < boneCount; group++) {
+            const BoneGroup &bones = local[group];
+            const Float4 x = Float4::load(bones.rotation[0]);
+            const Float4 y = Float4::load(bones.rotation[1]);
+            const Float4 z = Float4::load(bones.rotation[2]);
+            const Float4 w = Float4::load(bones.rotation[3]);
+            const Float4 sx = Float4::load(bones.scale[0]);
+            const Float4 sy = Float4::load(bones.scale[1]);
+            const Float4 sz = Float4::load(bones.scale[2]);
+
+            const Float4 xx = x * x * two, yy = y * y * two, zz = z * z * two;
+            const Float4 xy = x * y * two, xz = x * z * two, yz = y * z * two;
+            const Float4 wx = w * x * two, wy = w * y * two, wz = w * z * two;
+
+            // Rows of the block are matrix elements, lanes are bones, the transpose flips that around
+            Float4 columns[4][4] = {
+                {(one - yy - zz) * sx, (xy + wz) * sx, (xz - wy) * sx, Float4(0.0f)},
+                {(xy - wz) * sy, (one - xx - zz) * sy, (yz + wx) * sy, Float4(0.0f)},
+                {(xz + wy) * sz, (yz - wx) * sz, (one - xx - yy) * sz, Float4(0.0f)},
+                {Float4::load(bones.translation[0]), Float4::load(bones.translation[1]),
+                 Float4::load(bones.translation[2]), one},
+            };
+            for (int column = 0; column < 4; column++) {
+                Float4 *rows = columns[column];
+                Simd::transpose(rows[0], rows[1], rows[2], rows[3]);
+                for (int lane = 0; lane < 4; lane++) {
+                    rows[lane].store(&matrices[lane].m[column * 4]);
+                }
+            }
+
+            const uint32_t end = std::min(boneCount, group * 4 + 4);
+            for (uint32_t bone = group * 4; bone < end; bone++) {
+                const BoneIndex parent = m_parents[bone];
+                if (parent == kNoParentBone) {
+                    model[bone] = matrices[bone & 3];
+                } else {
+                    Matrix4::multiply(model[parent], matrices[bone & 3], model[bone]);
+                }
+            }
+        }
+    }
+
+    void Skeleton::skinningMatrices(const Matrix4 *model, Matrix4 *skinning) const {
+        for (size_t bone = 0; bone < m_parents.size(); bone++) {
+            Matrix4::multiply(model[bone], m_inverseBind[bone], skinning[bone]);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SKELETON_H
+#define SKELETON_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+
+namespace Trin::Runtime::Animation {
+    using namespace Trin::Math;
+
+    using BoneIndex = uint16_t;
+    constexpr BoneIndex kNoParentBone = std::numeric_limits<BoneIndex>::max();
+
+    struct BoneTransform {
+        Quaternion rotation;
+        Vector3 translation = Vector3::zero();
+        Vector3 scale = Vector3::one();
+    };
+
+    /// Local transforms of four consecutive bones, one bone per lane
+    struct alignas(16) BoneGroup {
+        float rotation[4][4];       // x, y, z, w
+        float translation[3][4];
+        float scale[3][4];
+    };
+
+    /// Local transforms of a whole skeleton, bone i sits in lane i % 4 of group i / 4
+    using LocalPose = std::vector<BoneGroup>;
+
+    inline void writeBone(LocalPose &pose, uint32_t bone, const BoneTransform &transform) {
+        BoneGroup &group = pose[bone >> 2];
+        const uint32_t lane = bone & 3;
+        group.rotation[0][lane] = transform.rotation.x;
+        group.rotation[1][lane] = transform.rotation.y;
+        group.rotation[2][lane] = transform.rotation.z;
+        group.rotation[3][lane] = transform.rotation.w;
+        group.translation[0][lane] = transform.translation.x;
+        group.translation[1][lane] = transform.translation.y;
+        group.translation[2][lane] = transform.translation.z;
+        group.scale[0][lane] = transform.scale.x;
+        group.scale[1][lane] = transform.scale.y;
+        group.scale[2][lane] = transform.scale.z;
+    }
+
+    inline BoneTransform readBone(const LocalPose &pose, uint32_t bone) {
+        const BoneGroup &group = pose[bone >> 2];
+        const uint32_t lane = bone & 3;
+        return {{group.rotation[0][lane], group.rotation[1][lane], group.rotation[2][lane], group.rotation[3][lane]},
+                {group.translation[0][lane], group.translation[1][lane], group.translation[2][lane]},
+                {group.scale[0][lane], group.scale[1][lane], group.scale[2][lane]}};
+    }
+
+/**
+ * Bone hierarchy and bind pose shared by every character using it.
+ *
+ * Parents come before their children, so a single forward pass over the bones turns local
+ * transforms into model space ones.
+ */
+class Skeleton {
+public:
+    /**
+     * @brief Sets up the bones
+     * @param parents Parent of every bone, kNoParentBone for roots, always a lower index than the bone
+     * @param bindPose Local transform of every bone in the pose the mesh was skinned in
+     * @return False when the arrays disagree in size or a parent comes after its child
+     */
+    bool init(std::vector<BoneIndex> parents, const std::vector<BoneTransform> &bindPose);
+
+    [[nodiscard]] uint32_t getBoneCount() const { return static_cast<uint32_t>(m_parents.size()); }
+    [[nodiscard]] uint32_t getGroupCount() const { return static_cast<uint32_t>(m_bindPose.size()); }
+    [[nodiscard]] const std::vector<BoneIndex> &getParents() const { return m_parents; }
+    [[nodiscard]] const LocalPose &getBindPose() const { return m_bindPose; }
+    [[nodiscard]] const std::vector<Matrix4> &getInverseBind() const { return m_inverseBind; }
+
+    /**
+     * @brief Turns a local pose into model space matrices
+     *
+     * Builds the local matrices of four bones at a time straight from the pose's lanes, then
+     * chains each one onto its parent's model matrix.
+     *
+     * @param local Pose with getGroupCount() groups
+     * @param model getBoneCount() matrices
+     */
+    void localToModel(const LocalPose &local, Matrix4 *model) const;
+
+    /// Model space matrices times the inverse bind pose, what skinning consumes
+    void skinningMatrices(const Matrix4 *model, Matrix4 *skinning) const;
+
+private:
+    std::vector<BoneIndex> m_parents;
+    LocalPose m_bindPose;
+    std::vector<Matrix4> m_inverseBind;
+};
+
+}
+
+#endif //SKELETON_H
@@ -0,0 +1,45 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "AssetRegistry.h"
+
+#include <filesystem>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Asset {
+    bool AssetRegistry::mount(const std::string &root) {
+        std::error_code error;
+        std::filesystem::recursive_directory_iterator it(root, error);
+        if (error) {
+            Helpers::Console::error("Failed to mount " + root + ": " + error.message());
+            return false;
+        }
+
+        const auto mount = static_cast<uint32_t>(m_mounts.size());
+        m_mounts.push_back(root);
+        for (const std::filesystem::recursive_directory_iterator end; it != end; it.increment(error)) {
+            if (error) {
+                Helpers::Console::warn("Skipping part of " + root + ": " + error.message());
+                break;
+            }
+            if (!it->is_regular_file(error)) {
+                continue;
+            }
+
+            // Forward slashes on every platform, so names hash the same everywhere
+            const std::string name = std::filesystem::relative(it->path(), root, error).generic_string();
+            AssetEntry &entry = m_entries[Helpers::StringId::intern(name)];
+            entry.path = it->path().string();
+            entry.size = it->file_size(error);
+            entry.mount = mount;
+        }
+        return true;
+    }
+
+    const AssetEntry *AssetRegistry::find(Helpers::StringId name) const {
+        const auto it = m_entries.find(name);
+        return it != m_entries.end() ? &it->second : nullptr;
+    }
+}
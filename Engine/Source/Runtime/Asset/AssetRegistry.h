@@ -0,0 +1,51 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef ASSETREGISTRY_H
+#define ASSETREGISTRY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Helpers/StringId.h"
+
+namespace Trin::Runtime::Asset {
+struct AssetEntry {
+    std::string path;       // Where the file lives on disk
+    uint64_t size = 0;
+    uint32_t mount = 0;     // Index of the mount it came from
+};
+
+/**
+ * Index of every asset file under a set of mounted directories.
+ *
+ * Mounting walks the directory once and keys each file by its path relative to the mount
+ * root, so "Meshes/rock.tmesh"_sid resolves without touching the file system again. Later
+ * mounts override earlier ones, which lets a patch or mod directory shadow the base game.
+ */
+class AssetRegistry {
+public:
+    /**
+     * @brief Indexes every file below a directory
+     * @param root Directory to mount
+     * @return False when the directory does not exist or cannot be read
+     */
+    bool mount(const std::string &root);
+
+    /// Entry for a mount relative path such as "Textures/brick.ttex", nullptr when no mount has it
+    [[nodiscard]] const AssetEntry *find(Helpers::StringId name) const;
+
+    [[nodiscard]] size_t size() const { return m_entries.size(); }
+    [[nodiscard]] const std::vector<std::string> &getMounts() const { return m_mounts; }
+
+private:
+    std::vector<std::string> m_mounts;
+    std::unordered_map<Helpers::StringId, AssetEntry> m_entries;
+};
+
+}
+
+#endif //ASSETREGISTRY_H
@@ -0,0 +1,174 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "MeshCooker.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <fstream>
+
+#include "MeshFormat.h"
+#include "VertexCacheOptimizer.h"
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Asset {
+    namespace {
+        template<typename T>
+        void writeBlock(std::ofstream &stream, uint64_t offset, const T *data, size_t count) {
+            stream.seekp(static_cast<std::streamoff>(offset));
+            stream.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+    }
+
+    bool MeshCooker::cook(SourceMesh &mesh, const std::string &path, const MeshCookOptions &options, MeshCookStats *stats) {
+        const uint32_t vertexCount = mesh.getVertexCount();
+        if (vertexCount == 0 || mesh.indices.size() % 3 != 0 ||
+            (!mesh.normals.empty() && mesh.normals.size() != mesh.positions.size()) ||
+            (!mesh.uvs.empty() && mesh.uvs.size() != static_cast<size_t>(vertexCount) * 2)) {
+            Helpers::Console::error("Mesh has mismatched attribute counts: " + path);
+            return false;
+        }
+        for (const uint32_t index : mesh.indices) {
+            if (index >= vertexCount) {
+                Helpers::Console::error("Mesh index out of range: " + path);
+                return false;
+            }
+        }
+        if (mesh.normals.empty()) {
+            computeNormals(mesh);
+        }
+
+        MeshCookStats result{};
+        result.triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+        result.acmrBefore = VertexCacheOptimizer::averageCacheMissRatio(mesh.indices, vertexCount);
+
+        if (options.optimizeVertexCache) {
+            VertexCacheOptimizer::optimizeTriangles(mesh.indices, vertexCount);
+        }
+        // Renumbering also drops vertices no triangle uses
+        const std::vector<uint32_t> newToOld = VertexCacheOptimizer::optimizeFetch(mesh.indices, vertexCount);
+        result.acmrAfter = VertexCacheOptimizer::averageCacheMissRatio(mesh.indices, static_cast<uint32_t>(newToOld.size()));
+        result.vertexCount = static_cast<uint32_t>(newToOld.size());
+
+        MeshFileHeader header{};
+        header.magic = MeshFormat::kMagic;
+        header.version = MeshFormat::kVersion;
+        header.flags = (options.quantize ? static_cast<uint32_t>(MeshFormat::Quantized) : 0u) |
+                       (result.vertexCount > 0xFFFF ? static_cast<uint32_t>(MeshFormat::Index32) : 0u);
+        header.vertexStride = options.quantize ? sizeof(QuantizedVertex) : sizeof(FloatVertex);
+        header.vertexCount = result.vertexCount;
+        header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+        for (int axis = 0; axis < 3; axis++) {
+            header.boundsMin[axis] = FLT_MAX;
+            header.boundsMax[axis] = -FLT_MAX;
+        }
+        for (const uint32_t source : newToOld) {
+            for (int axis = 0; axis < 3; axis++) {
+                header.boundsMin[axis] = std::min(header.boundsMin[axis], mesh.positions[source * 3 + axis]);
+                header.boundsMax[axis] = std::max(header.boundsMax[axis], mesh.positions[source * 3 + axis]);
+            }
+        }
+
+        header.vertexOffset = MeshFormat::align(sizeof(MeshFileHeader));
+        header.vertexSize = static_cast<uint64_t>(header.vertexCount) * header.vertexStride;
+        header.indexOffset = MeshFormat::align(header.vertexOffset + header.vertexSize);
+        header.indexSize = static_cast<uint64_t>(header.indexCount) * ((header.flags & MeshFormat::Index32) ? 4 : 2);
+
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            Helpers::Console::error("Failed to open mesh output: " + path);
+            return false;
+        }
+        writeBlock(stream, 0, &header, 1);
+
+        auto sourceUv = [&](uint32_t source, int component) {
+            return mesh.uvs.empty() ? 0.0f : mesh.uvs[source * 2 + component];
+        };
+
+        if (options.quantize) {
+            std::vector<QuantizedVertex> vertices(header.vertexCount);
+            for (uint32_t i = 0; i < header.vertexCount; i++) {
+                const uint32_t source = newToOld[i];
+                QuantizedVertex &vertex = vertices[i];
+                for (int axis = 0; axis < 3; axis++) {
+                    const float value = mesh.positions[source * 3 + axis];
+                    vertex.position[axis] = Quantize::toUnorm16(value, header.boundsMin[axis], header.boundsMax[axis]);
+                    const float decoded = Quantize::fromUnorm16(vertex.position[axis], header.boundsMin[axis], header.boundsMax[axis]);
+                    result.maxPositionError = std::max(result.maxPositionError, std::fabs(decoded - value));
+                }
+                vertex.pad = 0;
+                Quantize::encodeOctahedral(&mesh.normals[source * 3], vertex.normal);
+                vertex.uv[0] = Quantize::floatToHalf(sourceUv(source, 0));
+                vertex.uv[1] = Quantize::floatToHalf(sourceUv(source, 1));
+            }
+            writeBlock(stream, header.vertexOffset, vertices.data(), vertices.size());
+        } else {
+            std::vector<FloatVertex> vertices(header.vertexCount);
+            for (uint32_t i = 0; i < header.vertexCount; i++) {
+                const uint32_t source = newToOld[i];
+                FloatVertex &vertex = vertices[i];
+                std::copy_n(&mesh.positions[source * 3], 3, vertex.position);
+                std::copy_n(&mesh.normals[source * 3], 3, vertex.normal);
+                vertex.uv[0] = sourceUv(source, 0);
+                vertex.uv[1] = sourceUv(source, 1);
+            }
+            writeBlock(stream, header.vertexOffset, vertices.data(), vertices.size());
+        }
+
+        if (header.flags & MeshFormat::Index32) {
+            writeBlock(stream, header.indexOffset, mesh.indices.data(), mesh.indices.size());
+        } else {
+            std::vector<uint16_t> indices(mesh.indices.begin(), mesh.indices.end());
+            writeBlock(stream, header.indexOffset, indices.data(), indices.size());
+        }
+
+        if (!stream) {
+            Helpers::Console::error("Failed to write mesh output: " + path);
+            return false;
+        }
+
+        result.fileBytes = header.indexOffset + header.indexSize;
+        result.vertexStride = header.vertexStride;
+        if (stats) {
+            *stats = result;
+        }
+        return true;
+    }
+
+    void MeshCooker::computeNormals(SourceMesh &mesh) {
+        mesh.normals.assign(mesh.positions.size(), 0.0f);
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const float *a = &mesh.positions[mesh.indices[i] * 3];
+            const float *b = &mesh.positions[mesh.indices[i + 1] * 3];
+            const float *c = &mesh.positions[mesh.indices[i + 2] * 3];
+            const float e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            // Unnormalized, so larger faces weigh more
+            const float face[3] = {
+                e0[1] * e1[2] - e0[2] * e1[1],
+                e0[2] * e1[0] - e0[0] * e1[2],
+                e0[0] * e1[1] - e0[1] * e1[0]
+            };
+            for (size_t corner = 0; corner < 3; corner++) {
+                float *normal = &mesh.normals[mesh.indices[i + corner] * 3];
+                normal[0] += face[0];
+                normal[1] += face[1];
+                normal[2] += face[2];
+            }
+        }
+        for (size_t i = 0; i < mesh.normals.size(); i += 3) {
+            float *normal = &mesh.normals[i];
+            const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length > 0.0f) {
+                normal[0] /= length;
+                normal[1] /= length;
+                normal[2] /= length;
+            } else {
+                normal[2] = 1.0f;
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef MESHCOOKER_H
+#define MESHCOOKER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Trin::Runtime::Asset {
+/// Triangle list as it comes out of an importer, normals and uvs may be empty
+struct SourceMesh {
+    std::vector<float> positions;   // xyz per vertex
+    std::vector<float> normals;     // xyz per vertex
+    std::vector<float> uvs;         // uv per vertex
+    std::vector<uint32_t> indices;
+
+    [[nodiscard]] uint32_t getVertexCount() const { return static_cast<uint32_t>(positions.size() / 3); }
+};
+
+struct MeshCookOptions {
+    bool quantize = true;
+    bool optimizeVertexCache = true;
+};
+
+struct MeshCookStats {
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+    float acmrBefore = 0.0f;        // Average cache misses per triangle
+    float acmrAfter = 0.0f;
+    uint64_t fileBytes = 0;
+    uint32_t vertexStride = 0;
+    float maxPositionError = 0.0f;  // Largest quantization error on any axis, in mesh units
+};
+
+/**
+ * Turns importer output into the cooked .tmesh format.
+ *
+ * Reorders triangles for the post transform cache and vertices for fetch locality,
+ * quantizes attributes when asked and writes the blocks at their aligned offsets.
+ */
+class MeshCooker {
+public:
+    /**
+     * @brief Cooks a mesh and writes it to disk
+     * @param mesh Source mesh, consumed by the reordering
+     * @param path Output file
+     * @param options Layout and optimization switches
+     * @param stats Filled with what the cook did, may be nullptr
+     * @return False when the mesh is malformed or the file could not be written
+     */
+    static bool cook(SourceMesh &mesh, const std::string &path, const MeshCookOptions &options = {},
+                     MeshCookStats *stats = nullptr);
+
+    /// Fills normals by averaging the face normals around each vertex
+    static void computeNormals(SourceMesh &mesh);
+};
+
+}
+
+#endif //MESHCOOKER_H
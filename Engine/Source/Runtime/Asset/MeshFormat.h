@@ -0,0 +1,164 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef MESHFORMAT_H
+#define MESHFORMAT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace Trin::Runtime::Asset {
+/**
+ * Cooked mesh file (.tmesh) layout.
+ *
+ * | MeshFileHeader | vertex block | index block |
+ *
+ * Both blocks start on a kBlockAlignment boundary so a mapped file can be handed to a
+ * staging buffer, or bound at an offset, without repacking anything.
+ */
+struct MeshFormat {
+    static constexpr uint32_t kMagic = 0x48534D54;  // "TMSH"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kBlockAlignment = 256;
+
+    enum Flags : uint32_t {
+        Quantized = 1u << 0,    // QuantizedVertex instead of FloatVertex
+        Index32 = 1u << 1,      // 32 bit indices instead of 16 bit
+    };
+
+    static constexpr uint64_t align(uint64_t offset) {
+        return (offset + kBlockAlignment - 1) & ~static_cast<uint64_t>(kBlockAlignment - 1);
+    }
+};
+
+struct MeshFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t vertexStride;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint64_t vertexOffset;
+    uint64_t vertexSize;
+    uint64_t indexOffset;
+    uint64_t indexSize;
+    float boundsMin[3];     // Quantized positions map [0, 65535] onto [boundsMin, boundsMax]
+    float boundsMax[3];
+};
+
+/// Plain layout, 32 bytes
+struct FloatVertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+
+/// Quantized layout, 16 bytes
+struct QuantizedVertex {
+    uint16_t position[3];   // Unorm inside the mesh bounds
+    uint16_t pad;
+    int16_t normal[2];      // Snorm octahedral encoding
+    uint16_t uv[2];         // Half floats
+};
+
+static_assert(sizeof(FloatVertex) == 32, "FloatVertex must stay tightly packed");
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must stay tightly packed");
+
+namespace Quantize {
+    inline uint16_t floatToHalf(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+        uint32_t mantissa = bits & 0x7FFFFFu;
+
+        if (exponent <= 0) {
+            // Too small for a normal half, flush tiny values and keep the rest as subnormals
+            if (exponent < -10) {
+                return static_cast<uint16_t>(sign);
+            }
+            mantissa |= 0x800000u;
+            const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+            return static_cast<uint16_t>(sign | ((mantissa + (1u << (shift - 1))) >> shift));
+        }
+        if (exponent >= 31) {
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+        // Round to nearest, a carry into the exponent is still the right answer
+        return static_cast<uint16_t>(sign | ((static_cast<uint32_t>(exponent) << 10) + ((mantissa + 0x1000u) >> 13)));
+    }
+
+    inline float halfToFloat(uint16_t half) {
+        const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1Fu;
+        const uint32_t mantissa = half & 0x3FFu;
+
+        uint32_t bits;
+        if (exponent == 0) {
+            const float value = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -value : value;
+        }
+        if (exponent == 31) {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        } else {
+            bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        }
+        float out;
+        std::memcpy(&out, &bits, sizeof(out));
+        return out;
+    }
+
+    inline int16_t toSnorm(float value) {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    inline float fromSnorm(int16_t value) {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    /// Maps a unit vector onto the octahedron and unfolds it into [-1, 1]^2
+    inline void encodeOctahedral(const float normal[3], int16_t out[2]) {
+        const float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+        float x = length > 0.0f ? normal[0] / length : 0.0f;
+        float y = length > 0.0f ? normal[1] / length : 0.0f;
+        if (normal[2] < 0.0f) {
+            const float ox = x;
+            x = (1.0f - std::fabs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+            y = (1.0f - std::fabs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+        }
+        out[0] = toSnorm(x);
+        out[1] = toSnorm(y);
+    }
+
+    inline void decodeOctahedral(const int16_t encoded[2], float out[3]) {
+        float x = fromSnorm(encoded[0]);
+        float y = fromSnorm(encoded[1]);
+        const float z = 1.0f - std::fabs(x) - std::fabs(y);
+        if (z < 0.0f) {
+            const float ox = x;
+            x = (1.0f - std::fabs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+            y = (1.0f - std::fabs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+        }
+        const float length = std::sqrt(x * x + y * y + z * z);
+        out[0] = x / length;
+        out[1] = y / length;
+        out[2] = z / length;
+    }
+
+    inline uint16_t toUnorm16(float value, float min, float max) {
+        const float range = max - min;
+        const float t = range > 0.0f ? (value - min) / range : 0.0f;
+        return static_cast<uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    inline float fromUnorm16(uint16_t value, float min, float max) {
+        return min + (max - min) * (static_cast<float>(value) / 65535.0f);
+    }
+}
+
+}
+
+#endif //MESHFORMAT_H
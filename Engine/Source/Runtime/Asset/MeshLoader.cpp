@@ -0,0 +1,114 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "MeshLoader.h"
+
+#include <string>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Asset {
+    bool CookedMesh::open(const std::string &path) {
+        close();
+        if (!m_file.open(path.c_str())) {
+            Helpers::Console::error("Failed to map mesh: " + path);
+            return false;
+        }
+
+        if (m_file.size() < sizeof(MeshFileHeader)) {
+            Helpers::Console::error("Mesh file is truncated: " + path);
+            m_file.close();
+            return false;
+        }
+
+        // Mappings are page aligned, so the header can be read in place
+        const auto *header = reinterpret_cast<const MeshFileHeader *>(m_file.data());
+        if (header->magic != MeshFormat::kMagic || header->version != MeshFormat::kVersion) {
+            Helpers::Console::error("Mesh file has an unknown format or version: " + path);
+            m_file.close();
+            return false;
+        }
+
+        // Every field comes straight from the file, so the range checks are written to never wrap around
+        const uint64_t fileSize = m_file.size();
+        const auto fits = [fileSize](uint64_t offset, uint64_t size) {
+            return offset <= fileSize && fileSize - offset >= size;
+        };
+        const uint64_t expectedStride = (header->flags & MeshFormat::Quantized) ? sizeof(QuantizedVertex) : sizeof(FloatVertex);
+        const uint64_t indexSize = (header->flags & MeshFormat::Index32) ? 4 : 2;
+        if (header->vertexStride != expectedStride ||
+            header->vertexSize != static_cast<uint64_t>(header->vertexCount) * expectedStride ||
+            header->indexSize != static_cast<uint64_t>(header->indexCount) * indexSize ||
+            !fits(header->vertexOffset, header->vertexSize) ||
+            !fits(header->indexOffset, header->indexSize)) {
+            Helpers::Console::error("Mesh file has inconsistent block sizes: " + path);
+            m_file.close();
+            return false;
+        }
+        if (header->vertexOffset % MeshFormat::kBlockAlignment != 0 || header->indexOffset % MeshFormat::kBlockAlignment != 0) {
+            Helpers::Console::error("Mesh file blocks are not aligned to " + std::to_string(MeshFormat::kBlockAlignment) +
+                                    " bytes: " + path);
+            m_file.close();
+            return false;
+        }
+
+        m_header = header;
+#ifndef NDEBUG
+        // Reading every index is too slow for shipping loads, a bad one only shows up as garbage on the GPU
+        for (uint32_t i = 0; i < header->indexCount; i++) {
+            if (getIndex(i) >= header->vertexCount) {
+                Helpers::Console::error("Mesh file index " + std::to_string(i) + " points past its " +
+                                        std::to_string(header->vertexCount) + " vertices: " + path);
+                close();
+                return false;
+            }
+        }
+#endif
+        return true;
+    }
+
+    void CookedMesh::close() {
+        m_header = nullptr;
+        m_file.close();
+    }
+
+    std::span<const std::byte> CookedMesh::getVertexData() const {
+        return {m_file.data() + m_header->vertexOffset, static_cast<size_t>(m_header->vertexSize)};
+    }
+
+    std::span<const std::byte> CookedMesh::getIndexData() const {
+        return {m_file.data() + m_header->indexOffset, static_cast<size_t>(m_header->indexSize)};
+    }
+
+    FloatVertex CookedMesh::getVertex(uint32_t index) const {
+        const std::byte *source = m_file.data() + m_header->vertexOffset + static_cast<uint64_t>(index) * m_header->vertexStride;
+        FloatVertex vertex{};
+        if (!isQuantized()) {
+            std::memcpy(&vertex, source, sizeof(FloatVertex));
+            return vertex;
+        }
+
+        QuantizedVertex packed{};
+        std::memcpy(&packed, source, sizeof(QuantizedVertex));
+        for (int axis = 0; axis < 3; axis++) {
+            vertex.position[axis] = Quantize::fromUnorm16(packed.position[axis], m_header->boundsMin[axis], m_header->boundsMax[axis]);
+        }
+        Quantize::decodeOctahedral(packed.normal, vertex.normal);
+        vertex.uv[0] = Quantize::halfToFloat(packed.uv[0]);
+        vertex.uv[1] = Quantize::halfToFloat(packed.uv[1]);
+        return vertex;
+    }
+
+    uint32_t CookedMesh::getIndex(uint32_t index) const {
+        const std::byte *indices = m_file.data() + m_header->indexOffset;
+        if (hasIndex32()) {
+            uint32_t value;
+            std::memcpy(&value, indices + static_cast<uint64_t>(index) * 4, sizeof(value));
+            return value;
+        }
+        uint16_t value;
+        std::memcpy(&value, indices + static_cast<uint64_t>(index) * 2, sizeof(value));
+        return value;
+    }
+}
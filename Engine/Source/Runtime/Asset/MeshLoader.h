@@ -0,0 +1,52 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef MESHLOADER_H
+#define MESHLOADER_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "MeshFormat.h"
+#include "Helpers/MappedFile.h"
+
+namespace Trin::Runtime::Asset {
+/**
+ * A cooked mesh opened straight from disk.
+ *
+ * The file is memory mapped and only the header is validated, the vertex and index
+ * blocks are exposed as views into the mapping so they can be copied into a staging
+ * buffer directly. Nothing is parsed or converted at load time.
+ */
+class CookedMesh {
+public:
+    /**
+     * @brief Maps a .tmesh file
+     * @param path File written by the mesh cooker
+     * @return False when the file is missing, truncated or from another format version
+     */
+    bool open(const std::string &path);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_header != nullptr; }
+    [[nodiscard]] const MeshFileHeader &getHeader() const { return *m_header; }
+    [[nodiscard]] bool isQuantized() const { return (m_header->flags & MeshFormat::Quantized) != 0; }
+    [[nodiscard]] bool hasIndex32() const { return (m_header->flags & MeshFormat::Index32) != 0; }
+
+    [[nodiscard]] std::span<const std::byte> getVertexData() const;
+    [[nodiscard]] std::span<const std::byte> getIndexData() const;
+
+    /// Decodes one vertex whatever layout the file uses, for tools and CPU side queries
+    [[nodiscard]] FloatVertex getVertex(uint32_t index) const;
+    [[nodiscard]] uint32_t getIndex(uint32_t index) const;
+
+private:
+    Helpers::MappedFile m_file;
+    const MeshFileHeader *m_header = nullptr;
+};
+
+}
+
+#endif //MESHLOADER_H
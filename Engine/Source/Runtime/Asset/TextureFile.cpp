@@ -0,0 +1,160 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "TextureFile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Asset {
+    namespace {
+        // VkFormat values, spelled out so the asset code doesn't need the Vulkan headers
+        constexpr uint32_t kR8Unorm = 9;
+        constexpr uint32_t kR8G8Unorm = 16;
+        constexpr uint32_t kR8G8B8A8Unorm = 37;
+        constexpr uint32_t kB8G8R8A8Srgb = 50;
+        constexpr uint32_t kR16G16B16A16Sfloat = 97;
+        constexpr uint32_t kR32G32B32A32Sfloat = 109;
+        constexpr uint32_t kBc1RgbUnorm = 131;
+        constexpr uint32_t kBc1RgbaSrgb = 134;
+        constexpr uint32_t kBc2Unorm = 135;
+        constexpr uint32_t kBc3Srgb = 138;
+        constexpr uint32_t kBc4Unorm = 139;
+        constexpr uint32_t kBc4Snorm = 140;
+        constexpr uint32_t kBc5Unorm = 141;
+        constexpr uint32_t kBc7Srgb = 146;
+    }
+
+    uint64_t TextureFile::getMipSize(uint32_t format, uint32_t width, uint32_t height) {
+        const uint64_t pixels = static_cast<uint64_t>(width) * height;
+        const uint64_t blocks = static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4);
+        if (format == kR8Unorm) {
+            return pixels;
+        }
+        if (format == kR8G8Unorm) {
+            return pixels * 2;
+        }
+        if (format >= kR8G8B8A8Unorm && format <= kB8G8R8A8Srgb) {
+            return pixels * 4;
+        }
+        if (format == kR16G16B16A16Sfloat) {
+            return pixels * 8;
+        }
+        if (format == kR32G32B32A32Sfloat) {
+            return pixels * 16;
+        }
+        // 4x4 blocks, BC1 and BC4 in 8 bytes, BC2, BC3 and BC5 to BC7 in 16
+        if ((format >= kBc1RgbUnorm && format <= kBc1RgbaSrgb) || format == kBc4Unorm || format == kBc4Snorm) {
+            return blocks * 8;
+        }
+        if ((format >= kBc2Unorm && format <= kBc3Srgb) || (format >= kBc5Unorm && format <= kBc7Srgb)) {
+            return blocks * 16;
+        }
+        return 0;
+    }
+
+    bool TextureFile::open(const std::string &path) {
+        close();
+        if (!m_file.open(path.c_str())) {
+            Helpers::Console::error("Failed to map texture: " + path);
+            return false;
+        }
+
+        const auto *header = reinterpret_cast<const TextureFileHeader *>(m_file.data());
+        if (m_file.size() < sizeof(TextureFileHeader) || header->magic != kMagic || header->version != kVersion ||
+            header->mipCount == 0 || header->mipCount > 16 ||
+            m_file.size() < sizeof(TextureFileHeader) + header->mipCount * sizeof(TextureMipEntry)) {
+            Helpers::Console::error("Texture file has an unknown format or version: " + path);
+            m_file.close();
+            return false;
+        }
+
+        const auto *mips = reinterpret_cast<const TextureMipEntry *>(m_file.data() + sizeof(TextureFileHeader));
+        const uint64_t fileSize = m_file.size();
+        for (uint32_t mip = 0; mip < header->mipCount; mip++) {
+            const TextureMipEntry &entry = mips[mip];
+            // Written so a huge offset or size can't wrap around and pass
+            if (entry.size > fileSize || entry.offset > fileSize - entry.size) {
+                Helpers::Console::error("Texture file is truncated: " + path);
+                m_file.close();
+                return false;
+            }
+
+            // Mip 0 matches the header, every later level halves the one before until 1x1
+            const bool chainEnded = mip > 0 && mips[mip - 1].width == 1 && mips[mip - 1].height == 1;
+            const uint32_t width = mip == 0 ? header->width : std::max(mips[mip - 1].width >> 1, 1u);
+            const uint32_t height = mip == 0 ? header->height : std::max(mips[mip - 1].height >> 1, 1u);
+            const uint64_t size = getMipSize(header->format, width, height);
+            if (chainEnded || width == 0 || height == 0 || entry.width != width || entry.height != height ||
+                size == 0 || entry.size != size) {
+                Helpers::Console::error("Texture file has a bad mip " + std::to_string(mip) + ": " + path);
+                m_file.close();
+                return false;
+            }
+        }
+
+        m_header = header;
+        m_mips = mips;
+        return true;
+    }
+
+    void TextureFile::close() {
+        m_header = nullptr;
+        m_mips = nullptr;
+        m_file.close();
+    }
+
+    std::span<const std::byte> TextureFile::getMipData(uint32_t mip) const {
+        return {m_file.data() + m_mips[mip].offset, static_cast<size_t>(m_mips[mip].size)};
+    }
+
+    bool TextureFile::write(const std::string &path, uint32_t format, uint32_t width, uint32_t height,
+                            const std::vector<std::vector<std::byte>> &mips) {
+        if (mips.empty() || mips.size() > 16) {
+            Helpers::Console::error("Texture needs between 1 and 16 mips: " + path);
+            return false;
+        }
+
+        for (size_t mip = 0; mip < mips.size(); mip++) {
+            const uint64_t size = getMipSize(format, std::max(width >> mip, 1u), std::max(height >> mip, 1u));
+            if (size == 0 || mips[mip].size() != size || (mip > 0 && (width >> (mip - 1)) <= 1 && (height >> (mip - 1)) <= 1)) {
+                Helpers::Console::error("Texture mip " + std::to_string(mip) + " doesn't match its format and size: " + path);
+                return false;
+            }
+        }
+
+        TextureFileHeader header{kMagic, kVersion, format, width, height, static_cast<uint32_t>(mips.size())};
+        std::vector<TextureMipEntry> entries(mips.size());
+
+        uint64_t offset = sizeof(TextureFileHeader) + entries.size() * sizeof(TextureMipEntry);
+        for (size_t mip = mips.size(); mip-- > 0;) {
+            offset = (offset + kMipAlignment - 1) & ~static_cast<uint64_t>(kMipAlignment - 1);
+            entries[mip] = {
+                offset, mips[mip].size(),
+                std::max(width >> mip, 1u), std::max(height >> mip, 1u)
+            };
+            offset += mips[mip].size();
+        }
+
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            Helpers::Console::error("Failed to open texture output: " + path);
+            return false;
+        }
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(TextureMipEntry)));
+        for (size_t mip = mips.size(); mip-- > 0;) {
+            stream.seekp(static_cast<std::streamoff>(entries[mip].offset));
+            stream.write(reinterpret_cast<const char *>(mips[mip].data()), static_cast<std::streamsize>(mips[mip].size()));
+        }
+        if (!stream) {
+            Helpers::Console::error("Failed to write texture output: " + path);
+            return false;
+        }
+        return true;
+    }
+}
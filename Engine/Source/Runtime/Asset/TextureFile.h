@@ -0,0 +1,90 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef TEXTUREFILE_H
+#define TEXTUREFILE_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Helpers/MappedFile.h"
+
+namespace Trin::Runtime::Asset {
+struct TextureFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;        // VkFormat of every mip
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+};
+
+struct TextureMipEntry {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t width;
+    uint32_t height;
+};
+
+/**
+ * Cooked texture (.ttex) with its whole mip chain.
+ *
+ * | TextureFileHeader | TextureMipEntry per mip, mip 0 first | mip data, smallest mip first |
+ *
+ * The data is stored back to front so the low resolution tail every texture keeps resident
+ * is one contiguous read at the start of the file, and each step up in detail continues
+ * reading forward.
+ */
+class TextureFile {
+public:
+    static constexpr uint32_t kMagic = 0x58455454;     // "TTEX"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kMipAlignment = 16;
+
+    /**
+     * @brief Maps a .ttex file
+     * @param path File to open
+     * @return False when the file is missing, truncated, from another format version, or its
+     *         mip chain doesn't match the format and the dimensions of mip 0
+     */
+    bool open(const std::string &path);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_header != nullptr; }
+    [[nodiscard]] const TextureFileHeader &getHeader() const { return *m_header; }
+    [[nodiscard]] const TextureMipEntry &getMip(uint32_t mip) const { return m_mips[mip]; }
+
+    /// Bytes of one mip, pages are read from disk by whichever thread first touches them
+    [[nodiscard]] std::span<const std::byte> getMipData(uint32_t mip) const;
+
+    /**
+     * @brief Bytes of one mip level
+     * @param format VkFormat, 8 to 128 bit uncompressed color formats and BC1 to BC7
+     * @return 0 for a format the streamer doesn't know
+     */
+    static uint64_t getMipSize(uint32_t format, uint32_t width, uint32_t height);
+
+    /**
+     * @brief Writes a texture in the streaming order
+     * @param path Output file
+     * @param format VkFormat of the data
+     * @param width Width of mip 0
+     * @param height Height of mip 0
+     * @param mips Mip data, mip 0 first, every level halving down to 1x1 or however many are given,
+     *        each exactly getMipSize() bytes
+     */
+    static bool write(const std::string &path, uint32_t format, uint32_t width, uint32_t height,
+                      const std::vector<std::vector<std::byte>> &mips);
+
+private:
+    Helpers::MappedFile m_file;
+    const TextureFileHeader *m_header = nullptr;
+    const TextureMipEntry *m_mips = nullptr;
+};
+
+}
+
+#endif //TEXTUREFILE_H
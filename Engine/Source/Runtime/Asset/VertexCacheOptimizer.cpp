@@ -0,0 +1,192 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "VertexCacheOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Trin::Runtime::Asset {
+    namespace {
+        constexpr uint32_t kNotCached = ~0u;
+        constexpr float kLastTriangleScore = 0.75f;
+        constexpr float kCacheDecayPower = 1.5f;
+        constexpr float kValenceBoostScale = 2.0f;
+        constexpr float kValenceBoostPower = 0.5f;
+
+        struct VertexState {
+            uint32_t cachePosition = kNotCached;
+            uint32_t remaining = 0;         // Triangles still to emit that use this vertex
+            uint32_t firstTriangle = 0;     // Offset into the adjacency list
+            float score = 0.0f;
+        };
+
+        float vertexScore(const VertexState &vertex) {
+            if (vertex.remaining == 0) {
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+            if (vertex.cachePosition != kNotCached) {
+                if (vertex.cachePosition < 3) {
+                    // The last triangle's vertices are scored flat so it isn't simply repeated
+                    score = kLastTriangleScore;
+                } else {
+                    const float scale = 1.0f / (VertexCacheOptimizer::kCacheSize - 3);
+                    score = std::pow(1.0f - static_cast<float>(vertex.cachePosition - 3) * scale, kCacheDecayPower);
+                }
+            }
+            // Favor vertices with few triangles left so they leave the working set early
+            score += kValenceBoostScale * std::pow(static_cast<float>(vertex.remaining), -kValenceBoostPower);
+            return score;
+        }
+    }
+
+    void VertexCacheOptimizer::optimizeTriangles(std::vector<uint32_t> &indices, uint32_t vertexCount) {
+        const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Triangle adjacency per vertex, as one flat list
+        std::vector<VertexState> vertices(vertexCount);
+        for (const uint32_t index : indices) {
+            vertices[index].remaining++;
+        }
+        uint32_t offset = 0;
+        for (VertexState &vertex : vertices) {
+            vertex.firstTriangle = offset;
+            offset += vertex.remaining;
+        }
+        std::vector<uint32_t> adjacency(offset);
+        std::vector<uint32_t> fill(vertexCount, 0);
+        for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                const uint32_t vertex = indices[triangle * 3 + corner];
+                adjacency[vertices[vertex].firstTriangle + fill[vertex]++] = triangle;
+            }
+        }
+
+        for (VertexState &vertex : vertices) {
+            vertex.score = vertexScore(vertex);
+        }
+        std::vector<float> triangleScores(triangleCount);
+        for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+            triangleScores[triangle] = vertices[indices[triangle * 3]].score +
+                                       vertices[indices[triangle * 3 + 1]].score +
+                                       vertices[indices[triangle * 3 + 2]].score;
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+
+        // Cache plus room for the three vertices pushed in before the tail is dropped
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> nextCache;
+        cache.reserve(kCacheSize + 3);
+        nextCache.reserve(kCacheSize + 3);
+
+        uint32_t bestTriangle = kNotCached;
+        uint32_t scanCursor = 0;
+
+        for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+            if (bestTriangle == kNotCached) {
+                // Nothing in the cache touches a remaining triangle, take the best one left
+                float bestScore = -1.0f;
+                for (; scanCursor < triangleCount && emitted[scanCursor]; scanCursor++) {}
+                for (uint32_t triangle = scanCursor; triangle < triangleCount; triangle++) {
+                    if (!emitted[triangle] && triangleScores[triangle] > bestScore) {
+                        bestScore = triangleScores[triangle];
+                        bestTriangle = triangle;
+                    }
+                }
+            }
+
+            emitted[bestTriangle] = true;
+            const uint32_t *corners = &indices[bestTriangle * 3];
+            output.insert(output.end(), corners, corners + 3);
+
+            // Remove the triangle from its vertices' adjacency
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                VertexState &vertex = vertices[corners[corner]];
+                uint32_t *list = &adjacency[vertex.firstTriangle];
+                std::swap(*std::find(list, list + vertex.remaining, bestTriangle), list[vertex.remaining - 1]);
+                vertex.remaining--;
+            }
+
+            // Move the triangle's vertices to the front of the cache
+            nextCache.assign(corners, corners + 3);
+            for (const uint32_t vertex : cache) {
+                if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                    nextCache.push_back(vertex);
+                }
+            }
+            // Rescore everything that moved, including vertices that just fell out, and the
+            // triangles around them
+            for (uint32_t position = 0; position < nextCache.size(); position++) {
+                VertexState &state = vertices[nextCache[position]];
+                state.cachePosition = position < kCacheSize ? position : kNotCached;
+                const float delta = vertexScore(state) - state.score;
+                state.score += delta;
+                for (uint32_t i = 0; i < state.remaining; i++) {
+                    triangleScores[adjacency[state.firstTriangle + i]] += delta;
+                }
+            }
+            if (nextCache.size() > kCacheSize) {
+                nextCache.resize(kCacheSize);
+            }
+            std::swap(cache, nextCache);
+
+            bestTriangle = kNotCached;
+            float bestScore = -1.0f;
+            for (const uint32_t vertex : cache) {
+                const VertexState &state = vertices[vertex];
+                for (uint32_t i = 0; i < state.remaining; i++) {
+                    const uint32_t triangle = adjacency[state.firstTriangle + i];
+                    if (triangleScores[triangle] > bestScore) {
+                        bestScore = triangleScores[triangle];
+                        bestTriangle = triangle;
+                    }
+                }
+            }
+        }
+
+        indices = std::move(output);
+    }
+
+    std::vector<uint32_t> VertexCacheOptimizer::optimizeFetch(std::vector<uint32_t> &indices, uint32_t vertexCount) {
+        std::vector<uint32_t> remap(vertexCount, kNotCached);
+        std::vector<uint32_t> newToOld;
+        newToOld.reserve(vertexCount);
+
+        for (uint32_t &index : indices) {
+            if (remap[index] == kNotCached) {
+                remap[index] = static_cast<uint32_t>(newToOld.size());
+                newToOld.push_back(index);
+            }
+            index = remap[index];
+        }
+        return newToOld;
+    }
+
+    float VertexCacheOptimizer::averageCacheMissRatio(const std::vector<uint32_t> &indices, uint32_t vertexCount,
+                                                      uint32_t cacheSize) {
+        if (indices.size() < 3) {
+            return 0.0f;
+        }
+
+        // FIFO like most hardware, a vertex is in the cache while its insertion stamp is recent enough
+        std::vector<uint64_t> insertedAt(vertexCount, 0);
+        uint64_t clock = cacheSize + 1;
+        uint64_t misses = 0;
+        for (const uint32_t index : indices) {
+            if (clock - insertedAt[index] > cacheSize) {
+                insertedAt[index] = clock++;
+                misses++;
+            }
+        }
+        return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    }
+}
@@ -0,0 +1,52 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef VERTEXCACHEOPTIMIZER_H
+#define VERTEXCACHEOPTIMIZER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Trin::Runtime::Asset {
+/**
+ * Offline triangle and vertex reordering for the post transform cache.
+ *
+ * Triangles are reordered with Forsyth's linear speed algorithm: each vertex is scored by
+ * its position in a simulated LRU cache and by how many triangles still use it, and the
+ * best scoring triangle touching the cache is emitted next. Vertices are then renumbered
+ * in first use order so vertex fetch walks memory forward as well.
+ */
+class VertexCacheOptimizer {
+public:
+    static constexpr uint32_t kCacheSize = 32;
+
+    /**
+     * @brief Reorders a triangle list in place for better vertex reuse
+     * @param indices Triangle list, three indices per triangle
+     * @param vertexCount Number of vertices the indices refer to
+     */
+    static void optimizeTriangles(std::vector<uint32_t> &indices, uint32_t vertexCount);
+
+    /**
+     * @brief Renumbers vertices in the order the index buffer first uses them
+     * @param indices Triangle list, rewritten to the new numbering
+     * @param vertexCount Number of vertices the indices refer to
+     * @return For every new vertex the old vertex it came from, unused vertices are dropped
+     */
+    static std::vector<uint32_t> optimizeFetch(std::vector<uint32_t> &indices, uint32_t vertexCount);
+
+    /**
+     * @brief Average cache misses per triangle for a FIFO cache
+     * @param indices Triangle list
+     * @param vertexCount Number of vertices the indices refer to
+     * @param cacheSize Entries in the simulated cache
+     * @return 3.0 is the worst case, 0.5 is the best a regular grid can reach
+     */
+    static float averageCacheMissRatio(const std::vector<uint32_t> &indices, uint32_t vertexCount,
+                                       uint32_t cacheSize = 16);
+};
+
+}
+
+#endif //VERTEXCACHEOPTIMIZER_H
@@ -4,28 +4,140 @@
 
 #include "Engine.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "StartupGraph.h"
+#include "Helpers/Console.h"
+#include "Helpers/MappedFile.h"
+
 namespace Trin::Runtime::Core {
-    Engine::Engine() {}
+    Engine::Engine(EngineCreateInfo info): m_createInfo(std::move(info)) {}
 
     bool Engine::init() {
-        if (!glfwInit()) {
-            std::cerr << "Failed to initialize GLFW" << std::endl;
-            return false;
-        }
-        WindowCreateInfo createWindowInfo{};
-        createWindowInfo.size = Vector2(800, 600);
-        createWindowInfo.title = "TrinVK Engine";
+        m_initStart = std::chrono::steady_clock::now();
+        m_firstFrame = true;
 
-        m_window = std::make_unique<Window>(createWindowInfo);
+        // Replays take their seed from the capture, live runs pick one and record it if capturing
+        if (!m_createInfo.replayPath.empty()) {
+            if (!m_replay.open(m_createInfo.replayPath)) {
+                return false;
+            }
+            m_seed = m_replay.getSeed();
+        } else {
+            if (m_createInfo.headless) {
+                Helpers::Console::error("Headless runs have no input, they need a capture to replay");
+                return false;
+            }
+            std::random_device device;
+            m_seed = (static_cast<uint64_t>(device()) << 32) | device();
+            if (!m_createInfo.capturePath.empty() && !m_capture.open(m_createInfo.capturePath, m_seed)) {
+                return false;
+            }
+        }
 
         VulkanCreateInfo createInfo{};
         createInfo.applicationVersion = VK_MAKE_API_VERSION(0, 0, 0, 1);
         createInfo.applicationName = "TrinVK Engine";
         createInfo.enableValidationLayers = true;
-        createInfo.window = m_window;
-
+        createInfo.deferredWindow = !m_createInfo.headless;
         m_context = std::make_shared<VulkanContext>();
-        m_context->init(createInfo);
+
+        // GLFW calls stay on the main thread, everything else runs wherever there is room.
+        // Device scoring overlaps window creation, file reads overlap all of the Vulkan setup.
+        StartupGraph graph;
+        // Headless runs keep the same graph, the window tasks just have nothing to do
+        const StartupTask glfw = graph.add("glfw", [this] {
+            if (m_createInfo.headless) {
+                return true;
+            }
+            if (!glfwInit()) {
+                std::cerr << "Failed to initialize GLFW" << std::endl;
+                return false;
+            }
+            return true;
+        }, {}, StartupAffinity::MainThread);
+
+        const StartupTask window = graph.add("window", [this] {
+            if (m_createInfo.headless) {
+                return true;
+            }
+            WindowCreateInfo createWindowInfo{};
+            createWindowInfo.size = Vector2(800, 600);
+            createWindowInfo.title = "TrinVK Engine";
+            m_window = std::make_shared<Window>(createWindowInfo);
+            // A replay ignores live input, the window only has to stay responsive
+            if (!m_replay.isOpen()) {
+                m_inputQueue.attach(m_window->GetWindow());
+            }
+            return true;
+        }, {glfw}, StartupAffinity::MainThread);
+
+        // The instance only needs the extension list, not the window itself
+        const StartupTask instance = graph.add("vulkan_instance", [this, &createInfo] {
+            return m_context->createInstance(createInfo);
+        }, {glfw});
+
+        const StartupTask scoring = graph.add("device_scoring", [this, &createInfo] {
+            return m_context->scoreDevices(createInfo, &JobSystem::get());
+        }, {instance});
+
+        const StartupTask surface = graph.add("surface", [this, &createInfo] {
+            VulkanCreateInfo surfaceInfo = createInfo;
+            surfaceInfo.window = m_window;
+            return m_context->createSurface(surfaceInfo);
+        }, {window, instance}, StartupAffinity::MainThread);
+
+        const StartupTask device = graph.add("logical_device", [this] {
+            return m_context->pickPhysicalDevice() && m_context->createLogicalDevice();
+        }, {scoring, surface});
+
+        const StartupTask cacheRead = graph.add("pipeline_cache_read", [this] {
+            Helpers::MappedFile file;
+            if (file.open(kPipelineCachePath)) {
+                m_pipelineCacheData.assign(file.data(), file.data() + file.size());
+            }
+            return true;
+        });
+
+        graph.add("pipeline_cache", [this] {
+            const bool created = m_context->createPipelineCache(m_pipelineCacheData);
+            m_pipelineCacheData.clear();
+            m_pipelineCacheData.shrink_to_fit();
+            return created;
+        }, {device, cacheRead});
+
+        graph.add("asset_mount", [this] {
+            if (!std::filesystem::is_directory(kAssetRoot)) {
+                Helpers::Console::warn(std::string("No asset directory at ") + kAssetRoot);
+                return true;
+            }
+            return m_assets.mount(kAssetRoot);
+        });
+
+        // Nothing depends on telemetry, the engine runs the same when the segment can't be created
+        graph.add("telemetry", [this] {
+            m_telemetry.frames = Telemetry::counter("frame.count");
+            m_telemetry.frameTimeUs = Telemetry::histogram("frame.time_us");
+            m_telemetry.frameArenaBytes = Telemetry::gauge("memory.frame_arena_bytes");
+            m_telemetry.pendingJobs = Telemetry::gauge("jobs.pending");
+            for (size_t i = 0; i < static_cast<size_t>(Memory::MemoryTag::Count); i++) {
+                const std::string name = std::string("memory.") +
+                                         Memory::MemoryTracker::tagName(static_cast<Memory::MemoryTag>(i)) + ".live_bytes";
+                m_telemetry.liveBytes[i] = Telemetry::gauge(name.c_str());
+            }
+            Telemetry::open();
+            return true;
+        });
+
+        const bool succeeded = graph.run();
+        graph.printBreakdown();
+        if (!succeeded) {
+            std::cerr << "Failed to initialize Vulkan" << std::endl;
+            return false;
+        }
 
         return true;
     }
@@ -37,24 +149,127 @@ namespace Trin::Runtime::Core {
     }
 
     void Engine::mainLoop() {
+        auto previousStart = std::chrono::steady_clock::now();
         while (m_running) {
-            if (glfwWindowShouldClose(m_window->GetWindow())) {
-                m_running = false;
+            const auto frameStart = std::chrono::steady_clock::now();
+            if (!beginFrame(frameStart - previousStart)) {
+                break;
             }
-            glfwPollEvents();
+            previousStart = frameStart;
 
-            if (glfwGetKey(m_window->GetWindow(), GLFW_KEY_ESCAPE)) {
-                glfwSetWindowShouldClose(m_window->GetWindow(), true);
+            // Decided from the events alone, so a replay stops on the frame the capture did
+            if (m_input.isCloseRequested() || m_input.isKeyDown(GLFW_KEY_ESCAPE)) {
+                m_running = false;
             }
 
             // Render here..
 
-            glfwSwapBuffers(m_window->GetWindow());
+            if (m_window) {
+                glfwSwapBuffers(m_window->GetWindow());
+            }
+
+            if (m_firstFrame) {
+                m_firstFrame = false;
+                const double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - m_initStart).count();
+                Helpers::Console::print("Time to first frame: " + std::to_string(ms) + " ms");
+            }
+
+            const auto frameUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - frameStart).count());
+            if (m_replay.isOpen()) {
+                m_replayFrames.push_back({m_frameInput.deltaUs, static_cast<uint32_t>(std::min<uint64_t>(frameUs, UINT32_MAX))});
+            }
+            publishTelemetry(frameUs);
+            m_frameArena.reset();
+            m_frameIndex++;
         }
         std::cout << "done" << std::endl;
     }
 
+    bool Engine::beginFrame(std::chrono::steady_clock::duration elapsed) {
+        if (m_window) {
+            glfwPollEvents();
+        }
+
+        if (m_replay.isOpen()) {
+            if (m_window && glfwWindowShouldClose(m_window->GetWindow())) {
+                return false;
+            }
+            if (!m_replay.next(m_frameInput)) {
+                Helpers::Console::print("Replay finished after " + std::to_string(m_replay.getFrameIndex()) + " frames");
+                return false;
+            }
+        } else {
+            m_inputQueue.drain(m_frameInput.events);
+            const auto deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            m_frameInput.deltaUs = static_cast<uint32_t>(std::clamp<int64_t>(deltaUs, 0, UINT32_MAX));
+            if (m_capture.isOpen()) {
+                m_capture.write(m_frameInput);
+            }
+        }
+
+        m_input.beginFrame();
+        for (const InputEvent &event : m_frameInput.events) {
+            m_input.apply(event);
+        }
+        m_random.reseed(m_seed ^ Math::Random::mix(m_frameIndex));
+        return true;
+    }
+
+    void Engine::reportReplay() const {
+        if (m_replayFrames.empty()) {
+            return;
+        }
+
+        std::vector<uint32_t> sorted(m_replayFrames.size());
+        uint64_t total = 0;
+        for (size_t i = 0; i < m_replayFrames.size(); i++) {
+            sorted[i] = m_replayFrames[i].cpuUs;
+            total += sorted[i];
+        }
+        std::sort(sorted.begin(), sorted.end());
+        const auto percentile = [&](double q) {
+            return std::to_string(sorted[static_cast<size_t>(q * static_cast<double>(sorted.size() - 1))]);
+        };
+        Helpers::Console::print("Replay frame time (us): mean " + std::to_string(total / sorted.size()) +
+                                ", p50 " + percentile(0.5) + ", p95 " + percentile(0.95) +
+                                ", p99 " + percentile(0.99) + ", max " + std::to_string(sorted.back()));
+
+        if (m_createInfo.timingsPath.empty()) {
+            return;
+        }
+        std::ofstream out(m_createInfo.timingsPath, std::ios::trunc);
+        if (!out) {
+            Helpers::Console::error("Could not write replay timings to " + m_createInfo.timingsPath);
+            return;
+        }
+        out << "frame,recorded_us,cpu_us\n";
+        for (size_t i = 0; i < m_replayFrames.size(); i++) {
+            out << i << ',' << m_replayFrames[i].recordedUs << ',' << m_replayFrames[i].cpuUs << '\n';
+        }
+        Helpers::Console::print("Replay timings written to " + m_createInfo.timingsPath);
+    }
+
+    void Engine::publishTelemetry(uint64_t frameUs) {
+        Telemetry::add(m_telemetry.frames);
+        Telemetry::record(m_telemetry.frameTimeUs, frameUs);
+        Telemetry::set(m_telemetry.frameArenaBytes, m_frameArena.getUsed());
+        Telemetry::set(m_telemetry.pendingJobs, JobSystem::get().getPendingJobCount());
+        for (size_t i = 0; i < static_cast<size_t>(Memory::MemoryTag::Count); i++) {
+            Telemetry::set(m_telemetry.liveBytes[i], Memory::MemoryTracker::get(static_cast<Memory::MemoryTag>(i)).liveBytes);
+        }
+        Telemetry::publish(m_frameIndex);
+    }
+
     bool Engine::shutdown() {
+        m_inputQueue.detach();
+        m_capture.close();
+        reportReplay();
+        if (m_context) {
+            m_context->savePipelineCache(kPipelineCachePath);
+        }
+        Telemetry::close();
         return true;
     }
 }
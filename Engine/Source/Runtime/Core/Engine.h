@@ -5,37 +5,147 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include "FrameCapture.h"
+#include "Input.h"
+#include "Telemetry.h"
 #include "Window.h"
 #include "VulkanContext.h"
+#include "Asset/AssetRegistry.h"
+#include "Memory/FrameArena.h"
+#include "Memory/MemoryTracker.h"
+#include "Math/Random.h"
 
 namespace Trin::Runtime::Core {
     struct RenderWorker {
-        CommandBuffer commandBuffer;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
         std::atomic_bool completed = false;
     };
+
+    struct EngineCreateInfo {
+        bool headless = false;          // No GLFW and no window, only valid when replaying
+        std::string capturePath;        // Records every frame's input, delta time and seed here
+        std::string replayPath;         // Plays a capture back instead of live input and wall clock time
+        std::string timingsPath;        // Per frame CPU times of a replay as CSV, for diffing two builds
+    };
 class Engine {
 public:
-    Engine();
+    explicit Engine(EngineCreateInfo info = {});
     bool init();
     bool run();
     void mainLoop();
     bool shutdown();
+
+    /// Scratch memory for the current frame, everything in it is released when the frame ends
+    [[nodiscard]] Memory::FrameArena &getFrameArena() {
+        return m_frameArena;
+    }
+
+    [[nodiscard]] const Asset::AssetRegistry &getAssets() const {
+        return m_assets;
+    }
+
+    [[nodiscard]] const InputState &getInput() const {
+        return m_input;
+    }
+
+    /// Seconds since the previous frame, the recorded value when replaying
+    [[nodiscard]] double getDeltaTime() const {
+        return static_cast<double>(m_frameInput.deltaUs) * 1e-6;
+    }
+
+    [[nodiscard]] uint64_t getFrameIndex() const {
+        return m_frameIndex;
+    }
+
+    /// Reseeded every frame from the run's seed, draws from it repeat exactly in a replay
+    [[nodiscard]] Math::Random &getRandom() {
+        return m_random;
+    }
 private:
     // ==============
     //     VULKAN
     // ==============
 
     std::shared_ptr<VulkanContext> m_context;
+    std::vector<std::byte> m_pipelineCacheData;     // Read during startup, dropped once the cache exists
+
+    static constexpr const char *kPipelineCachePath = "Cache/pipeline.cache";
 
     // ==============
     //      MAIN
     // ==============
 
+    EngineCreateInfo m_createInfo;
     bool m_running = true;
+    bool m_firstFrame = true;
+    std::chrono::steady_clock::time_point m_initStart;
+
+    // ==============
+    //     INPUT
+    // ==============
+
+    /// Gathers the frame's input and delta time, live or from the replay. False ends the run.
+    bool beginFrame(std::chrono::steady_clock::duration elapsed);
+
+    InputQueue m_inputQueue;
+    InputState m_input;
+    CapturedFrame m_frameInput;
+    uint64_t m_seed = 0;
+    Math::Random m_random;
+
+    // ==============
+    //    CAPTURE
+    // ==============
+
+    struct ReplayFrame {
+        uint32_t recordedUs;    // Delta time the capture recorded
+        uint32_t cpuUs;         // What the frame cost in this run
+    };
+
+    void reportReplay() const;
+
+    FrameCaptureWriter m_capture;
+    FrameCaptureReader m_replay;
+    std::vector<ReplayFrame> m_replayFrames;
+
+    // ==============
+    //     MEMORY
+    // ==============
+
+    Memory::FrameArena m_frameArena;
+
+    // ==============
+    //   TELEMETRY
+    // ==============
+
+    struct FrameTelemetry {
+        TelemetryCounter frames;
+        TelemetryHistogram frameTimeUs;
+        TelemetryGauge frameArenaBytes;
+        TelemetryGauge pendingJobs;
+        TelemetryGauge liveBytes[static_cast<size_t>(Memory::MemoryTag::Count)];
+    };
+
+    void publishTelemetry(uint64_t frameUs);
+
+    FrameTelemetry m_telemetry;
+    uint64_t m_frameIndex = 0;
+
+    // ==============
+    //     ASSETS
+    // ==============
+
+    Asset::AssetRegistry m_assets;
+
+    static constexpr const char *kAssetRoot = "Assets";
 
     // ==============
     //     WINDOW
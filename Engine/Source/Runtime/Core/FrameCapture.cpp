@@ -0,0 +1,224 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "FrameCapture.h"
+
+#include <cstring>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Core {
+    namespace {
+        void writeVarint(std::vector<uint8_t> &out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        void writeFloat(std::vector<uint8_t> &out, float value) {
+            uint8_t bytes[sizeof(float)];
+            std::memcpy(bytes, &value, sizeof(float));
+            out.insert(out.end(), std::begin(bytes), std::end(bytes));
+        }
+
+        /// Bounds checked cursor over a frame, every read fails once the data runs out
+        struct ByteReader {
+            const uint8_t *data;
+            size_t size;
+            size_t offset;
+
+            bool varint(uint64_t &value) {
+                value = 0;
+                for (uint32_t shift = 0; shift < 64; shift += 7) {
+                    if (offset == size) {
+                        return false;
+                    }
+                    const uint8_t byte = data[offset++];
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool byte(uint8_t &value) {
+                if (offset == size) {
+                    return false;
+                }
+                value = data[offset++];
+                return true;
+            }
+
+            bool real(float &value) {
+                if (size - offset < sizeof(float)) {
+                    return false;
+                }
+                std::memcpy(&value, data + offset, sizeof(float));
+                offset += sizeof(float);
+                return true;
+            }
+        };
+    }
+
+    // ==============
+    //     WRITER
+    // ==============
+
+    FrameCaptureWriter::~FrameCaptureWriter() {
+        close();
+    }
+
+    bool FrameCaptureWriter::open(const std::string &path, uint64_t seed) {
+        close();
+        m_stream.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_stream) {
+            Helpers::Console::error("Could not create frame capture " + path);
+            return false;
+        }
+
+        CaptureFileHeader header{};
+        header.magic = CaptureFormat::kMagic;
+        header.version = CaptureFormat::kVersion;
+        header.seed = seed;
+        m_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        m_path = path;
+        m_frameCount = 0;
+        return true;
+    }
+
+    void FrameCaptureWriter::write(const CapturedFrame &frame) {
+        writeVarint(m_buffer, frame.deltaUs);
+        writeVarint(m_buffer, frame.events.size());
+        for (const InputEvent &event : frame.events) {
+            m_buffer.push_back(static_cast<uint8_t>(event.type));
+            switch (event.type) {
+                case InputEventType::Key:
+                case InputEventType::MouseButton:
+                    // Zigzag, GLFW_KEY_UNKNOWN is -1
+                    writeVarint(m_buffer, (static_cast<uint32_t>(event.code) << 1) ^ static_cast<uint32_t>(event.code >> 31));
+                    m_buffer.push_back(event.action);
+                    writeVarint(m_buffer, event.mods);
+                    break;
+                case InputEventType::Char:
+                    writeVarint(m_buffer, static_cast<uint32_t>(event.code));
+                    break;
+                case InputEventType::Cursor:
+                case InputEventType::Scroll:
+                    writeFloat(m_buffer, event.x);
+                    writeFloat(m_buffer, event.y);
+                    break;
+                case InputEventType::Close:
+                case InputEventType::Count:
+                    break;
+            }
+        }
+
+        m_frameCount++;
+        // A few bytes a frame, so flushing each one costs nothing next to losing the frames before a crash
+        flush();
+    }
+
+    void FrameCaptureWriter::flush() {
+        m_stream.write(reinterpret_cast<const char *>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        m_stream.flush();
+        m_buffer.clear();
+    }
+
+    void FrameCaptureWriter::close() {
+        if (!m_stream.is_open()) {
+            return;
+        }
+        flush();
+        m_stream.close();
+        Helpers::Console::print("Captured " + std::to_string(m_frameCount) + " frames to " + m_path);
+    }
+
+    // ==============
+    //     READER
+    // ==============
+
+    bool FrameCaptureReader::open(const std::string &path) {
+        close();
+        if (!m_file.open(path.c_str()) || m_file.size() < sizeof(CaptureFileHeader)) {
+            Helpers::Console::error("Could not open frame capture " + path);
+            m_file.close();
+            return false;
+        }
+
+        CaptureFileHeader header{};
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        if (header.magic != CaptureFormat::kMagic || header.version != CaptureFormat::kVersion) {
+            Helpers::Console::error(path + " is not a frame capture this build can replay");
+            m_file.close();
+            return false;
+        }
+        m_seed = header.seed;
+        m_offset = sizeof(header);
+        m_frameIndex = 0;
+        return true;
+    }
+
+    bool FrameCaptureReader::next(CapturedFrame &frame) {
+        if (!m_file.isOpen() || m_offset == m_file.size()) {
+            return false;
+        }
+
+        ByteReader reader{reinterpret_cast<const uint8_t *>(m_file.data()), m_file.size(), m_offset};
+        uint64_t deltaUs = 0;
+        uint64_t eventCount = 0;
+        bool valid = reader.varint(deltaUs) && reader.varint(eventCount) && deltaUs <= UINT32_MAX;
+        frame.deltaUs = static_cast<uint32_t>(deltaUs);
+        frame.events.clear();
+        for (uint64_t i = 0; valid && i < eventCount; i++) {
+            InputEvent event{};
+            uint8_t type = 0;
+            valid = reader.byte(type) && type < static_cast<uint8_t>(InputEventType::Count);
+            if (!valid) {
+                break;
+            }
+            event.type = static_cast<InputEventType>(type);
+            uint64_t code = 0;
+            uint64_t mods = 0;
+            switch (event.type) {
+                case InputEventType::Key:
+                case InputEventType::MouseButton:
+                    valid = reader.varint(code) && reader.byte(event.action) && reader.varint(mods);
+                    event.code = static_cast<int32_t>(static_cast<uint32_t>(code >> 1) ^ (0u - static_cast<uint32_t>(code & 1)));
+                    event.mods = static_cast<uint16_t>(mods);
+                    break;
+                case InputEventType::Char:
+                    valid = reader.varint(code);
+                    event.code = static_cast<int32_t>(code);
+                    break;
+                case InputEventType::Cursor:
+                case InputEventType::Scroll:
+                    valid = reader.real(event.x) && reader.real(event.y);
+                    break;
+                case InputEventType::Close:
+                case InputEventType::Count:
+                    break;
+            }
+            frame.events.push_back(event);
+        }
+
+        if (!valid) {
+            Helpers::Console::warn("Frame capture ends partway through frame " + std::to_string(m_frameIndex) +
+                                   ", replaying what came before it");
+            m_offset = m_file.size();
+            return false;
+        }
+        m_offset = reader.offset;
+        m_frameIndex++;
+        return true;
+    }
+
+    void FrameCaptureReader::close() {
+        m_file.close();
+        m_offset = 0;
+        m_frameIndex = 0;
+    }
+}
@@ -0,0 +1,91 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Input.h"
+#include "Helpers/MappedFile.h"
+
+namespace Trin::Runtime::Core {
+/**
+ * Frame capture file (.tcap) layout.
+ *
+ * | CaptureFileHeader | frame | frame | ...
+ *
+ * Frames are LEB128 varints: the frame's delta time in microseconds, the event count, then
+ * every event as its type byte followed by its fields. Cursor and scroll values are stored
+ * as raw floats so a replay is bit exact. A 60Hz frame without input takes four bytes.
+ *
+ * Every frame is flushed to the file as it finishes, a capture cut short by a crash still
+ * replays up to its last complete frame.
+ */
+struct CaptureFormat {
+    static constexpr uint32_t kMagic = 0x50414354;  // "TCAP"
+    static constexpr uint32_t kVersion = 1;
+};
+
+struct CaptureFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;      // Every frame's random seed derives from this and the frame index
+};
+
+/// Everything a frame took from the outside world
+struct CapturedFrame {
+    uint32_t deltaUs = 0;
+    std::vector<InputEvent> events;
+};
+
+class FrameCaptureWriter {
+public:
+    ~FrameCaptureWriter();
+
+    bool open(const std::string &path, uint64_t seed);
+
+    /// Encodes the frame and hands it to the OS straight away, one small write per frame
+    void write(const CapturedFrame &frame);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_stream.is_open(); }
+    [[nodiscard]] uint64_t getFrameCount() const { return m_frameCount; }
+
+private:
+    void flush();
+
+    std::ofstream m_stream;
+    std::vector<uint8_t> m_buffer;
+    uint64_t m_frameCount = 0;
+    std::string m_path;
+};
+
+class FrameCaptureReader {
+public:
+    bool open(const std::string &path);
+
+    /// Decodes the next frame into frame, reusing its event storage. False once the capture ends.
+    bool next(CapturedFrame &frame);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_file.isOpen(); }
+    [[nodiscard]] uint64_t getSeed() const { return m_seed; }
+    [[nodiscard]] uint64_t getFrameIndex() const { return m_frameIndex; }
+
+private:
+    Helpers::MappedFile m_file;
+    size_t m_offset = 0;
+    uint64_t m_seed = 0;
+    uint64_t m_frameIndex = 0;
+};
+
+}
+
+#endif //FRAMECAPTURE_H
@@ -0,0 +1,108 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "Input.h"
+
+#include "Window.h"
+
+namespace Trin::Runtime::Core {
+    static_assert(InputState::kKeyCount == GLFW_KEY_LAST + 1);
+    static_assert(InputState::kButtonCount == GLFW_MOUSE_BUTTON_LAST + 1);
+
+    void InputState::beginFrame() {
+        m_pressed.reset();
+        m_scrollX = 0.0f;
+        m_scrollY = 0.0f;
+    }
+
+    void InputState::apply(const InputEvent &event) {
+        switch (event.type) {
+            case InputEventType::Key:
+                if (event.code < 0 || event.code >= kKeyCount) {
+                    break;
+                }
+                if (event.action == GLFW_PRESS) {
+                    m_pressed.set(event.code);
+                }
+                m_keys.set(event.code, event.action != GLFW_RELEASE);
+                break;
+            case InputEventType::MouseButton:
+                if (event.code < 0 || event.code >= kButtonCount) {
+                    break;
+                }
+                if (event.action == GLFW_RELEASE) {
+                    m_buttons &= static_cast<uint8_t>(~(1u << event.code));
+                } else {
+                    m_buttons |= static_cast<uint8_t>(1u << event.code);
+                }
+                break;
+            case InputEventType::Cursor:
+                m_cursorX = event.x;
+                m_cursorY = event.y;
+                break;
+            case InputEventType::Scroll:
+                m_scrollX += event.x;
+                m_scrollY += event.y;
+                break;
+            case InputEventType::Close:
+                m_closeRequested = true;
+                break;
+            case InputEventType::Char:
+            case InputEventType::Count:
+                break;
+        }
+    }
+
+    void InputQueue::attach(GLFWwindow *window) {
+        detach();
+        m_window = window;
+        glfwSetWindowUserPointer(window, this);
+
+        glfwSetKeyCallback(window, [](GLFWwindow *source, int key, int, int action, int mods) {
+            push(source, {InputEventType::Key, static_cast<uint8_t>(action), static_cast<uint16_t>(mods), key});
+        });
+        glfwSetMouseButtonCallback(window, [](GLFWwindow *source, int button, int action, int mods) {
+            push(source, {InputEventType::MouseButton, static_cast<uint8_t>(action), static_cast<uint16_t>(mods), button});
+        });
+        glfwSetCursorPosCallback(window, [](GLFWwindow *source, double x, double y) {
+            // Narrowed here rather than when written, so live runs see the values a replay will
+            push(source, {InputEventType::Cursor, 0, 0, 0, static_cast<float>(x), static_cast<float>(y)});
+        });
+        glfwSetScrollCallback(window, [](GLFWwindow *source, double x, double y) {
+            push(source, {InputEventType::Scroll, 0, 0, 0, static_cast<float>(x), static_cast<float>(y)});
+        });
+        glfwSetCharCallback(window, [](GLFWwindow *source, unsigned int codepoint) {
+            push(source, {InputEventType::Char, 0, 0, static_cast<int32_t>(codepoint)});
+        });
+        glfwSetWindowCloseCallback(window, [](GLFWwindow *source) {
+            push(source, {InputEventType::Close});
+        });
+    }
+
+    void InputQueue::detach() {
+        if (!m_window) {
+            return;
+        }
+        glfwSetKeyCallback(m_window, nullptr);
+        glfwSetMouseButtonCallback(m_window, nullptr);
+        glfwSetCursorPosCallback(m_window, nullptr);
+        glfwSetScrollCallback(m_window, nullptr);
+        glfwSetCharCallback(m_window, nullptr);
+        glfwSetWindowCloseCallback(m_window, nullptr);
+        glfwSetWindowUserPointer(m_window, nullptr);
+        m_window = nullptr;
+        m_events.clear();
+    }
+
+    void InputQueue::drain(std::vector<InputEvent> &events) {
+        events.clear();
+        std::swap(events, m_events);
+    }
+
+    void InputQueue::push(GLFWwindow *window, const InputEvent &event) {
+        if (auto *queue = static_cast<InputQueue *>(glfwGetWindowUserPointer(window))) {
+            queue->m_events.push_back(event);
+        }
+    }
+}
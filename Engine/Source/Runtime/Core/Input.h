@@ -0,0 +1,101 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+struct GLFWwindow;
+
+namespace Trin::Runtime::Core {
+    enum class InputEventType : uint8_t {
+        Key,
+        MouseButton,
+        Cursor,
+        Scroll,
+        Char,
+        Close,
+        Count
+    };
+
+    /// One GLFW callback, key and button codes keep GLFW's values
+    struct InputEvent {
+        InputEventType type = InputEventType::Key;
+        uint8_t action = 0;     // GLFW_RELEASE, GLFW_PRESS or GLFW_REPEAT
+        uint16_t mods = 0;
+        int32_t code = 0;       // Key, mouse button or codepoint
+        float x = 0.0f;         // Cursor position or scroll offset
+        float y = 0.0f;
+    };
+
+/**
+ * Input as the game sees it, built only from events.
+ *
+ * Live runs feed it what InputQueue collected from GLFW, replays feed it what a capture
+ * recorded, so both end up in exactly the same state.
+ */
+class InputState {
+public:
+    static constexpr int32_t kKeyCount = 349;       // GLFW_KEY_LAST + 1
+    static constexpr int32_t kButtonCount = 8;      // GLFW_MOUSE_BUTTON_LAST + 1
+
+    /// Clears this frame's presses and scrolling, held keys stay down
+    void beginFrame();
+    void apply(const InputEvent &event);
+
+    [[nodiscard]] bool isKeyDown(int32_t key) const {
+        return key >= 0 && key < kKeyCount && m_keys[key];
+    }
+
+    /// Went down during this frame
+    [[nodiscard]] bool wasKeyPressed(int32_t key) const {
+        return key >= 0 && key < kKeyCount && m_pressed[key];
+    }
+
+    [[nodiscard]] bool isButtonDown(int32_t button) const {
+        return button >= 0 && button < kButtonCount && (m_buttons >> button) & 1u;
+    }
+
+    [[nodiscard]] float getCursorX() const { return m_cursorX; }
+    [[nodiscard]] float getCursorY() const { return m_cursorY; }
+    [[nodiscard]] float getScrollX() const { return m_scrollX; }
+    [[nodiscard]] float getScrollY() const { return m_scrollY; }
+    [[nodiscard]] bool isCloseRequested() const { return m_closeRequested; }
+
+private:
+    std::bitset<kKeyCount> m_keys;
+    std::bitset<kKeyCount> m_pressed;
+    uint8_t m_buttons = 0;
+    float m_cursorX = 0.0f;
+    float m_cursorY = 0.0f;
+    float m_scrollX = 0.0f;
+    float m_scrollY = 0.0f;
+    bool m_closeRequested = false;
+};
+
+/// Collects a window's GLFW callbacks in the order they fired
+class InputQueue {
+public:
+    /// Installs the callbacks, the window's user pointer is taken for the queue
+    void attach(GLFWwindow *window);
+
+    /// Removes the callbacks, call before the window is destroyed
+    void detach();
+
+    /// Replaces events with everything received since the last call, call after glfwPollEvents
+    void drain(std::vector<InputEvent> &events);
+
+private:
+    static void push(GLFWwindow *window, const InputEvent &event);
+
+    GLFWwindow *m_window = nullptr;
+    std::vector<InputEvent> m_events;
+};
+
+}
+
+#endif //INPUT_H
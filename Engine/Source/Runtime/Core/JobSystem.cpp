@@ -0,0 +1,157 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Telemetry.h"
+
+namespace Trin::Runtime::Core {
+    namespace {
+        void countExecutedJob() {
+            static const TelemetryCounter executed = Telemetry::counter("jobs.executed");
+            Telemetry::add(executed);
+        }
+
+        struct ParallelBatch {
+            const std::function<void(uint32_t, uint32_t)> *fn = nullptr;
+            uint32_t count = 0;
+            uint32_t chunkSize = 0;
+            uint32_t chunkCount = 0;
+            std::atomic<uint32_t> nextChunk{0};
+            std::atomic<uint32_t> finishedChunks{0};
+
+            // Returns once there are no chunks left to claim
+            void drain() {
+                for (;;) {
+                    const uint32_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                    if (chunk >= chunkCount) {
+                        return;
+                    }
+                    const uint32_t begin = chunk * chunkSize;
+                    const uint32_t end = std::min(begin + chunkSize, count);
+                    (*fn)(begin, end);
+                    finishedChunks.fetch_add(1, std::memory_order_release);
+                }
+            }
+        };
+    }
+
+    JobSystem::JobSystem(uint32_t workerCount) {
+        if (workerCount == 0) {
+            const uint32_t hardware = std::thread::hardware_concurrency();
+            workerCount = hardware > 1 ? hardware - 1 : 0;
+        }
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; i++) {
+            m_workers.emplace_back(&JobSystem::workerLoop, this);
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    JobSystem &JobSystem::get() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    void JobSystem::submit(std::function<void()> job) {
+        if (m_workers.empty()) {
+            job();
+            return;
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+
+    void JobSystem::parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)> &fn) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max(grain, 1u);
+
+        // Not worth waking anybody up for a single chunk
+        if (m_workers.empty() || count <= grain) {
+            fn(0, count);
+            return;
+        }
+
+        const auto batch = std::make_shared<ParallelBatch>();
+        batch->fn = &fn;
+        batch->count = count;
+        // A few chunks per thread keeps uneven work balanced without drowning in atomics
+        const uint32_t targetChunks = getThreadCount() * 4;
+        batch->chunkSize = std::max(grain, (count + targetChunks - 1) / targetChunks);
+        batch->chunkCount = (count + batch->chunkSize - 1) / batch->chunkSize;
+
+        const uint32_t helpers = std::min(static_cast<uint32_t>(m_workers.size()), batch->chunkCount - 1);
+        {
+            std::lock_guard lock(m_mutex);
+            for (uint32_t i = 0; i < helpers; i++) {
+                m_jobs.emplace_back([batch] { batch->drain(); });
+            }
+        }
+        m_condition.notify_all();
+
+        batch->drain();
+
+        // Help out with anything else that is queued while the stragglers finish
+        while (batch->finishedChunks.load(std::memory_order_acquire) < batch->chunkCount) {
+            if (!runPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool JobSystem::runPendingJob() {
+        std::function<void()> job;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_jobs.empty()) {
+                return false;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+        countExecutedJob();
+        return true;
+    }
+
+    uint32_t JobSystem::getPendingJobCount() {
+        std::lock_guard lock(m_mutex);
+        return static_cast<uint32_t>(m_jobs.size());
+    }
+
+    void JobSystem::workerLoop() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+                if (m_stopping && m_jobs.empty()) {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+            countExecutedJob();
+        }
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Trin::Runtime::Core {
+class JobSystem {
+public:
+    /**
+     * @brief Spins up the worker threads
+     * @param workerCount Number of background workers, 0 picks one less than the hardware thread count
+     */
+    explicit JobSystem(uint32_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /// Shared pool used by engine systems that are not handed one explicitly
+    static JobSystem &get();
+
+    /// Number of threads that take part in a parallelFor, the caller included
+    [[nodiscard]] uint32_t getThreadCount() const {
+        return static_cast<uint32_t>(m_workers.size()) + 1;
+    }
+
+    /**
+     * @brief Queues a job to run on a worker thread
+     * @param job The work to run, must not throw
+     */
+    void submit(std::function<void()> job);
+
+    /**
+     * @brief Splits [0, count) into chunks and runs them across the workers, blocking until all are done
+     * @param count Number of items to process
+     * @param grain Smallest chunk handed to a single thread
+     * @param fn Called with a half open [begin, end) range
+     */
+    void parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)> &fn);
+
+    /// Runs one queued job on the calling thread, returns false when there was nothing to do
+    bool runPendingJob();
+
+    /// Jobs queued but not picked up yet
+    [[nodiscard]] uint32_t getPendingJobCount();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+};
+
+}
+
+#endif //JOBSYSTEM_H
@@ -0,0 +1,197 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "StartupGraph.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Core {
+    namespace {
+        double millisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        const char *statusName(StartupStatus status) {
+            switch (status) {
+                case StartupStatus::Succeeded: return "ok";
+                case StartupStatus::Failed: return "FAILED";
+                case StartupStatus::Skipped: return "skipped";
+                default: return "pending";
+            }
+        }
+    }
+
+    StartupTask StartupGraph::add(std::string name, std::function<bool()> fn,
+                                  std::initializer_list<StartupTask> dependencies, StartupAffinity affinity) {
+        const auto task = static_cast<StartupTask>(m_nodes.size());
+        Node &node = m_nodes.emplace_back();
+        node.fn = std::move(fn);
+        node.affinity = affinity;
+        node.dependencies.assign(dependencies.begin(), dependencies.end());
+        for (const StartupTask dependency : dependencies) {
+            m_nodes[dependency].dependents.push_back(task);
+        }
+
+        StartupTiming &timing = m_timings.emplace_back();
+        timing.name = std::move(name);
+        return task;
+    }
+
+    bool StartupGraph::run(JobSystem &jobs) {
+        m_start = std::chrono::steady_clock::now();
+        m_mainThread = std::this_thread::get_id();
+
+        std::vector<StartupTask> ready;
+        for (StartupTask task = 0; task < m_nodes.size(); task++) {
+            m_nodes[task].waitingOn = static_cast<uint32_t>(m_nodes[task].dependencies.size());
+            m_timings[task].status = StartupStatus::Pending;
+            if (m_nodes[task].waitingOn == 0) {
+                ready.push_back(task);
+            }
+        }
+
+        auto remaining = static_cast<uint32_t>(m_nodes.size());
+        std::vector<StartupTask> mainQueue;
+        std::vector<Completion> completed;
+        while (remaining > 0) {
+            for (const StartupTask task : ready) {
+                if (m_nodes[task].affinity == StartupAffinity::MainThread) {
+                    mainQueue.push_back(task);
+                } else {
+                    jobs.submit([this, task] { execute(task); });
+                }
+            }
+            ready.clear();
+
+            if (!mainQueue.empty()) {
+                const StartupTask task = mainQueue.front();
+                mainQueue.erase(mainQueue.begin());
+                execute(task);
+            } else {
+                bool idle;
+                {
+                    std::lock_guard lock(m_mutex);
+                    idle = m_completed.empty();
+                }
+                // Lend the main thread to the pool rather than sleeping while workers are busy
+                if (idle && !jobs.runPendingJob()) {
+                    std::unique_lock lock(m_mutex);
+                    m_condition.wait(lock, [this] { return !m_completed.empty(); });
+                }
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                completed.swap(m_completed);
+            }
+            for (const Completion &completion : completed) {
+                finish(completion.task, completion.succeeded, ready, remaining);
+            }
+            completed.clear();
+        }
+
+        m_totalMs = millisecondsSince(m_start);
+        return std::none_of(m_timings.begin(), m_timings.end(), [](const StartupTiming &timing) {
+            return timing.status != StartupStatus::Succeeded;
+        });
+    }
+
+    double StartupGraph::getCriticalPathMs() const {
+        // Dependencies are always added first, so one forward pass sees every chain in order
+        std::vector<double> finishMs(m_nodes.size(), 0.0);
+        double longest = 0.0;
+        for (StartupTask task = 0; task < m_nodes.size(); task++) {
+            double start = 0.0;
+            for (const StartupTask dependency : m_nodes[task].dependencies) {
+                start = std::max(start, finishMs[dependency]);
+            }
+            finishMs[task] = start + m_timings[task].durationMs;
+            longest = std::max(longest, finishMs[task]);
+        }
+        return longest;
+    }
+
+    void StartupGraph::printBreakdown() const {
+        std::vector<const StartupTiming *> order;
+        double summedMs = 0.0;
+        for (const StartupTiming &timing : m_timings) {
+            order.push_back(&timing);
+            summedMs += timing.durationMs;
+        }
+        // Tasks that never ran go last
+        std::sort(order.begin(), order.end(), [](const StartupTiming *a, const StartupTiming *b) {
+            const bool ranA = a->status == StartupStatus::Succeeded || a->status == StartupStatus::Failed;
+            const bool ranB = b->status == StartupStatus::Succeeded || b->status == StartupStatus::Failed;
+            return ranA != ranB ? ranA : a->startMs < b->startMs;
+        });
+
+        char line[160];
+        Helpers::Console::print("Startup breakdown:");
+        for (const StartupTiming *timing : order) {
+            if (timing->status == StartupStatus::Skipped || timing->status == StartupStatus::Pending) {
+                std::snprintf(line, sizeof(line), "  %-24s %s", timing->name.c_str(), statusName(timing->status));
+                Helpers::Console::print(line);
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "  %-24s %8.2f ms  at %8.2f ms  %-6s %s", timing->name.c_str(),
+                          timing->durationMs, timing->startMs, timing->mainThread ? "main" : "worker",
+                          statusName(timing->status));
+            Helpers::Console::print(line);
+        }
+        std::snprintf(line, sizeof(line), "  total %.2f ms, tasks %.2f ms, critical path %.2f ms",
+                      m_totalMs, summedMs, getCriticalPathMs());
+        Helpers::Console::print(line);
+    }
+
+    void StartupGraph::execute(StartupTask task) {
+        StartupTiming &timing = m_timings[task];
+        timing.mainThread = std::this_thread::get_id() == m_mainThread;
+        timing.startMs = millisecondsSince(m_start);
+
+        // Workers must not throw, so a throwing step just counts as a failed one
+        bool succeeded;
+        try {
+            succeeded = m_nodes[task].fn();
+        } catch (const std::exception &e) {
+            Helpers::Console::error(timing.name + ": " + e.what());
+            succeeded = false;
+        }
+        timing.durationMs = millisecondsSince(m_start) - timing.startMs;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_completed.push_back({task, succeeded});
+        }
+        m_condition.notify_one();
+    }
+
+    void StartupGraph::finish(StartupTask task, bool succeeded, std::vector<StartupTask> &ready, uint32_t &remaining) {
+        m_timings[task].status = succeeded ? StartupStatus::Succeeded : StartupStatus::Failed;
+        remaining--;
+        if (!succeeded) {
+            skipDependents(task, remaining);
+            return;
+        }
+        for (const StartupTask dependent : m_nodes[task].dependents) {
+            if (--m_nodes[dependent].waitingOn == 0 && m_timings[dependent].status == StartupStatus::Pending) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    void StartupGraph::skipDependents(StartupTask task, uint32_t &remaining) {
+        for (const StartupTask dependent : m_nodes[task].dependents) {
+            if (m_timings[dependent].status != StartupStatus::Pending) {
+                continue;
+            }
+            m_timings[dependent].status = StartupStatus::Skipped;
+            remaining--;
+            skipDependents(dependent, remaining);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef STARTUPGRAPH_H
+#define STARTUPGRAPH_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+
+namespace Trin::Runtime::Core {
+    using StartupTask = uint32_t;
+
+    enum class StartupAffinity {
+        Any,        // Runs on whichever thread is free
+        MainThread  // GLFW and anything else that must stay on the thread that called run()
+    };
+
+    enum class StartupStatus {
+        Pending,
+        Succeeded,
+        Failed,
+        Skipped     // A dependency failed, so the task never ran
+    };
+
+    struct StartupTiming {
+        std::string name;
+        StartupStatus status = StartupStatus::Pending;
+        double startMs = 0.0;       // Relative to the start of run()
+        double durationMs = 0.0;
+        bool mainThread = false;    // Ran on the thread that called run()
+    };
+
+/**
+ * Engine initialization expressed as a dependency graph.
+ *
+ * Tasks are added with the tasks they depend on and run() starts each one as soon as its
+ * dependencies are done, spreading independent steps over the job system. Every task is
+ * timed, printBreakdown() shows where startup went and how much the overlap saved.
+ */
+class StartupGraph {
+public:
+    /**
+     * @brief Adds a step to the graph
+     * @param name Shown in the breakdown
+     * @param fn The step, returning false stops everything that depends on it
+     * @param dependencies Tasks that must succeed first, they have to be added before this one
+     * @param affinity Where the step is allowed to run
+     * @return Handle to depend on in later tasks
+     */
+    StartupTask add(std::string name, std::function<bool()> fn, std::initializer_list<StartupTask> dependencies = {},
+                    StartupAffinity affinity = StartupAffinity::Any);
+
+    /**
+     * @brief Runs every task, blocking until all of them finished or were skipped
+     * @param jobs Pool for the tasks without main thread affinity
+     * @return False when any task failed
+     */
+    bool run(JobSystem &jobs = JobSystem::get());
+
+    [[nodiscard]] const std::vector<StartupTiming> &getTimings() const { return m_timings; }
+    [[nodiscard]] double getTotalMs() const { return m_totalMs; }
+
+    /// Longest chain of dependent task durations, the floor for the total however many threads there are
+    [[nodiscard]] double getCriticalPathMs() const;
+
+    /// Prints every task by start time, then the wall time against the summed task time
+    void printBreakdown() const;
+
+private:
+    struct Node {
+        std::function<bool()> fn;
+        std::vector<StartupTask> dependents;
+        std::vector<StartupTask> dependencies;
+        uint32_t waitingOn = 0;
+        StartupAffinity affinity = StartupAffinity::Any;
+    };
+
+    struct Completion {
+        StartupTask task;
+        bool succeeded;
+    };
+
+    void execute(StartupTask task);
+    void finish(StartupTask task, bool succeeded, std::vector<StartupTask> &ready, uint32_t &remaining);
+    void skipDependents(StartupTask task, uint32_t &remaining);
+
+    std::vector<Node> m_nodes;
+    std::vector<StartupTiming> m_timings;
+    double m_totalMs = 0.0;
+
+    std::chrono::steady_clock::time_point m_start;
+    std::thread::id m_mainThread;
+    std::vector<Completion> m_completed;     // Filled by the workers, drained by run()
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+};
+
+}
+
+#endif //STARTUPGRAPH_H
@@ -0,0 +1,289 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Core {
+    using namespace TelemetryLayout;
+
+    std::mutex Telemetry::sm_mutex;
+    std::vector<Telemetry::ThreadSlab *> Telemetry::sm_slabs;
+    std::vector<Telemetry::ThreadSlab *> Telemetry::sm_freeSlabs;
+    std::vector<std::string> Telemetry::sm_counterNames;
+    std::vector<CounterKind> Telemetry::sm_counterKinds;
+    std::vector<std::string> Telemetry::sm_histogramNames;
+    std::atomic<uint64_t> Telemetry::sm_gauges[kMaxCounters + 1];
+
+    Segment *Telemetry::sm_segment = nullptr;
+    std::string Telemetry::sm_segmentName;
+    uint32_t Telemetry::sm_publishedCounters = 0;
+    uint32_t Telemetry::sm_publishedHistograms = 0;
+#ifdef _WIN32
+    void *Telemetry::sm_mapping = nullptr;
+#endif
+
+    namespace {
+        void copyName(char (&destination)[kNameLength], const std::string &name) {
+            const size_t length = std::min<size_t>(name.size(), kNameLength - 1);
+            std::memcpy(destination, name.data(), length);
+            destination[length] = '\0';
+        }
+
+#ifndef _WIN32
+        /// True when an existing segment was published by a process that has since exited
+        bool isAbandoned(const char *segmentName) {
+            const int fd = shm_open(segmentName, O_RDONLY, 0);
+            if (fd < 0) {
+                return false;
+            }
+            // magic, version, size and processId lead every version of the layout
+            constexpr size_t kHeaderBytes = 4 * sizeof(uint32_t);
+            struct stat info{};
+            void *view = MAP_FAILED;
+            if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= kHeaderBytes) {
+                view = mmap(nullptr, kHeaderBytes, PROT_READ, MAP_SHARED, fd, 0);
+            }
+            ::close(fd);
+            if (view == MAP_FAILED) {
+                return false;
+            }
+            const auto *header = static_cast<const uint32_t *>(view);
+            const bool ours = header[0] == kMagic;
+            const auto writer = static_cast<pid_t>(header[3]);
+            munmap(view, kHeaderBytes);
+            return ours && writer > 0 && kill(writer, 0) != 0 && errno == ESRCH;
+        }
+#endif
+    }
+
+    TelemetryCounter Telemetry::counter(const char *name) {
+        return {addCounter(name, CounterKind::Counter)};
+    }
+
+    TelemetryGauge Telemetry::gauge(const char *name) {
+        return {addCounter(name, CounterKind::Gauge)};
+    }
+
+    TelemetryHistogram Telemetry::histogram(const char *name) {
+        std::lock_guard lock(sm_mutex);
+        const auto it = std::find(sm_histogramNames.begin(), sm_histogramNames.end(), name);
+        if (it != sm_histogramNames.end()) {
+            return {static_cast<uint16_t>(it - sm_histogramNames.begin())};
+        }
+        if (sm_histogramNames.size() == kMaxHistograms) {
+            Helpers::Console::warn(std::string("Telemetry: no room for histogram ") + name + ", it won't be published");
+            return {static_cast<uint16_t>(kMaxHistograms)};
+        }
+        sm_histogramNames.emplace_back(name);
+        return {static_cast<uint16_t>(sm_histogramNames.size() - 1)};
+    }
+
+    uint16_t Telemetry::addCounter(const char *name, CounterKind kind) {
+        std::lock_guard lock(sm_mutex);
+        const auto it = std::find(sm_counterNames.begin(), sm_counterNames.end(), name);
+        if (it != sm_counterNames.end()) {
+            return static_cast<uint16_t>(it - sm_counterNames.begin());
+        }
+        if (sm_counterNames.size() == kMaxCounters) {
+            Helpers::Console::warn(std::string("Telemetry: no room for counter ") + name + ", it won't be published");
+            return static_cast<uint16_t>(kMaxCounters);
+        }
+        sm_counterNames.emplace_back(name);
+        sm_counterKinds.push_back(kind);
+        return static_cast<uint16_t>(sm_counterNames.size() - 1);
+    }
+
+    Telemetry::ThreadSlab *Telemetry::addThread() {
+        // Kept apart from sm_threadSlab so the pointer read on every update stays a plain thread local
+        static thread_local ThreadSlabOwner owner;
+        std::lock_guard lock(sm_mutex);
+        if (!sm_freeSlabs.empty()) {
+            owner.slab = sm_freeSlabs.back();
+            sm_freeSlabs.pop_back();
+        } else {
+            owner.slab = new ThreadSlab();
+            sm_slabs.push_back(owner.slab);
+        }
+        return owner.slab;
+    }
+
+    Telemetry::ThreadSlabOwner::~ThreadSlabOwner() {
+        sm_threadSlab = nullptr;
+        std::lock_guard lock(sm_mutex);
+        sm_freeSlabs.push_back(slab);
+    }
+
+    bool Telemetry::open(const char *segmentName) {
+        close();
+
+        void *memory = nullptr;
+#ifdef _WIN32
+        sm_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(Segment), segmentName);
+        if (sm_mapping && GetLastError() == ERROR_ALREADY_EXISTS) {
+            // Mappings die with their last handle, so an existing one belongs to a live process
+            CloseHandle(sm_mapping);
+            sm_mapping = nullptr;
+            Helpers::Console::warn(std::string("Telemetry: shared memory ") + segmentName + " is in use by another process");
+            return false;
+        }
+        if (!sm_mapping) {
+            Helpers::Console::warn(std::string("Telemetry: could not create shared memory ") + segmentName);
+            return false;
+        }
+        memory = MapViewOfFile(sm_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Segment));
+        if (!memory) {
+            CloseHandle(sm_mapping);
+            sm_mapping = nullptr;
+        }
+#else
+        int fd = shm_open(segmentName, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST && isAbandoned(segmentName)) {
+            // A crashed run leaves its segment behind, nobody writes it any more so start a fresh one
+            shm_unlink(segmentName);
+            fd = shm_open(segmentName, O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if (fd < 0) {
+            // Anything else under the name may be another live engine's, leave it alone
+            const bool taken = errno == EEXIST;
+            Helpers::Console::warn(std::string("Telemetry: could not create shared memory ") + segmentName +
+                                   (taken ? ", it is in use by another process" : ""));
+            return false;
+        }
+        if (ftruncate(fd, sizeof(Segment)) == 0) {
+            memory = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (memory == MAP_FAILED) {
+                memory = nullptr;
+            }
+        }
+        ::close(fd);
+        if (!memory) {
+            shm_unlink(segmentName);
+        }
+#endif
+        if (!memory) {
+            Helpers::Console::warn(std::string("Telemetry: could not map shared memory ") + segmentName);
+            return false;
+        }
+
+        auto *segment = new (memory) Segment{};
+        segment->version = kVersion;
+        segment->size = sizeof(Segment);
+#ifdef _WIN32
+        segment->processId = static_cast<uint32_t>(GetCurrentProcessId());
+#else
+        segment->processId = static_cast<uint32_t>(getpid());
+#endif
+        segment->magic = kMagic;
+
+        std::lock_guard lock(sm_mutex);
+        sm_segment = segment;
+        sm_segmentName = segmentName;
+        sm_publishedCounters = 0;
+        sm_publishedHistograms = 0;
+        return true;
+    }
+
+    void Telemetry::publish(uint64_t frame) {
+        if (!sm_segment) {
+            return;
+        }
+        Segment &segment = *sm_segment;
+        std::lock_guard lock(sm_mutex);
+
+        const uint64_t sequence = segment.sequence.load(std::memory_order_relaxed);
+        segment.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        segment.frame = frame;
+        segment.publishNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+
+        // Names only change when something new registered since the last publish
+        const auto counterCount = static_cast<uint32_t>(sm_counterNames.size());
+        for (uint32_t i = sm_publishedCounters; i < counterCount; i++) {
+            copyName(segment.counters[i].name, sm_counterNames[i]);
+            segment.counters[i].kind = sm_counterKinds[i];
+        }
+        const auto histogramCount = static_cast<uint32_t>(sm_histogramNames.size());
+        for (uint32_t i = sm_publishedHistograms; i < histogramCount; i++) {
+            copyName(segment.histograms[i].name, sm_histogramNames[i]);
+        }
+        sm_publishedCounters = counterCount;
+        sm_publishedHistograms = histogramCount;
+        segment.counterCount = counterCount;
+        segment.histogramCount = histogramCount;
+
+        for (uint32_t i = 0; i < counterCount; i++) {
+            uint64_t value = 0;
+            if (sm_counterKinds[i] == CounterKind::Gauge) {
+                value = sm_gauges[i].load(std::memory_order_relaxed);
+            } else {
+                for (const ThreadSlab *slab : sm_slabs) {
+                    value += slab->counters[i].load(std::memory_order_relaxed);
+                }
+            }
+            segment.counters[i].value = value;
+        }
+
+        for (uint32_t i = 0; i < histogramCount; i++) {
+            HistogramEntry &entry = segment.histograms[i];
+            std::fill(std::begin(entry.buckets), std::end(entry.buckets), 0);
+            entry.sum = 0;
+            for (const ThreadSlab *slab : sm_slabs) {
+                const HistogramSlab &source = slab->histograms[i];
+                for (uint32_t bucket = 0; bucket < kHistogramBuckets; bucket++) {
+                    entry.buckets[bucket] += source.buckets[bucket].load(std::memory_order_relaxed);
+                }
+                entry.sum += source.sum.load(std::memory_order_relaxed);
+            }
+            entry.count = 0;
+            for (const uint64_t bucket : entry.buckets) {
+                entry.count += bucket;
+            }
+        }
+
+        segment.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void Telemetry::close() {
+        if (!sm_segment) {
+            return;
+        }
+        std::lock_guard lock(sm_mutex);
+#ifdef _WIN32
+        UnmapViewOfFile(sm_segment);
+        CloseHandle(sm_mapping);
+        sm_mapping = nullptr;
+#else
+        munmap(sm_segment, sizeof(Segment));
+        shm_unlink(sm_segmentName.c_str());
+#endif
+        sm_segment = nullptr;
+        sm_segmentName.clear();
+    }
+}
@@ -0,0 +1,156 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "TelemetryLayout.h"
+
+// Recording is a thread local lookup and two relaxed memory operations, define as 0 to compile it out
+#ifndef TRIN_TELEMETRY
+#define TRIN_TELEMETRY 1
+#endif
+
+namespace Trin::Runtime::Core {
+    /// Monotonic count, summed over every thread when published
+    struct TelemetryCounter {
+        uint16_t index = 0;
+    };
+
+    /// Single value that is overwritten, such as a queue depth
+    struct TelemetryGauge {
+        uint16_t index = 0;
+    };
+
+    /// Distribution over power of two buckets, such as frame times in microseconds
+    struct TelemetryHistogram {
+        uint16_t index = 0;
+    };
+
+/**
+ * Live engine statistics for external tools.
+ *
+ * Every thread records into its own slab, so counters and histograms never share a cache
+ * line between threads and need no atomic read-modify-write. Once per frame the main thread
+ * calls publish(), which sums the slabs into a shared memory segment (see TelemetryLayout.h)
+ * under a sequence lock. Readers such as TrinVK_TelemetryMonitor map the segment read only
+ * and retry on a torn read, nothing they do can block the engine.
+ *
+ * Register names once at startup and keep the returned handle, registering the same name
+ * again returns the same handle.
+ */
+class Telemetry {
+public:
+    static TelemetryCounter counter(const char *name);
+    static TelemetryGauge gauge(const char *name);
+    static TelemetryHistogram histogram(const char *name);
+
+    static void add(TelemetryCounter counter, uint64_t amount = 1) {
+#if TRIN_TELEMETRY
+        // Only this thread writes its slab, a plain load and store is enough and skips the locked add
+        std::atomic<uint64_t> &value = slab().counters[counter.index];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+#else
+        (void)counter;
+        (void)amount;
+#endif
+    }
+
+    static void set(TelemetryGauge gauge, uint64_t value) {
+#if TRIN_TELEMETRY
+        sm_gauges[gauge.index].store(value, std::memory_order_relaxed);
+#else
+        (void)gauge;
+        (void)value;
+#endif
+    }
+
+    static void record(TelemetryHistogram histogram, uint64_t value) {
+#if TRIN_TELEMETRY
+        HistogramSlab &slot = slab().histograms[histogram.index];
+        std::atomic<uint64_t> &bucket = slot.buckets[TelemetryLayout::bucketOf(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        slot.sum.store(slot.sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+#else
+        (void)histogram;
+        (void)value;
+#endif
+    }
+
+    /**
+     * @brief Creates the shared memory segment, replacing a stale one left by a crashed run
+     * @param segmentName Shared memory object name, readers attach with the same one
+     * @return False when the platform refused or another running process owns the name,
+     *         recording keeps working without a segment
+     *
+     * Only a segment whose writer has exited is replaced, two engines running at once need
+     * different names.
+     */
+    static bool open(const char *segmentName = TelemetryLayout::kDefaultSegmentName);
+
+    /// Sums every thread's slab into the segment, call once per frame from one thread
+    static void publish(uint64_t frame);
+
+    /// Unmaps and removes the segment this process created
+    static void close();
+
+    [[nodiscard]] static bool isOpen() { return sm_segment != nullptr; }
+
+private:
+    // Arrays have one spare entry past the published ones, registrations past the limit record into it
+    struct HistogramSlab {
+        std::atomic<uint64_t> buckets[TelemetryLayout::kHistogramBuckets]{};
+        std::atomic<uint64_t> sum{0};
+    };
+
+    struct alignas(64) ThreadSlab {
+        std::atomic<uint64_t> counters[TelemetryLayout::kMaxCounters + 1]{};
+        HistogramSlab histograms[TelemetryLayout::kMaxHistograms + 1];
+    };
+
+    static ThreadSlab &slab() {
+        if (!sm_threadSlab) [[unlikely]] {
+            sm_threadSlab = addThread();
+        }
+        return *sm_threadSlab;
+    }
+
+    /// Hands the slab to the next new thread when its thread exits, totals carry on from there
+    struct ThreadSlabOwner {
+        ThreadSlab *slab = nullptr;
+        ~ThreadSlabOwner();
+    };
+
+    static ThreadSlab *addThread();
+    static uint16_t addCounter(const char *name, TelemetryLayout::CounterKind kind);
+
+    static inline thread_local ThreadSlab *sm_threadSlab = nullptr;
+
+    // Slabs outlive their threads, totals of finished threads still count
+    static std::mutex sm_mutex;
+    static std::vector<ThreadSlab *> sm_slabs;
+    static std::vector<ThreadSlab *> sm_freeSlabs;
+    static std::vector<std::string> sm_counterNames;
+    static std::vector<TelemetryLayout::CounterKind> sm_counterKinds;
+    static std::vector<std::string> sm_histogramNames;
+    static std::atomic<uint64_t> sm_gauges[TelemetryLayout::kMaxCounters + 1];
+
+    static TelemetryLayout::Segment *sm_segment;
+    static std::string sm_segmentName;
+    static uint32_t sm_publishedCounters;
+    static uint32_t sm_publishedHistograms;
+#ifdef _WIN32
+    static void *sm_mapping;
+#endif
+};
+
+}
+
+#endif //TELEMETRY_H
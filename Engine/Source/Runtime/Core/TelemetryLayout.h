@@ -0,0 +1,85 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef TELEMETRYLAYOUT_H
+#define TELEMETRYLAYOUT_H
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+/**
+ * Layout of the shared memory segment the engine publishes telemetry into.
+ *
+ * This header is shared with TrinVK_TelemetryMonitor and depends on nothing else in the
+ * engine. Any change to the structs below must bump kVersion, readers refuse segments whose
+ * magic, version or size don't match their own.
+ */
+namespace Trin::Runtime::Core::TelemetryLayout {
+    constexpr uint32_t kMagic = 0x4C544E54;     // "TNTL"
+    constexpr uint32_t kVersion = 1;
+
+    constexpr uint32_t kMaxCounters = 128;
+    constexpr uint32_t kMaxHistograms = 32;
+    constexpr uint32_t kNameLength = 48;
+
+    /// Bucket i counts values whose bit width is i, so 0, 1, 2-3, 4-7 and so on up to 2^63
+    constexpr uint32_t kHistogramBuckets = 65;
+
+#ifdef _WIN32
+    constexpr const char *kDefaultSegmentName = "Local\\trinvk-telemetry";
+#else
+    constexpr const char *kDefaultSegmentName = "/trinvk-telemetry";
+#endif
+
+    enum class CounterKind : uint32_t {
+        Counter,    // Monotonic total summed over every thread, readers derive rates from it
+        Gauge       // Last value set, such as a queue depth or live bytes
+    };
+
+    struct CounterEntry {
+        char name[kNameLength];
+        CounterKind kind;
+        uint32_t reserved;
+        uint64_t value;
+    };
+
+    struct HistogramEntry {
+        char name[kNameLength];
+        uint64_t count;
+        uint64_t sum;
+        uint64_t buckets[kHistogramBuckets];
+    };
+
+    struct Segment {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size;              // sizeof(Segment) of the writer
+        uint32_t processId;
+
+        /// Odd while the engine is writing, readers retry until they see the same even value twice
+        std::atomic<uint64_t> sequence;
+
+        uint64_t frame;
+        uint64_t publishNs;         // Steady clock of the writer, only meaningful as a difference
+        uint32_t counterCount;
+        uint32_t histogramCount;
+
+        CounterEntry counters[kMaxCounters];
+        HistogramEntry histograms[kMaxHistograms];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The sequence is shared between processes");
+
+    inline uint32_t bucketOf(uint64_t value) {
+        return static_cast<uint32_t>(std::bit_width(value));
+    }
+
+    /// Largest value that lands in a bucket
+    inline uint64_t bucketUpperBound(uint32_t bucket) {
+        return bucket == 0 ? 0 : bucket >= 64 ? UINT64_MAX : (uint64_t{1} << bucket) - 1;
+    }
+}
+
+#endif //TELEMETRYLAYOUT_H
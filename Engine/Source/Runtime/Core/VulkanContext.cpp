@@ -5,29 +5,103 @@
 #include "VulkanContext.h"
 
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "Window.h"
+#include "Helpers/Console.h"
 
 namespace Trin::Runtime::Core {
-    void VulkanContext::init() {
-        createInstance();
-        createDebugMessenger();
-        createSurface();
-        pickPhysicalDevice();
-        createLogicalDevice();
+    namespace {
+        constexpr const char *kValidationLayer = "VK_LAYER_KHRONOS_validation";
+
+        VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                                                     VkDebugUtilsMessageTypeFlagsEXT,
+                                                     const VkDebugUtilsMessengerCallbackDataEXT *data, void *) {
+            if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+                Helpers::Console::error(data->pMessage);
+            } else {
+                Helpers::Console::warn(data->pMessage);
+            }
+            return VK_FALSE;
+        }
+    }
+
+    VulkanContext::~VulkanContext() {
+        shutdown();
+    }
+
+    bool VulkanContext::init(const VulkanCreateInfo &info) {
+        shutdown();
+        if (!createInstance(info) ||
+            !createSurface(info) ||
+            !scoreDevices(info) ||
+            !pickPhysicalDevice() ||
+            !createLogicalDevice() ||
+            !createPipelineCache()) {
+            shutdown();
+            return false;
+        }
+        return true;
+    }
+
+    void VulkanContext::shutdown() {
+        if (m_device && m_device->logicalDevice != VK_NULL_HANDLE) {
+            vkDeviceWaitIdle(m_device->logicalDevice);
+            if (m_pipelineCache != VK_NULL_HANDLE) {
+                vkDestroyPipelineCache(m_device->logicalDevice, m_pipelineCache, nullptr);
+                m_pipelineCache = VK_NULL_HANDLE;
+            }
+            m_device->graphicsQueue.reset();
+            m_device->presentQueue.reset();
+            vkDestroyDevice(m_device->logicalDevice, nullptr);
+        }
+        m_device.reset();
+        m_physicalDevice.reset();
+        m_candidates.clear();
+
+        if (m_surface != VK_NULL_HANDLE) {
+            vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+            m_surface = VK_NULL_HANDLE;
+        }
+        if (m_debugMessenger != VK_NULL_HANDLE) {
+            const auto destroyMessenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+                vkGetInstanceProcAddr(m_instance, "vkDestroyDebugUtilsMessengerEXT"));
+            if (destroyMessenger) {
+                destroyMessenger(m_instance, m_debugMessenger, nullptr);
+            }
+            m_debugMessenger = VK_NULL_HANDLE;
+        }
+        if (m_instance != VK_NULL_HANDLE) {
+            vkDestroyInstance(m_instance, nullptr);
+            m_instance = VK_NULL_HANDLE;
+        }
     }
 
-    void VulkanContext::createInstance() {
+    bool VulkanContext::createInstance(const VulkanCreateInfo &info) {
         VkApplicationInfo appInfo{};
         appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
-        appInfo.pApplicationName = "Trin";
-        appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+        appInfo.pApplicationName = info.applicationName.c_str();
+        appInfo.applicationVersion = info.applicationVersion;
         appInfo.pEngineName = "Trin";
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.apiVersion = VK_MAKE_VERSION(1, 0, 0);
 
-        std::vector<const char*> extensions = getRequiredExtensions();
-        std::vector layers = {
-            "VK_LAYER_KHRONOS_validation"
-        };
+        // Headless contexts don't need the window system extensions, or GLFW at all
+        const bool presents = info.window || info.deferredWindow;
+        std::vector<const char*> extensions = presents ? getRequiredExtensions() : std::vector<const char*>{};
+        std::vector<const char*> layers;
+        if (info.enableValidationLayers) {
+            if (isLayerAvailable(kValidationLayer)) {
+                layers.push_back(kValidationLayer);
+                extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+            } else {
+                Helpers::Console::warn("Validation layers requested but not installed");
+            }
+        }
 
         // Create instance
         VkInstanceCreateInfo createInfo{};
@@ -40,18 +114,219 @@ namespace Trin::Runtime::Core {
 
         m_extensions = extensions;
         m_layers = layers;
+
+        if (vkCreateInstance(&createInfo, nullptr, &m_instance) != VK_SUCCESS) {
+            Helpers::Console::error("Failed to create Vulkan instance");
+            m_instance = VK_NULL_HANDLE;
+            return false;
+        }
+        return createDebugMessenger();
     }
 
-    void VulkanContext::createDebugMessenger() {
+    bool VulkanContext::createDebugMessenger() {
+        if (m_layers.empty()) {
+            return true;
+        }
+
+        const auto createMessenger = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+            vkGetInstanceProcAddr(m_instance, "vkCreateDebugUtilsMessengerEXT"));
+        if (!createMessenger) {
+            // Validation still runs, it just goes to the layer's default output
+            return true;
+        }
+
+        VkDebugUtilsMessengerCreateInfoEXT createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+        createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
+                                     VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
+                                 VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+                                 VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        createInfo.pfnUserCallback = debugCallback;
+        if (createMessenger(m_instance, &createInfo, nullptr, &m_debugMessenger) != VK_SUCCESS) {
+            Helpers::Console::warn("Failed to create Vulkan debug messenger");
+            m_debugMessenger = VK_NULL_HANDLE;
+        }
+        return true;
     }
 
-    void VulkanContext::createSurface() {
+    bool VulkanContext::createSurface(const VulkanCreateInfo &info) {
+        if (!info.window) {
+            return true;
+        }
+        if (glfwCreateWindowSurface(m_instance, info.window->GetWindow(), nullptr, &m_surface) != VK_SUCCESS) {
+            Helpers::Console::error("Failed to create window surface");
+            m_surface = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
     }
 
-    void VulkanContext::pickPhysicalDevice() {
+    bool VulkanContext::scoreDevices(const VulkanCreateInfo &info, JobSystem *jobs) {
+        uint32_t deviceCount = 0;
+        vkEnumeratePhysicalDevices(m_instance, &deviceCount, nullptr);
+        std::vector<VkPhysicalDevice> devices(deviceCount);
+        vkEnumeratePhysicalDevices(m_instance, &deviceCount, devices.data());
+
+        // Property, feature and extension queries can take a while per device on some drivers
+        m_needsSwapchain = info.window || info.deferredWindow;
+        std::vector<std::shared_ptr<PhysicalDevice>> scored(deviceCount);
+        std::vector<uint32_t> scores(deviceCount, 0);
+        const auto score = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                auto candidate = std::make_shared<PhysicalDevice>(devices[i], VK_NULL_HANDLE);
+                if (info.requiredDeviceType != VK_PHYSICAL_DEVICE_TYPE_MAX_ENUM &&
+                    candidate->physicalDeviceProperties.deviceType != info.requiredDeviceType) {
+                    continue;
+                }
+                if (m_needsSwapchain && !candidate->isSupported({VK_KHR_SWAPCHAIN_EXTENSION_NAME})) {
+                    continue;
+                }
+                scores[i] = candidate->getScore();
+                scored[i] = std::move(candidate);
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(deviceCount, 1, score);
+        } else {
+            score(0, deviceCount);
+        }
+
+        m_candidates.clear();
+        std::vector<uint32_t> order;
+        for (uint32_t i = 0; i < deviceCount; i++) {
+            if (scored[i] && scores[i] > 0) {
+                order.push_back(i);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return scores[a] > scores[b]; });
+        for (const uint32_t i : order) {
+            m_candidates.push_back(scored[i]);
+        }
+
+        if (m_candidates.empty()) {
+            Helpers::Console::error("No suitable GPU found");
+            return false;
+        }
+        return true;
     }
 
-    void VulkanContext::createLogicalDevice() {
+    bool VulkanContext::pickPhysicalDevice() {
+        // Present support is only known once the surface exists, take the best device that has it
+        for (const auto &candidate : m_candidates) {
+            candidate->setSurface(m_surface);
+            if (candidate->queueFamily.complete()) {
+                m_physicalDevice = candidate;
+                return true;
+            }
+        }
+        Helpers::Console::error("No GPU can present to the window surface");
+        return false;
+    }
+
+    bool VulkanContext::createLogicalDevice() {
+        const QueueFamilyIndices &families = m_physicalDevice->queueFamily;
+        const std::set uniqueFamilies = {families.graphicsFamily.value(), families.presentFamily.value()};
+
+        const float priority = 1.0f;
+        std::vector<VkDeviceQueueCreateInfo> queueInfos;
+        for (const uint32_t family : uniqueFamilies) {
+            VkDeviceQueueCreateInfo queueInfo{};
+            queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueInfo.queueFamilyIndex = family;
+            queueInfo.queueCount = 1;
+            queueInfo.pQueuePriorities = &priority;
+            queueInfos.push_back(queueInfo);
+        }
+
+        std::vector<const char*> deviceExtensions;
+        if (m_surface != VK_NULL_HANDLE) {
+            deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+
+        // Indirect drawing, enabled whenever the device has it. The instance targets Vulkan 1.0,
+        // so the count variant comes from the KHR extension rather than the 1.2 core feature.
+        VkPhysicalDeviceFeatures features{};
+        features.multiDrawIndirect = m_physicalDevice->physicalDeviceFeatures.multiDrawIndirect;
+        const bool drawIndirectCount = m_physicalDevice->isSupported({VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME});
+        if (drawIndirectCount) {
+            deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        }
+
+        VkDeviceCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
+        createInfo.pQueueCreateInfos = queueInfos.data();
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+        createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+        createInfo.pEnabledFeatures = &features;
+
+        m_device = std::make_shared<Device>(createInfo, m_physicalDevice);
+        if (m_device->logicalDevice == VK_NULL_HANDLE) {
+            Helpers::Console::error("Failed to create logical device");
+            m_device.reset();
+            return false;
+        }
+        m_device->multiDrawIndirect = features.multiDrawIndirect == VK_TRUE;
+        m_device->drawIndirectCount = drawIndirectCount;
+        return true;
+    }
+
+    bool VulkanContext::createPipelineCache(std::span<const std::byte> initialData) {
+        // Data from another GPU or driver version is rejected by some drivers and ignored by
+        // others, check the header ourselves and start empty instead
+        if (!initialData.empty()) {
+            VkPipelineCacheHeaderVersionOne header{};
+            const VkPhysicalDeviceProperties &properties = m_physicalDevice->physicalDeviceProperties;
+            bool valid = initialData.size() >= sizeof(header);
+            if (valid) {
+                std::memcpy(&header, initialData.data(), sizeof(header));
+                valid = header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                        header.vendorID == properties.vendorID &&
+                        header.deviceID == properties.deviceID &&
+                        std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+            }
+            if (!valid) {
+                Helpers::Console::warn("Pipeline cache was written by another device or driver, starting empty");
+                initialData = {};
+            }
+        }
+
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.data();
+        if (vkCreatePipelineCache(m_device->logicalDevice, &createInfo, nullptr, &m_pipelineCache) != VK_SUCCESS) {
+            Helpers::Console::error("Failed to create pipeline cache");
+            m_pipelineCache = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanContext::savePipelineCache(const std::string &path) const {
+        if (m_pipelineCache == VK_NULL_HANDLE) {
+            return false;
+        }
+        size_t size = 0;
+        vkGetPipelineCacheData(m_device->logicalDevice, m_pipelineCache, &size, nullptr);
+        std::vector<char> data(size);
+        if (vkGetPipelineCacheData(m_device->logicalDevice, m_pipelineCache, &size, data.data()) != VK_SUCCESS) {
+            return false;
+        }
+
+        const std::filesystem::path file(path);
+        if (file.has_parent_path()) {
+            std::error_code error;
+            std::filesystem::create_directories(file.parent_path(), error);
+        }
+        std::ofstream out(file, std::ios::binary);
+        out.write(data.data(), static_cast<std::streamsize>(size));
+        if (!out) {
+            Helpers::Console::warn("Failed to write pipeline cache " + path);
+            return false;
+        }
+        return true;
     }
 
     std::vector<const char *> VulkanContext::getRequiredExtensions() {
@@ -60,4 +335,19 @@ namespace Trin::Runtime::Core {
         std::vector extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
         return extensions;
     }
+
+    bool VulkanContext::isLayerAvailable(const char *layer) {
+        uint32_t layerCount = 0;
+        vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+        std::vector<VkLayerProperties> layers(layerCount);
+        vkEnumerateInstanceLayerProperties(&layerCount, layers.data());
+
+        const Helpers::StringId wanted(layer);
+        for (const auto &properties : layers) {
+            if (Helpers::StringId(properties.layerName) == wanted) {
+                return true;
+            }
+        }
+        return false;
+    }
 }
@@ -6,9 +6,13 @@
 #define VULKANCONTEXT_H
 
 #include <optional>
-#include <set>
+#include <span>
 #include <vulkan/vulkan.hpp>
 
+#include "JobSystem.h"
+#include "Helpers/StringId.h"
+#include "Helpers/Types.h"
+
 namespace Trin::Runtime::Core {
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
@@ -50,6 +54,14 @@ namespace Trin::Runtime::Core {
                     indices.graphicsFamily = i;
                 }
 
+                // Headless contexts have nothing to present to, the graphics queue stands in
+                if (surface == VK_NULL_HANDLE) {
+                    if (indices.graphicsFamily.has_value()) {
+                        indices.presentFamily = indices.graphicsFamily;
+                    }
+                    continue;
+                }
+
                 VkBool32 presentSupport = false;
                 vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
                 if (presentSupport) {
@@ -73,6 +85,12 @@ namespace Trin::Runtime::Core {
             queueFamily = getQueueFamilies();
         }
 
+        /// Re-resolves the queue families once the surface exists, scoring may run before it does
+        void setSurface(VkSurfaceKHR newSurface) {
+            surface = newSurface;
+            queueFamily = getQueueFamilies();
+        }
+
         /// Checks if all extensions necessary for this
         /// physical device is currently active for the instance
         [[nodiscard]] bool isSupported(std::vector<const char*> extensions) const {
@@ -83,9 +101,15 @@ namespace Trin::Runtime::Core {
             std::vector<VkExtensionProperties> availableExtensions(extensionCount);
             vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
 
-            std::set<std::string> requiredExtensions(extensions.begin(), extensions.end());
+            // Compare hashes instead of building a string set on every call
+            std::vector<Helpers::StringId> requiredExtensions;
+            requiredExtensions.reserve(extensions.size());
+            for (const char* extension : extensions) {
+                requiredExtensions.emplace_back(extension);
+            }
             for (const auto& extension : availableExtensions) {
-                requiredExtensions.erase(extension.extensionName);
+                const Helpers::StringId available(extension.extensionName);
+                std::erase(requiredExtensions, available);
             }
 
             return requiredExtensions.empty();
@@ -140,16 +164,76 @@ namespace Trin::Runtime::Core {
         std::unique_ptr<Queue> graphicsQueue;
         std::unique_ptr<Queue> presentQueue;
 
+        // Optional features the device was created with, IndirectDrawSubmitter needs to know both
+        bool multiDrawIndirect = false;
+        bool drawIndirectCount = false;     // VK_KHR_draw_indirect_count
+
         Device(const VkDeviceCreateInfo &info, const std::shared_ptr<PhysicalDevice>& physicalDevice) {
             this->physicalDevice = physicalDevice;
-            vkCreateDevice(physicalDevice->physicalDevice, &info, nullptr, &logicalDevice);
+            if (vkCreateDevice(physicalDevice->physicalDevice, &info, nullptr, &logicalDevice) != VK_SUCCESS) {
+                logicalDevice = VK_NULL_HANDLE;
+                return;
+            }
             graphicsQueue = std::make_unique<Queue>(logicalDevice, physicalDevice->queueFamily.graphicsFamily.value());
             presentQueue = std::make_unique<Queue>(logicalDevice, physicalDevice->queueFamily.presentFamily.value());
         }
     };
+    class Window;
+
+    struct VulkanCreateInfo {
+        String applicationName = "Trin";
+        uint32_t applicationVersion = VK_MAKE_API_VERSION(0, 1, 0, 0);
+        bool enableValidationLayers = false;
+        std::shared_ptr<Window> window;     // Null creates a headless context without a surface
+        bool deferredWindow = false;        // The window is handed to createSurface() later, set up the instance for presenting anyway
+        VkPhysicalDeviceType requiredDeviceType = VK_PHYSICAL_DEVICE_TYPE_MAX_ENUM; // MAX_ENUM accepts any type
+    };
     class VulkanContext {
     public:
-        void init();
+        ~VulkanContext();
+
+        /**
+         * @brief Creates the instance, surface and logical device
+         * @param info Application details, window and device requirements
+         * @return False when any step fails, the context is left shut down
+         */
+        bool init(const VulkanCreateInfo &info);
+
+        /// Destroys everything init() created, safe to call more than once
+        void shutdown();
+
+        // ==============
+        // INITIALIZATION
+        // ==============
+
+        // init() runs these in order, the engine's startup graph runs them as separate tasks so
+        // device scoring overlaps window creation. Each returns false after logging the failure.
+
+        bool createInstance(const VulkanCreateInfo &info);     // Establishes the Vulkan API connection and debug output
+        bool createSurface(const VulkanCreateInfo &info);      // Needs the instance and the window, main thread only
+
+        /**
+         * @brief Queries and scores every physical device, only needs the instance
+         * @param info Device type requirement, and whether a swapchain will be needed
+         * @param jobs Pool to query the devices on, nullptr keeps it on the calling thread
+         */
+        bool scoreDevices(const VulkanCreateInfo &info, JobSystem *jobs = nullptr);
+        bool pickPhysicalDevice();          // Best scored device whose queues can present to the surface
+        bool createLogicalDevice();         // Logical device and queues
+
+        /**
+         * @brief Creates the pipeline cache, seeded with data saved by a previous run
+         * @param initialData Contents of the cache file, ignored when empty or written by another device or driver
+         */
+        bool createPipelineCache(std::span<const std::byte> initialData = {});
+
+        /// Writes the pipeline cache so the next start skips shader compilation it already did
+        bool savePipelineCache(const std::string &path) const;
+
+        [[nodiscard]] VkInstance getInstance() const { return m_instance; }
+        [[nodiscard]] std::shared_ptr<Device> getDevice() const { return m_device; }
+        [[nodiscard]] std::shared_ptr<PhysicalDevice> getPhysicalDevice() const { return m_physicalDevice; }
+        [[nodiscard]] VkPipelineCache getPipelineCache() const { return m_pipelineCache; }
     private:
         // ==============
         //     VULKAN
@@ -158,23 +242,18 @@ namespace Trin::Runtime::Core {
         VkInstance m_instance = VK_NULL_HANDLE;
         VkSurfaceKHR m_surface = VK_NULL_HANDLE;
         VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
+        VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
         std::shared_ptr<Device> m_device;
         std::shared_ptr<PhysicalDevice> m_physicalDevice;
 
         std::vector<const char*> m_extensions;
         std::vector<const char*> m_layers;
 
-        // ==============
-        // INITIALIZATION
-        // ==============
-
-
-        void createInstance();              // First step - establishes Vulkan API connection
-        void createDebugMessenger();        // Set up early for debugging during setup
-        void createSurface();               // Window surface needed for device selection
+        // Devices that passed scoring, best first
+        std::vector<std::shared_ptr<PhysicalDevice>> m_candidates;
+        bool m_needsSwapchain = false;
 
-        void pickPhysicalDevice();          // Select suitable GPU
-        void createLogicalDevice();         // Logical device and queues
+        bool createDebugMessenger();        // Set up early for debugging during setup
 
         // Vulkan Rendering
 
@@ -200,6 +279,7 @@ namespace Trin::Runtime::Core {
         // ==============
 
         static std::vector<const char*> getRequiredExtensions();
+        static bool isLayerAvailable(const char *layer);
     };
 
 }
@@ -0,0 +1,83 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Trin::Runtime::Memory {
+    namespace {
+        constexpr size_t kBlockAlignment = 64;
+
+        std::byte *allocateBlock(size_t capacity) {
+            return static_cast<std::byte *>(::operator new(capacity, std::align_val_t{kBlockAlignment}));
+        }
+
+        void freeBlock(std::byte *block) {
+            ::operator delete(block, std::align_val_t{kBlockAlignment});
+        }
+    }
+
+    FrameArena::FrameArena(size_t capacity, MemoryTag tag) : m_capacity(capacity), m_tag(tag) {
+        m_block = allocateBlock(m_capacity);
+    }
+
+    FrameArena::~FrameArena() {
+        reset();
+        freeBlock(m_block);
+    }
+
+    void *FrameArena::allocateBytes(size_t size, size_t alignment) {
+        size_t offset = m_offset.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto base = reinterpret_cast<uintptr_t>(m_block);
+            const size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+            const size_t end = aligned + size;
+            if (end > m_capacity) {
+                return allocateOverflow(size, alignment);
+            }
+            if (m_offset.compare_exchange_weak(offset, end, std::memory_order_relaxed)) {
+                m_allocations.fetch_add(1, std::memory_order_relaxed);
+                // Charge the padding too, so the spans add up to exactly the offset reset() frees
+                MemoryTracker::onAllocate(m_tag, end - offset);
+                return m_block + aligned;
+            }
+        }
+    }
+
+    void FrameArena::reset() {
+        const size_t used = m_offset.load(std::memory_order_relaxed);
+        m_highWater = std::max(m_highWater, used + m_overflowBytes);
+        MemoryTracker::onFree(m_tag, used, m_allocations.load(std::memory_order_relaxed));
+
+        for (const Overflow &overflow : m_overflow) {
+            ::operator delete(overflow.memory, std::align_val_t{overflow.alignment});
+            MemoryTracker::onFree(m_tag, overflow.size);
+        }
+
+        // Grow so next frame fits in the block, with some headroom for frame to frame variation
+        if (m_overflowBytes > 0) {
+            freeBlock(m_block);
+            m_capacity = (used + m_overflowBytes) * 3 / 2;
+            m_block = allocateBlock(m_capacity);
+        }
+
+        m_overflow.clear();
+        m_overflowBytes = 0;
+        m_offset.store(0, std::memory_order_relaxed);
+        m_allocations.store(0, std::memory_order_relaxed);
+    }
+
+    void *FrameArena::allocateOverflow(size_t size, size_t alignment) {
+        alignment = std::max(alignment, alignof(std::max_align_t));
+        void *memory = ::operator new(size, std::align_val_t{alignment});
+
+        std::lock_guard lock(m_overflowMutex);
+        m_overflow.push_back({memory, size, alignment});
+        m_overflowBytes += size + alignment;
+        MemoryTracker::onAllocate(m_tag, size);
+        return memory;
+    }
+}
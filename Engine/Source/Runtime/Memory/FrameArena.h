@@ -0,0 +1,107 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "MemoryTracker.h"
+
+namespace Trin::Runtime::Memory {
+/**
+ * Linear allocator for data that only lives until the end of the frame.
+ *
+ * Allocation is a bump of an atomic offset, so jobs can allocate from it too. Nothing is
+ * freed individually, reset() drops everything at once. When a frame needs more than the
+ * block holds the extra requests fall back to the heap and the block is grown on the next
+ * reset, so after a few frames the arena settles at the size the game actually needs.
+ *
+ * Doubles as a std::pmr::memory_resource, so std::pmr containers can be pointed at it.
+ */
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Reserves the backing block
+     * @param capacity Initial size of the block in bytes
+     * @param tag Tag the allocations are charged to in the MemoryTracker
+     */
+    explicit FrameArena(size_t capacity = 4 * 1024 * 1024, MemoryTag tag = MemoryTag::Frame);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * @brief Grabs memory that stays valid until the next reset()
+     * @param size Number of bytes
+     * @param alignment Power of two alignment
+     */
+    void *allocateBytes(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /// Constructs an object in the arena, its destructor is never run so it must not need one
+    template<typename T, typename... Args>
+    T *create(Args &&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        return new (allocateBytes(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /// Uninitialized array that stays valid until the next reset()
+    template<typename T>
+    T *allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        return static_cast<T *>(allocateBytes(sizeof(T) * count, alignof(T)));
+    }
+
+    /// Releases everything allocated since the last reset, call once the frame is done with it
+    void reset();
+
+    [[nodiscard]] size_t getUsed() const { return m_offset.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t getCapacity() const { return m_capacity; }
+    [[nodiscard]] size_t getHighWater() const { return m_highWater; }
+
+    /// Heap allocations made this frame because the block ran out
+    [[nodiscard]] size_t getOverflowCount() const { return m_overflow.size(); }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        return allocateBytes(bytes, alignment);
+    }
+
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    void *allocateOverflow(size_t size, size_t alignment);
+
+    struct Overflow {
+        void *memory;
+        size_t size;
+        size_t alignment;
+    };
+
+    std::byte *m_block = nullptr;
+    size_t m_capacity = 0;
+    std::atomic<size_t> m_offset{0};
+    std::atomic<size_t> m_allocations{0};
+    size_t m_highWater = 0;
+    MemoryTag m_tag;
+
+    std::mutex m_overflowMutex;
+    std::vector<Overflow> m_overflow;
+    size_t m_overflowBytes = 0;
+};
+
+}
+
+#endif //FRAMEARENA_H
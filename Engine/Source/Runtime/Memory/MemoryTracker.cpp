@@ -0,0 +1,56 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "MemoryTracker.h"
+
+#include <cstdio>
+#include <string>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Memory {
+    MemoryTracker::Counters MemoryTracker::sm_counters[static_cast<size_t>(MemoryTag::Count)];
+
+    MemoryTagStats MemoryTracker::get(MemoryTag tag) {
+        const Counters &counters = sm_counters[static_cast<size_t>(tag)];
+        MemoryTagStats stats;
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+        stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    const char *MemoryTracker::tagName(MemoryTag tag) {
+        switch (tag) {
+            case MemoryTag::General: return "General";
+            case MemoryTag::Frame: return "Frame";
+            case MemoryTag::Scene: return "Scene";
+            case MemoryTag::Render: return "Render";
+            case MemoryTag::Asset: return "Asset";
+            case MemoryTag::Script: return "Script";
+            case MemoryTag::Physics: return "Physics";
+            case MemoryTag::Animation: return "Animation";
+            default: return "Unknown";
+        }
+    }
+
+    void MemoryTracker::report() {
+        Helpers::Console::print("Memory by tag (live bytes / peak bytes / live allocations / total allocations)");
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); i++) {
+            const auto tag = static_cast<MemoryTag>(i);
+            const MemoryTagStats stats = get(tag);
+            if (stats.totalAllocations == 0) {
+                continue;
+            }
+            char line[160];
+            std::snprintf(line, sizeof(line), "  %-10s %12llu %12llu %10llu %12llu", tagName(tag),
+                          static_cast<unsigned long long>(stats.liveBytes),
+                          static_cast<unsigned long long>(stats.peakBytes),
+                          static_cast<unsigned long long>(stats.liveAllocations),
+                          static_cast<unsigned long long>(stats.totalAllocations));
+            Helpers::Console::print(line);
+        }
+    }
+}
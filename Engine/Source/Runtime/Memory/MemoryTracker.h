@@ -0,0 +1,96 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Tracking costs a couple of relaxed atomics per allocation, define as 0 to compile it out
+#ifndef TRIN_MEMORY_TRACKING
+#define TRIN_MEMORY_TRACKING 1
+#endif
+
+namespace Trin::Runtime::Memory {
+    enum class MemoryTag : uint8_t {
+        General,
+        Frame,
+        Scene,
+        Render,
+        Asset,
+        Script,
+        Physics,
+        Animation,
+        Count
+    };
+
+    struct MemoryTagStats {
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t liveAllocations = 0;
+        uint64_t totalAllocations = 0;   // Every allocation ever made with this tag
+    };
+
+class MemoryTracker {
+public:
+    /**
+     * @brief Records memory handed out by one of the engine allocators
+     * @param tag Subsystem the memory is charged to
+     * @param bytes Size of the allocation
+     */
+    static void onAllocate(MemoryTag tag, size_t bytes) {
+#if TRIN_MEMORY_TRACKING
+        Counters &counters = sm_counters[static_cast<size_t>(tag)];
+        const uint64_t live = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+#else
+        (void)tag;
+        (void)bytes;
+#endif
+    }
+
+    /**
+     * @brief Records memory given back to an engine allocator
+     * @param tag Subsystem the memory was charged to
+     * @param bytes Total size being released
+     * @param count Number of allocations being released, more than one when an arena resets
+     */
+    static void onFree(MemoryTag tag, size_t bytes, size_t count = 1) {
+#if TRIN_MEMORY_TRACKING
+        Counters &counters = sm_counters[static_cast<size_t>(tag)];
+        counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(count, std::memory_order_relaxed);
+#else
+        (void)tag;
+        (void)bytes;
+        (void)count;
+#endif
+    }
+
+    [[nodiscard]] static MemoryTagStats get(MemoryTag tag);
+    [[nodiscard]] static const char *tagName(MemoryTag tag);
+
+    /// Prints a table of every tag that has seen an allocation
+    static void report();
+
+private:
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> liveBytes{0};
+        std::atomic<uint64_t> peakBytes{0};
+        std::atomic<uint64_t> liveAllocations{0};
+        std::atomic<uint64_t> totalAllocations{0};
+    };
+
+    static Counters sm_counters[static_cast<size_t>(MemoryTag::Count)];
+};
+
+}
+
+#endif //MEMORYTRACKER_H
@@ -0,0 +1,173 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "PoolAllocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Trin::Runtime::Memory {
+    // Header is padded so the first block keeps 64 byte alignment
+    static constexpr size_t kChunkHeaderSize = 64;
+
+    FixedPool::FixedPool(uint32_t blockSize)
+        : m_blockSize(std::max<uint32_t>(blockSize, sizeof(FreeBlock))), m_owner(std::this_thread::get_id()) {}
+
+    FixedPool::~FixedPool() {
+        while (m_chunks) {
+            ChunkHeader *next = m_chunks->next;
+            ::operator delete(m_chunks, std::align_val_t{kChunkSize});
+            m_chunks = next;
+        }
+    }
+
+    void *FixedPool::allocate() {
+        if (!m_free) {
+            // Take back everything other threads returned before paying for a new chunk
+            m_free = m_remoteFree.exchange(nullptr, std::memory_order_acquire);
+            if (!m_free) {
+                grow();
+            }
+        }
+        FreeBlock *block = m_free;
+        m_free = block->next;
+        return block;
+    }
+
+    void FixedPool::deallocate(void *block) {
+        auto *freed = static_cast<FreeBlock *>(block);
+        if (std::this_thread::get_id() == m_owner.load(std::memory_order_acquire)) {
+            freed->next = m_free;
+            m_free = freed;
+            return;
+        }
+
+        // Only the owner ever pops, and it takes the whole list at once, so a plain push is ABA safe
+        FreeBlock *head = m_remoteFree.load(std::memory_order_relaxed);
+        do {
+            freed->next = head;
+        } while (!m_remoteFree.compare_exchange_weak(head, freed, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    FixedPool *FixedPool::owner(void *block) {
+        const auto address = reinterpret_cast<uintptr_t>(block);
+        return reinterpret_cast<ChunkHeader *>(address & ~(kChunkSize - 1))->pool;
+    }
+
+    void FixedPool::grow() {
+        auto *chunk = static_cast<std::byte *>(::operator new(kChunkSize, std::align_val_t{kChunkSize}));
+        auto *header = reinterpret_cast<ChunkHeader *>(chunk);
+        header->pool = this;
+        header->next = m_chunks;
+        m_chunks = header;
+
+        // Thread the fresh blocks onto the free list, lowest address first
+        const size_t blockCount = (kChunkSize - kChunkHeaderSize) / m_blockSize;
+        std::byte *first = chunk + kChunkHeaderSize;
+        for (size_t i = blockCount; i-- > 0;) {
+            auto *block = reinterpret_cast<FreeBlock *>(first + i * m_blockSize);
+            block->next = m_free;
+            m_free = block;
+        }
+    }
+
+    namespace {
+        constexpr size_t kSizeClasses = 6;     // 16, 32, 64, 128, 256, 512
+
+        size_t sizeClass(size_t size) {
+            return size <= 16 ? 0 : static_cast<size_t>(std::bit_width(size - 1)) - 4;
+        }
+
+        struct PoolSet {
+            std::unique_ptr<FixedPool> pools[kSizeClasses];
+
+            PoolSet() {
+                for (size_t i = 0; i < kSizeClasses; i++) {
+                    pools[i] = std::make_unique<FixedPool>(16u << i);
+                }
+            }
+        };
+
+        // Sets left behind by exited threads, kept alive because their blocks may still be in use
+        std::mutex g_parkedMutex;
+        std::vector<PoolSet *> g_parkedSets;
+
+        struct ThreadPoolSet {
+            PoolSet *set = nullptr;
+
+            PoolSet &get() {
+                if (!set) {
+                    {
+                        std::lock_guard lock(g_parkedMutex);
+                        if (!g_parkedSets.empty()) {
+                            set = g_parkedSets.back();
+                            g_parkedSets.pop_back();
+                        }
+                    }
+                    if (!set) {
+                        set = new PoolSet();
+                    }
+                    for (auto &pool : set->pools) {
+                        pool->adopt(std::this_thread::get_id());
+                    }
+                }
+                return *set;
+            }
+
+            ~ThreadPoolSet() {
+                if (set) {
+                    // Must happen while this thread still exists, before its id can be handed out again
+                    for (auto &pool : set->pools) {
+                        pool->park();
+                    }
+                    std::lock_guard lock(g_parkedMutex);
+                    g_parkedSets.push_back(set);
+                }
+            }
+        };
+
+        thread_local ThreadPoolSet t_pools;
+    }
+
+    void *ThreadPools::allocate(size_t size, MemoryTag tag) {
+        if (size > kMaxBlockSize) {
+            MemoryTracker::onAllocate(tag, size);
+            return ::operator new(size);
+        }
+        const size_t index = sizeClass(size);
+        MemoryTracker::onAllocate(tag, 16u << index);
+        return t_pools.get().pools[index]->allocate();
+    }
+
+    void ThreadPools::deallocate(void *block, size_t size, MemoryTag tag) {
+        if (size > kMaxBlockSize) {
+            MemoryTracker::onFree(tag, size);
+            ::operator delete(block);
+            return;
+        }
+        MemoryTracker::onFree(tag, 16u << sizeClass(size));
+        FixedPool::owner(block)->deallocate(block);
+    }
+
+    void *PoolResource::do_allocate(size_t bytes, size_t alignment) {
+        if (alignment > alignof(std::max_align_t)) {
+            MemoryTracker::onAllocate(m_tag, bytes);
+            return ::operator new(bytes, std::align_val_t{alignment});
+        }
+        return ThreadPools::allocate(bytes, m_tag);
+    }
+
+    void PoolResource::do_deallocate(void *block, size_t bytes, size_t alignment) {
+        if (alignment > alignof(std::max_align_t)) {
+            MemoryTracker::onFree(m_tag, bytes);
+            ::operator delete(block, std::align_val_t{alignment});
+            return;
+        }
+        ThreadPools::deallocate(block, bytes, m_tag);
+    }
+}
@@ -0,0 +1,111 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef POOLALLOCATOR_H
+#define POOLALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+
+#include "MemoryTracker.h"
+
+namespace Trin::Runtime::Memory {
+/**
+ * Free list of equally sized blocks carved out of 64KB chunks.
+ *
+ * A pool belongs to one thread, which allocates and frees without any synchronization.
+ * Other threads may free into it as well, those blocks go onto a lock free list that the
+ * owner takes back the next time it runs dry. Chunks are aligned to their size so the
+ * owning pool of any block can be found from the pointer alone.
+ *
+ * A parked pool has no owner at all, so every free goes through the lock free list. Thread
+ * ids are recycled once a thread exits, keeping the old id would let a new thread that
+ * happens to get it push onto the owner's list while the adopting thread pops from it.
+ *
+ * Pools do no tracking of their own, ThreadPools charges each block to the caller's tag.
+ */
+class FixedPool {
+public:
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    explicit FixedPool(uint32_t blockSize);
+    ~FixedPool();
+
+    FixedPool(const FixedPool &) = delete;
+    FixedPool &operator=(const FixedPool &) = delete;
+
+    /// Only the owning thread may call this
+    void *allocate();
+
+    /// Safe from any thread
+    void deallocate(void *block);
+
+    /// Pool a block came from, the block must have been handed out by a FixedPool
+    static FixedPool *owner(void *block);
+
+    void adopt(std::thread::id owner) { m_owner.store(owner, std::memory_order_release); }
+
+    /// Drops the owner, called by the owning thread before the pool is left for another to adopt
+    void park() { m_owner.store(std::thread::id(), std::memory_order_release); }
+    [[nodiscard]] uint32_t getBlockSize() const { return m_blockSize; }
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct ChunkHeader {
+        FixedPool *pool;
+        ChunkHeader *next;
+    };
+
+    void grow();
+
+    uint32_t m_blockSize;
+    std::atomic<std::thread::id> m_owner;
+
+    FreeBlock *m_free = nullptr;
+    std::atomic<FreeBlock *> m_remoteFree{nullptr};
+    ChunkHeader *m_chunks = nullptr;
+};
+
+/**
+ * Per thread set of FixedPools for small allocations, 16 to 512 bytes.
+ *
+ * Each thread lazily gets its own pools on first use. When a thread exits its pools are
+ * parked rather than destroyed, since blocks from them may still be alive elsewhere, and
+ * the next new thread picks them up.
+ */
+class ThreadPools {
+public:
+    static constexpr size_t kMaxBlockSize = 512;
+
+    /// Larger requests fall through to the global heap
+    static void *allocate(size_t size, MemoryTag tag = MemoryTag::General);
+    static void deallocate(void *block, size_t size, MemoryTag tag = MemoryTag::General);
+};
+
+/// std::pmr adapter over ThreadPools, for containers of small nodes like maps and lists
+class PoolResource final : public std::pmr::memory_resource {
+public:
+    explicit PoolResource(MemoryTag tag = MemoryTag::General) : m_tag(tag) {}
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *block, size_t bytes, size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        // Every PoolResource frees through the same thread pools, so they are interchangeable
+        return dynamic_cast<const PoolResource *>(&other) != nullptr;
+    }
+
+    MemoryTag m_tag;
+};
+
+}
+
+#endif //POOLALLOCATOR_H
@@ -0,0 +1,221 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Memory {
+/**
+ * 64 bit reference into a SlotMap, a 32 bit slot index and a 32 bit generation.
+ *
+ * Tag only exists to make handles of different resource kinds distinct types, so a
+ * Handle<BufferTag> can't be passed where a Handle<ImageTag> is expected. Generations
+ * start at 1, which keeps a default constructed handle invalid everywhere.
+ */
+template<typename Tag>
+class Handle {
+public:
+    static constexpr uint32_t kMaxIndex = UINT32_MAX - 1;     // UINT32_MAX marks an empty slot link
+    static constexpr uint32_t kMaxGeneration = UINT32_MAX;
+
+    constexpr Handle() = default;
+    constexpr Handle(uint32_t index, uint32_t generation) : m_index(index), m_generation(generation) {}
+
+    [[nodiscard]] constexpr uint32_t index() const { return m_index; }
+    [[nodiscard]] constexpr uint32_t generation() const { return m_generation; }
+    [[nodiscard]] constexpr uint64_t value() const { return static_cast<uint64_t>(m_generation) << 32 | m_index; }
+    [[nodiscard]] constexpr bool valid() const { return m_generation != 0; }
+
+    constexpr bool operator==(const Handle &other) const { return value() == other.value(); }
+    constexpr bool operator!=(const Handle &other) const { return value() != other.value(); }
+
+private:
+    uint32_t m_index = 0;
+    uint32_t m_generation = 0;
+};
+
+/**
+ * Dense storage addressed through generational handles.
+ *
+ * Values sit packed in one array, so iterating every live value is a linear walk, and a
+ * sparse slot array maps each handle's index to the value's current position. Destroying
+ * swaps the last value into the hole and bumps the slot's generation, so every handle still
+ * pointing at it stops resolving. With 32 bits of generation a slot takes four billion
+ * reuses to run out, after which it is retired for good rather than wrap around and revive
+ * stale handles.
+ *
+ * GPU resources can't be destroyed while a frame in flight may still use them, release()
+ * invalidates the handle right away but parks the value until collect() is told that frame
+ * finished on the GPU.
+ *
+ * get(), destroy() and release() check the handle and fail on a stale one in every build.
+ * resolve() assumes the handle is live, debug builds report a stale handle there and abort,
+ * the same way a use-after-free would surface under ASan.
+ */
+template<typename T, typename Tag = T>
+class SlotMap {
+public:
+    using HandleType = Handle<Tag>;
+
+    /// Builds a value in place and returns its handle, invalid when every index is in use
+    template<typename... Args>
+    HandleType create(Args &&...args) {
+        uint32_t index;
+        if (m_freeHead != kNoSlot) {
+            index = m_freeHead;
+            m_freeHead = m_slots[index].dense;
+        } else {
+            if (m_slots.size() > HandleType::kMaxIndex) {
+                Helpers::Console::error("SlotMap is full");
+                return {};
+            }
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({kNoSlot, 1});
+        }
+
+        Slot &slot = m_slots[index];
+        slot.dense = static_cast<uint32_t>(m_values.size());
+        m_values.emplace_back(std::forward<Args>(args)...);
+        m_denseToSlot.push_back(index);
+        return {index, slot.generation};
+    }
+
+    /// Destroys the value now, false when the handle was already stale
+    bool destroy(HandleType handle) {
+        if (!isLive(handle)) {
+            return false;
+        }
+        removeDense(handle.index());
+        freeSlot(handle.index());
+        return true;
+    }
+
+    /**
+     * @brief Invalidates the handle now and keeps the value alive until the GPU is done with it
+     * @param handle Value to release
+     * @param frame Frame being recorded, the last one that may reference the value
+     * @return False when the handle was already stale
+     */
+    bool release(HandleType handle, uint64_t frame) {
+        if (!isLive(handle)) {
+            return false;
+        }
+        const uint32_t dense = m_slots[handle.index()].dense;
+        m_retired.push_back({frame, std::move(m_values[dense])});
+        removeDense(handle.index());
+        freeSlot(handle.index());
+        return true;
+    }
+
+    /**
+     * @brief Hands every released value whose frame the GPU finished to destroyFn, then drops it
+     * @param completedFrame Latest frame whose fence has signaled
+     * @param destroyFn Called with each value, for example to vkDestroyBuffer it
+     */
+    template<typename Fn>
+    void collect(uint64_t completedFrame, Fn &&destroyFn) {
+        // Frames only go up, so the queue is already in retirement order
+        while (!m_retired.empty() && m_retired.front().frame <= completedFrame) {
+            destroyFn(m_retired.front().value);
+            m_retired.pop_front();
+        }
+    }
+
+    /// Value for a handle, nullptr when it was destroyed or released
+    [[nodiscard]] T *get(HandleType handle) {
+        return isLive(handle) ? &m_values[m_slots[handle.index()].dense] : nullptr;
+    }
+
+    [[nodiscard]] const T *get(HandleType handle) const {
+        return isLive(handle) ? &m_values[m_slots[handle.index()].dense] : nullptr;
+    }
+
+    /// Unchecked in release builds, debug builds abort on a stale handle
+    [[nodiscard]] T &resolve(HandleType handle) {
+#ifndef NDEBUG
+        if (!isLive(handle)) {
+            Helpers::Console::error("SlotMap::resolve on stale handle, index " + std::to_string(handle.index()) +
+                                    " generation " + std::to_string(handle.generation()));
+            std::abort();
+        }
+#endif
+        return m_values[m_slots[handle.index()].dense];
+    }
+
+    [[nodiscard]] bool isLive(HandleType handle) const {
+        const uint32_t index = handle.index();
+        // Free slots already carry the next generation, retired ones are told apart by having no value
+        return handle.valid() && index < m_slots.size() && m_slots[index].generation == handle.generation() &&
+               m_slots[index].dense != kNoSlot;
+    }
+
+    [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_values.size()); }
+    [[nodiscard]] uint32_t getRetiredCount() const { return static_cast<uint32_t>(m_retired.size()); }
+
+    /// Packed live values, in no particular order
+    [[nodiscard]] std::vector<T> &values() { return m_values; }
+    [[nodiscard]] const std::vector<T> &values() const { return m_values; }
+
+    /// Handle of the value at a position in values()
+    [[nodiscard]] HandleType handleAt(uint32_t dense) const {
+        const uint32_t index = m_denseToSlot[dense];
+        return {index, m_slots[index].generation};
+    }
+
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Slot {
+        uint32_t dense;         // Position in m_values, or the next free slot while free
+        uint32_t generation;
+    };
+
+    struct Retired {
+        uint64_t frame;
+        T value;
+    };
+
+    void removeDense(uint32_t index) {
+        const uint32_t dense = m_slots[index].dense;
+        const uint32_t last = static_cast<uint32_t>(m_values.size()) - 1;
+        if (dense != last) {
+            m_values[dense] = std::move(m_values[last]);
+            m_denseToSlot[dense] = m_denseToSlot[last];
+            m_slots[m_denseToSlot[dense]].dense = dense;
+        }
+        m_values.pop_back();
+        m_denseToSlot.pop_back();
+    }
+
+    void freeSlot(uint32_t index) {
+        Slot &slot = m_slots[index];
+        slot.dense = kNoSlot;
+        if (slot.generation == HandleType::kMaxGeneration) {
+            // Out of generations, leaking the index beats handing a stale handle a new value
+            return;
+        }
+        slot.generation++;
+        slot.dense = m_freeHead;
+        m_freeHead = index;
+    }
+
+    std::vector<T> m_values;
+    std::vector<uint32_t> m_denseToSlot;
+    std::vector<Slot> m_slots;
+    uint32_t m_freeHead = kNoSlot;
+    std::deque<Retired> m_retired;
+};
+
+}
+
+#endif //SLOTMAP_H
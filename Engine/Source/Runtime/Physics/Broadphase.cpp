@@ -0,0 +1,413 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "Broadphase.h"
+
+#include <bit>
+#include <cmath>
+
+#include "Math/Simd.h"
+
+namespace Trin::Runtime::Physics {
+    using Simd::Float4;
+
+    namespace {
+        float component(const Vector3 &v, uint32_t axis) {
+            return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+        }
+
+        uint64_t pairKey(BroadphaseProxy a, BroadphaseProxy b) {
+            return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+        }
+
+        uint64_t pairKey(const BroadphasePair &pair) {
+            return (static_cast<uint64_t>(pair.a) << 32) | pair.b;
+        }
+
+        /// Flips the float's bits so that unsigned order matches float order
+        uint32_t orderedBits(float value) {
+            const uint32_t bits = std::bit_cast<uint32_t>(value);
+            return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+        }
+
+        /// Runs fn over [0, count) on the pool, or right here without one
+        void forEach(Core::JobSystem *jobs, uint32_t count, const std::function<void(uint32_t, uint32_t)> &fn) {
+            if (jobs) {
+                jobs->parallelFor(count, 1, fn);
+            } else {
+                fn(0, count);
+            }
+        }
+    }
+
+    BroadphaseProxy Broadphase::add(const AABB &bounds, uint32_t userData) {
+        BroadphaseProxy proxy;
+        if (!m_freeProxies.empty()) {
+            proxy = m_freeProxies.back();
+            m_freeProxies.pop_back();
+            m_bounds[proxy] = bounds;
+            m_userData[proxy] = userData;
+            m_alive[proxy] = 1;
+        } else {
+            proxy = static_cast<BroadphaseProxy>(m_bounds.size());
+            m_bounds.push_back(bounds);
+            m_userData.push_back(userData);
+            m_alive.push_back(1);
+        }
+        m_order.push_back({component(bounds.min, m_axis), proxy});
+        m_addedSinceSort++;
+        m_liveProxies++;
+        return proxy;
+    }
+
+    void Broadphase::remove(BroadphaseProxy proxy) {
+        m_alive[proxy] = 0;
+        m_removedProxies.push_back(proxy);
+        m_liveProxies--;
+    }
+
+    void Broadphase::updatePairs(Core::JobSystem *jobs) {
+        m_stats = {};
+        m_stats.axis = m_axis;
+        m_stats.bandAxis = m_bandAxis;
+        m_stats.bands = m_bandCount;
+        sortProxies(jobs);
+        fillBands(jobs);
+        m_stats.bandSlots = m_bandStart[m_bandCount];
+
+        m_tasks.clear();
+        for (uint32_t band = 0; band < m_bandCount; band++) {
+            for (uint32_t begin = m_bandStart[band]; begin < m_bandStart[band + 1]; begin += kSweepBlock) {
+                m_tasks.push_back({band, begin, std::min(m_bandStart[band + 1], begin + kSweepBlock)});
+            }
+        }
+        m_taskPairs.resize(m_tasks.size());
+        forEach(jobs, static_cast<uint32_t>(m_tasks.size()), [this](uint32_t begin, uint32_t end) {
+            for (uint32_t task = begin; task < end; task++) {
+                m_taskPairs[task].clear();
+                sweep(m_tasks[task], m_taskPairs[task]);
+            }
+        });
+
+        collectPairs();
+        reportChanges();
+        chooseAxes();
+
+        // Nothing refers to these any more, the narrowphase has heard their pairs are gone
+        m_freeProxies.insert(m_freeProxies.end(), m_removedProxies.begin(), m_removedProxies.end());
+        m_removedProxies.clear();
+
+        m_stats.proxies = m_liveProxies;
+        m_stats.pairs = static_cast<uint32_t>(m_pairs.size());
+    }
+
+    void Broadphase::sortProxies(Core::JobSystem *jobs) {
+        // Refresh the keys and drop removed boxes, the order from last frame is kept. This is the
+        // only gather from m_bounds, the boxes travel with the order from here on
+        m_sortedBounds.resize(m_order.size());
+        size_t live = 0;
+        for (const SortEntry &entry : m_order) {
+            if (m_alive[entry.proxy]) {
+                const AABB &bounds = m_sortedBounds[live] = m_bounds[entry.proxy];
+                m_order[live++] = {component(bounds.min, m_axis), entry.proxy};
+            }
+        }
+        m_order.resize(live);
+        m_sortedBounds.resize(live);
+
+        // Ties go by proxy, the pairs come out sorted so any tie order would give the same result
+        const auto less = [](const SortEntry &a, const SortEntry &b) {
+            return a.min < b.min || (a.min == b.min && a.proxy < b.proxy);
+        };
+
+        bool full = m_needsFullSort || m_fullSortFrames > 0 || static_cast<size_t>(m_addedSinceSort) * 8 > live;
+        if (m_fullSortFrames > 0) {
+            m_fullSortFrames--;
+        }
+        if (!full) {
+            // The radix sort makes eight passes over the keys, past a few moves per box it is cheaper
+            const uint64_t budget = live * 8 + 1024;
+            uint64_t swaps = 0;
+            for (size_t i = 1; i < live && !full; i++) {
+                const SortEntry entry = m_order[i];
+                const AABB bounds = m_sortedBounds[i];
+                size_t j = i;
+                while (j > 0 && less(entry, m_order[j - 1])) {
+                    m_order[j] = m_order[j - 1];
+                    m_sortedBounds[j] = m_sortedBounds[j - 1];
+                    j--;
+                    if (++swaps > budget) {
+                        // Motion this fast usually lasts, skip straight to the full sort for a while
+                        full = true;
+                        m_fullSortFrames = kFullSortFrames;
+                        break;
+                    }
+                }
+                m_order[j] = entry;
+                m_sortedBounds[j] = bounds;
+            }
+            m_stats.swaps = static_cast<uint32_t>(std::min<uint64_t>(swaps, UINT32_MAX));
+        }
+        if (full) {
+            m_sortKeys.resize(live);
+            m_sortValues.resize(live);
+            for (size_t i = 0; i < live; i++) {
+                m_sortKeys[i] = orderedBits(m_order[i].min);
+                m_sortValues[i] = static_cast<uint32_t>(i);
+            }
+            m_radixSort.sort(m_sortKeys, m_sortValues, jobs);
+            // Boxes mostly land near where they were, so these gathers stay close to sequential
+            m_sortScratch.resize(live);
+            m_boundsScratch.resize(live);
+            for (size_t i = 0; i < live; i++) {
+                m_sortScratch[i] = m_order[m_sortValues[i]];
+                m_boundsScratch[i] = m_sortedBounds[m_sortValues[i]];
+            }
+            std::swap(m_order, m_sortScratch);
+            std::swap(m_sortedBounds, m_boundsScratch);
+            m_stats.resorted = true;
+        }
+        m_needsFullSort = false;
+        m_addedSinceSort = 0;
+    }
+
+    void Broadphase::fillBands(Core::JobSystem *jobs) {
+        const auto count = static_cast<uint32_t>(m_order.size());
+        const uint32_t blockCount = (count + kSweepBlock - 1) / kSweepBlock;
+        const uint32_t axisA = m_bandAxis;
+        const uint32_t axisB = 3 - m_axis - m_bandAxis;
+        m_blockStats.resize(blockCount);
+        m_blockBandOffsets.assign(static_cast<size_t>(blockCount) * m_bandCount, 0);
+
+        // Count what every block puts in every band, and measure the spread for the next update
+        forEach(jobs, blockCount, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t block = begin; block < end; block++) {
+                BlockStats &stats = m_blockStats[block];
+                stats = {};
+                std::fill(std::begin(stats.low), std::end(stats.low), INFINITY);
+                std::fill(std::begin(stats.high), std::end(stats.high), -INFINITY);
+                uint32_t *bandCounts = &m_blockBandOffsets[static_cast<size_t>(block) * m_bandCount];
+                const uint32_t last = std::min(count, (block + 1) * kSweepBlock);
+                for (uint32_t i = block * kSweepBlock; i < last; i++) {
+                    const AABB &bounds = m_sortedBounds[i];
+                    const uint32_t lastBand = bandOf(component(bounds.max, axisA));
+                    for (uint32_t band = bandOf(component(bounds.min, axisA)); band <= lastBand; band++) {
+                        bandCounts[band]++;
+                    }
+                    for (uint32_t axis = 0; axis < 3; axis++) {
+                        const float low = component(bounds.min, axis);
+                        const float high = component(bounds.max, axis);
+                        const double center = (static_cast<double>(low) + high) * 0.5;
+                        stats.sum[axis] += center;
+                        stats.sumSquares[axis] += center * center;
+                        stats.extent[axis] += high - low;
+                        stats.low[axis] = std::min(stats.low[axis], low);
+                        stats.high[axis] = std::max(stats.high[axis], high);
+                    }
+                }
+            }
+        });
+
+        // Bands follow each other, inside a band the blocks keep the sorted order
+        m_bandStart.resize(m_bandCount + 1);
+        uint32_t offset = 0;
+        for (uint32_t band = 0; band < m_bandCount; band++) {
+            m_bandStart[band] = offset;
+            for (uint32_t block = 0; block < blockCount; block++) {
+                uint32_t &entry = m_blockBandOffsets[static_cast<size_t>(block) * m_bandCount + band];
+                const uint32_t slots = entry;
+                entry = offset;
+                offset += slots;
+            }
+        }
+        m_bandStart[m_bandCount] = offset;
+
+        const size_t padded = static_cast<size_t>(offset) + kPadding;
+        for (auto *array : {&m_sweepMin, &m_sweepMax, &m_aMin, &m_aMax, &m_bMin, &m_bMax}) {
+            array->resize(padded);
+        }
+        m_slotProxy.resize(padded);
+        // Padding never overlaps anything, the sweep masks those lanes out anyway
+        for (size_t i = offset; i < padded; i++) {
+            m_sweepMin[i] = m_aMin[i] = m_bMin[i] = INFINITY;
+            m_sweepMax[i] = m_aMax[i] = m_bMax[i] = -INFINITY;
+            m_slotProxy[i] = kInvalidBroadphaseProxy;
+        }
+
+        forEach(jobs, blockCount, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t block = begin; block < end; block++) {
+                uint32_t *cursor = &m_blockBandOffsets[static_cast<size_t>(block) * m_bandCount];
+                const uint32_t last = std::min(count, (block + 1) * kSweepBlock);
+                for (uint32_t i = block * kSweepBlock; i < last; i++) {
+                    const BroadphaseProxy proxy = m_order[i].proxy;
+                    const AABB &bounds = m_sortedBounds[i];
+                    const float aMin = component(bounds.min, axisA);
+                    const float aMax = component(bounds.max, axisA);
+                    const uint32_t lastBand = bandOf(aMax);
+                    for (uint32_t band = bandOf(aMin); band <= lastBand; band++) {
+                        const uint32_t slot = cursor[band]++;
+                        m_sweepMin[slot] = m_order[i].min;
+                        m_sweepMax[slot] = component(bounds.max, m_axis);
+                        m_aMin[slot] = aMin;
+                        m_aMax[slot] = aMax;
+                        m_bMin[slot] = component(bounds.min, axisB);
+                        m_bMax[slot] = component(bounds.max, axisB);
+                        m_slotProxy[slot] = proxy;
+                    }
+                }
+            }
+        });
+    }
+
+    void Broadphase::chooseAxes() {
+        const size_t count = m_order.size();
+        if (count < 2) {
+            return;
+        }
+        BlockStats total{};
+        std::fill(std::begin(total.low), std::end(total.low), INFINITY);
+        std::fill(std::begin(total.high), std::end(total.high), -INFINITY);
+        for (const BlockStats &stats : m_blockStats) {
+            for (int axis = 0; axis < 3; axis++) {
+                total.sum[axis] += stats.sum[axis];
+                total.sumSquares[axis] += stats.sumSquares[axis];
+                total.extent[axis] += stats.extent[axis];
+                total.low[axis] = std::min(total.low[axis], stats.low[axis]);
+                total.high[axis] = std::max(total.high[axis], stats.high[axis]);
+            }
+        }
+        double variance[3], meanExtent[3], range[3];
+        for (int axis = 0; axis < 3; axis++) {
+            const double mean = total.sum[axis] / static_cast<double>(count);
+            variance[axis] = total.sumSquares[axis] / static_cast<double>(count) - mean * mean;
+            meanExtent[axis] = total.extent[axis] / static_cast<double>(count);
+            range[axis] = static_cast<double>(total.high[axis]) - total.low[axis];
+        }
+
+        // Switching costs a full sort, only do it for a clearly better spread
+        const auto best = static_cast<uint32_t>(std::max_element(variance, variance + 3) - variance);
+        if (best != m_axis && variance[best] > variance[m_axis] * 1.5) {
+            m_axis = best;
+            m_needsFullSort = true;
+        }
+
+        // Bands go across the wider of the two other axes, enough of them to bring the boxes one
+        // sweep passes over down to the target, while staying well wider than the boxes themselves
+        const uint32_t first = (m_axis + 1) % 3;
+        const uint32_t second = (m_axis + 2) % 3;
+        m_bandAxis = variance[first] >= variance[second] ? first : second;
+        double bands = 1.0;
+        if (range[m_axis] > 0.0 && range[m_bandAxis] > 0.0) {
+            const double candidates = static_cast<double>(count) * meanExtent[m_axis] / range[m_axis];
+            const double widest = range[m_bandAxis] / std::max(4.0 * meanExtent[m_bandAxis], 1e-6);
+            bands = std::clamp(std::min(std::ceil(candidates / kTargetCandidates), std::floor(widest)),
+                               1.0, static_cast<double>(kMaxBands));
+        }
+        m_bandCount = static_cast<uint32_t>(bands);
+        m_bandOrigin = total.low[m_bandAxis];
+        m_bandScale = m_bandCount > 1 ? static_cast<float>(bands / range[m_bandAxis]) : 0.0f;
+    }
+
+    void Broadphase::sweep(const SweepTask &task, std::vector<uint64_t> &out) const {
+        const uint32_t bandEnd = m_bandStart[task.band + 1];
+        const bool banded = m_bandCount > 1;
+        for (uint32_t i = task.begin; i < task.end; i++) {
+            const Float4 maxI(m_sweepMax[i]);
+            const Float4 aMinI(m_aMin[i]), aMaxI(m_aMax[i]);
+            const Float4 bMinI(m_bMin[i]), bMaxI(m_bMax[i]);
+            const BroadphaseProxy proxy = m_slotProxy[i];
+
+            // Everything after i starts at or past i's minimum, stop at the first one starting past its maximum
+            for (uint32_t j = i + 1; j < bandEnd; j += 4) {
+                int inRange = (Float4::loadu(&m_sweepMin[j]) <= maxI).mask();
+                if (bandEnd - j < 4) {
+                    inRange &= (1 << (bandEnd - j)) - 1;
+                }
+                const Float4 overlap = (Float4::loadu(&m_aMin[j]) <= aMaxI) & (Float4::loadu(&m_aMax[j]) >= aMinI) &
+                                       (Float4::loadu(&m_bMin[j]) <= bMaxI) & (Float4::loadu(&m_bMax[j]) >= bMinI);
+                auto hits = static_cast<uint32_t>(overlap.mask() & inRange);
+                while (hits) {
+                    const uint32_t other = j + std::countr_zero(hits);
+                    hits &= hits - 1;
+                    // Both boxes reach the larger minimum, its band is one they share
+                    if (banded && bandOf(std::max(m_aMin[i], m_aMin[other])) != task.band) {
+                        continue;
+                    }
+                    out.push_back(pairKey(proxy, m_slotProxy[other]));
+                }
+                if (inRange != 0xF) {
+                    break;
+                }
+            }
+        }
+    }
+
+    void Broadphase::collectPairs() {
+        std::swap(m_pairs, m_previousPairs);
+
+        // Counting sort on a, the tasks hold pairs in sweep order which changes every frame
+        m_pairCounts.assign(m_bounds.size() + 1, 0);
+        size_t total = 0;
+        for (const auto &pairs : m_taskPairs) {
+            for (const uint64_t key : pairs) {
+                m_pairCounts[key >> 32]++;
+            }
+            total += pairs.size();
+        }
+        uint32_t offset = 0;
+        for (uint32_t &entry : m_pairCounts) {
+            const uint32_t size = entry;
+            entry = offset;
+            offset += size;
+        }
+
+        m_pairs.resize(total);
+        for (const auto &pairs : m_taskPairs) {
+            for (const uint64_t key : pairs) {
+                m_pairs[m_pairCounts[key >> 32]++] = {static_cast<BroadphaseProxy>(key >> 32), static_cast<BroadphaseProxy>(key)};
+            }
+        }
+
+        // After the scatter every entry holds the end of its bucket, most buckets are a few pairs at most
+        uint32_t start = 0;
+        for (size_t a = 0; a + 1 < m_pairCounts.size(); a++) {
+            const uint32_t end = m_pairCounts[a];
+            for (uint32_t i = start + 1; i < end; i++) {
+                const BroadphasePair pair = m_pairs[i];
+                uint32_t j = i;
+                while (j > start && m_pairs[j - 1].b > pair.b) {
+                    m_pairs[j] = m_pairs[j - 1];
+                    j--;
+                }
+                m_pairs[j] = pair;
+            }
+            start = end;
+        }
+    }
+
+    void Broadphase::reportChanges() {
+        // Both lists are sorted, one merge finds what ended and what began
+        size_t previous = 0, current = 0;
+        while (previous < m_previousPairs.size() || current < m_pairs.size()) {
+            const uint64_t before = previous < m_previousPairs.size() ? pairKey(m_previousPairs[previous]) : UINT64_MAX;
+            const uint64_t after = current < m_pairs.size() ? pairKey(m_pairs[current]) : UINT64_MAX;
+            if (before == after) {
+                previous++;
+                current++;
+            } else if (before < after) {
+                m_stats.removed++;
+                if (m_pairRemoved) {
+                    m_pairRemoved(m_previousPairs[previous]);
+                }
+                previous++;
+            } else {
+                m_stats.added++;
+                if (m_pairAdded) {
+                    m_pairAdded(m_pairs[current]);
+                }
+                current++;
+            }
+        }
+    }
+}
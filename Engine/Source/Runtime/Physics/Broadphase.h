@@ -0,0 +1,203 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Math/Bounds.h"
+#include "Render/RadixSort.h"
+
+namespace Trin::Runtime::Physics {
+    using namespace Trin::Math;
+
+    using BroadphaseProxy = uint32_t;
+    constexpr BroadphaseProxy kInvalidBroadphaseProxy = std::numeric_limits<BroadphaseProxy>::max();
+
+    /// Two overlapping proxies, a is always the smaller one
+    struct BroadphasePair {
+        BroadphaseProxy a;
+        BroadphaseProxy b;
+    };
+
+    struct BroadphaseStats {
+        uint32_t proxies = 0;
+        uint32_t pairs = 0;
+        uint32_t added = 0;
+        uint32_t removed = 0;
+        uint32_t swaps = 0;         // Insertion sort moves, low while motion is coherent
+        uint32_t axis = 0;          // Sweep axis, 0, 1 or 2 for x, y or z
+        uint32_t bandAxis = 0;
+        uint32_t bands = 0;
+        uint32_t bandSlots = 0;     // Boxes summed over every band, above proxies when boxes straddle bands
+        bool resorted = false;      // Fell back to a full sort, after an axis change or a big jump
+    };
+
+/**
+ * Sweep and prune over axis aligned boxes.
+ *
+ * Boxes are kept sorted by their minimum on the axis their centres spread the most along.
+ * Bodies barely move between frames, so an insertion sort restores the order in close to
+ * linear time. When it would take more than a few moves per box, a radix sort takes over.
+ *
+ * On a wide map a single sweep would test every box against the whole slab it spans, so the
+ * sorted boxes are also split into bands along the second widest axis, sized from the last
+ * update's spread. Each band gets its own structure of arrays copy in sorted order and is swept
+ * four candidates per SIMD comparison, in fixed blocks spread over the job system. A pair of
+ * boxes sharing several bands is only reported by the band holding the larger of their minimums.
+ *
+ * The overlapping pairs are put in (a, b) order and diffed against the previous update, the
+ * pair callbacks fire in that same order. Results never depend on the thread count.
+ */
+class Broadphase {
+public:
+    using PairCallback = std::function<void(const BroadphasePair &pair)>;
+
+    /**
+     * @brief Adds a box, its pairs show up on the next updatePairs()
+     * @param bounds World space bounds of the body
+     * @param userData Value kept for the narrowphase, usually a body index
+     */
+    BroadphaseProxy add(const AABB &bounds, uint32_t userData);
+
+    /// Removes a box, the id is only reused after the next updatePairs() reported its pairs gone
+    void remove(BroadphaseProxy proxy);
+
+    void update(BroadphaseProxy proxy, const AABB &bounds) {
+        m_bounds[proxy] = bounds;
+    }
+
+    /// Called from updatePairs() on the calling thread, added for new pairs and removed for ended ones
+    void setPairCallbacks(PairCallback added, PairCallback removed) {
+        m_pairAdded = std::move(added);
+        m_pairRemoved = std::move(removed);
+    }
+
+    /**
+     * @brief Finds every overlapping pair and reports the changes since the last call
+     * @param jobs Pool to sweep on, nullptr sweeps on the calling thread
+     */
+    void updatePairs(Core::JobSystem *jobs = &Core::JobSystem::get());
+
+    /// Pairs found by the last updatePairs(), sorted by a then b
+    [[nodiscard]] const std::vector<BroadphasePair> &getPairs() const { return m_pairs; }
+    [[nodiscard]] const BroadphaseStats &getStats() const { return m_stats; }
+    [[nodiscard]] const AABB &getBounds(BroadphaseProxy proxy) const { return m_bounds[proxy]; }
+    [[nodiscard]] uint32_t getUserData(BroadphaseProxy proxy) const { return m_userData[proxy]; }
+    [[nodiscard]] uint32_t size() const { return m_liveProxies; }
+
+private:
+    struct SortEntry {
+        float min;
+        BroadphaseProxy proxy;
+    };
+
+    /// Spread of the boxes in one block of the sorted order, summed to pick the next axes
+    struct BlockStats {
+        double sum[3];
+        double sumSquares[3];
+        double extent[3];
+        float low[3];
+        float high[3];
+    };
+
+    /// Slots of one band to sweep, a single task never crosses a band
+    struct SweepTask {
+        uint32_t band;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    // Boxes per block and slots per sweep task, small enough to balance and large enough to keep the outputs few
+    static constexpr uint32_t kSweepBlock = 2048;
+    // Padding past the last slot so the four wide loads never run off the arrays
+    static constexpr uint32_t kPadding = 4;
+    static constexpr uint32_t kMaxBands = 256;
+    // Boxes a band's sweep should test each box against, sets the band count
+    static constexpr double kTargetCandidates = 16.0;
+    // Updates that skip the insertion sort after it ran out of budget
+    static constexpr uint32_t kFullSortFrames = 8;
+
+    [[nodiscard]] uint32_t bandOf(float value) const {
+        const float band = (value - m_bandOrigin) * m_bandScale;
+        if (!(band > 0.0f)) {
+            return 0;
+        }
+        return band >= static_cast<float>(m_bandCount - 1) ? m_bandCount - 1 : static_cast<uint32_t>(band);
+    }
+
+    void sortProxies(Core::JobSystem *jobs);
+    void fillBands(Core::JobSystem *jobs);
+    void chooseAxes();
+    void sweep(const SweepTask &task, std::vector<uint64_t> &out) const;
+    void collectPairs();
+    void reportChanges();
+
+    // ==============
+    //    PROXIES
+    // ==============
+
+    std::vector<AABB> m_bounds;
+    std::vector<uint32_t> m_userData;
+    std::vector<uint8_t> m_alive;
+    std::vector<BroadphaseProxy> m_freeProxies;
+    std::vector<BroadphaseProxy> m_removedProxies;      // Freed once their pairs were reported removed
+    uint32_t m_liveProxies = 0;
+
+    // ==============
+    //     SWEEP
+    // ==============
+
+    uint32_t m_axis = 0;
+    bool m_needsFullSort = false;                       // The axis changed, the old order is no help
+    uint32_t m_addedSinceSort = 0;                      // Appended unsorted at the end of m_order
+    uint32_t m_fullSortFrames = 0;                      // Updates left before trying the insertion sort again
+    std::vector<SortEntry> m_order;
+    std::vector<AABB> m_sortedBounds;                   // m_bounds in m_order's order, gathered once per update
+    std::vector<BlockStats> m_blockStats;
+
+    // Full sorts radix sort the minimums' bits, the values index the previous order
+    Render::RadixSort m_radixSort;
+    std::vector<uint64_t> m_sortKeys;
+    std::vector<uint32_t> m_sortValues;
+    std::vector<SortEntry> m_sortScratch;
+    std::vector<AABB> m_boundsScratch;
+
+    // Bands along m_bandAxis, picked from the previous update's spread
+    uint32_t m_bandAxis = 1;
+    uint32_t m_bandCount = 1;
+    float m_bandOrigin = 0.0f;
+    float m_bandScale = 0.0f;                           // Bands per unit
+    std::vector<uint32_t> m_bandStart;                  // First slot of each band, plus the total at the end
+    std::vector<uint32_t> m_blockBandOffsets;           // Slots per block and band, then where each block writes
+
+    // Every band's boxes in sorted order: the sweep axis, the band axis, then the remaining one
+    std::vector<float> m_sweepMin, m_sweepMax;
+    std::vector<float> m_aMin, m_aMax, m_bMin, m_bMax;
+    std::vector<BroadphaseProxy> m_slotProxy;
+
+    std::vector<SweepTask> m_tasks;
+    std::vector<std::vector<uint64_t>> m_taskPairs;    // (a << 32 | b) per sweep task
+    std::vector<uint32_t> m_pairCounts;
+
+    // ==============
+    //     PAIRS
+    // ==============
+
+    std::vector<BroadphasePair> m_pairs;
+    std::vector<BroadphasePair> m_previousPairs;
+    PairCallback m_pairAdded;
+    PairCallback m_pairRemoved;
+    BroadphaseStats m_stats;
+};
+
+}
+
+#endif //BROADPHASE_H
@@ -0,0 +1,62 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "DrawBatcher.h"
+
+#include <string>
+
+#include "Helpers/Console.h"
+
+namespace Trin::Runtime::Render {
+    bool DrawBatcher::add(const DrawItem &item) {
+        // build() indexes the mesh table with the id taken back out of the key, and an index too
+        // wide for its key field would be masked into some other draw's state
+        if (item.mesh >= m_meshes.size() || item.mesh >= 1u << DrawKey::kMeshBits ||
+            item.material >= 1u << DrawKey::kMaterialBits || item.pipeline >= 1u << DrawKey::kPipelineBits) {
+            Helpers::Console::error("DrawBatcher rejected object " + std::to_string(item.objectIndex) + ", mesh " +
+                                    std::to_string(item.mesh) + " material " + std::to_string(item.material) +
+                                    " pipeline " + std::to_string(item.pipeline) + " with " +
+                                    std::to_string(m_meshes.size()) + " meshes registered");
+            return false;
+        }
+        m_items.push_back(item);
+        return true;
+    }
+
+    void DrawBatcher::build(Core::JobSystem *jobs) {
+        const auto count = static_cast<uint32_t>(m_items.size());
+
+        m_keys.resize(count);
+        m_order.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            const DrawItem &item = m_items[i];
+            m_keys[i] = DrawKey::make(item.pipeline, item.material, item.mesh, item.depth);
+            m_order[i] = i;
+        }
+        m_sorter.sort(m_keys, m_order, jobs);
+
+        m_commands.clear();
+        m_groups.clear();
+        m_instances.resize(count);
+
+        for (uint32_t i = 0; i < count;) {
+            // Every run of equal pipeline, material and mesh becomes one instanced command
+            const uint64_t batch = DrawKey::batchBits(m_keys[i]);
+            const uint32_t first = i;
+            for (; i < count && DrawKey::batchBits(m_keys[i]) == batch; i++) {
+                m_instances[i] = m_items[m_order[i]].objectIndex;
+            }
+
+            const MeshRange &mesh = m_meshes[DrawKey::mesh(m_keys[first])];
+            m_commands.push_back({mesh.indexCount, i - first, mesh.firstIndex, mesh.vertexOffset, first});
+
+            const uint32_t pipeline = DrawKey::pipeline(m_keys[first]);
+            const uint32_t material = DrawKey::material(m_keys[first]);
+            if (m_groups.empty() || m_groups.back().pipeline != pipeline || m_groups.back().material != material) {
+                m_groups.push_back({pipeline, material, static_cast<uint32_t>(m_commands.size() - 1), 0});
+            }
+            m_groups.back().commandCount++;
+        }
+    }
+}
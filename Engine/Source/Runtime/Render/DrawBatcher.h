@@ -0,0 +1,96 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef DRAWBATCHER_H
+#define DRAWBATCHER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "DrawKey.h"
+#include "RadixSort.h"
+
+namespace Trin::Runtime::Render {
+    /// Laid out exactly like VkDrawIndexedIndirectCommand so it can be copied straight into a GPU buffer
+    struct IndexedIndirectCommand {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+
+    /// Where a mesh lives inside the shared vertex and index buffers
+    struct MeshRange {
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t vertexOffset = 0;
+    };
+
+    /// One object to draw this frame
+    struct DrawItem {
+        uint32_t pipeline;
+        uint32_t material;
+        uint32_t mesh;
+        float depth;            // Normalized view depth, [0, 1]
+        uint32_t objectIndex;   // Written to the instance buffer for the shader to look up
+    };
+
+    /// Run of indirect commands sharing pipeline and material, one indirect call each
+    struct DrawStateGroup {
+        uint32_t pipeline;
+        uint32_t material;
+        uint32_t firstCommand;
+        uint32_t commandCount;
+    };
+
+/**
+ * Turns a frame's worth of individual draws into a few instanced indirect commands.
+ *
+ * Draws are keyed with DrawKey, radix sorted, and every run that shares a mesh becomes
+ * one command whose instances index into the instance buffer. Runs sharing pipeline and
+ * material are then grouped so each group is a single vkCmdDrawIndexedIndirect(Count).
+ * None of this touches Vulkan, see IndirectDrawSubmitter for the recording side.
+ */
+class DrawBatcher {
+public:
+    /// Registers the index range of a mesh, mesh ids in DrawItem refer to this table, set it before adding draws
+    void setMeshes(std::vector<MeshRange> meshes) { m_meshes = std::move(meshes); }
+
+    void clear() { m_items.clear(); }
+
+    /// Queues a draw, false when its mesh was never registered or an index does not fit DrawKey
+    bool add(const DrawItem &item);
+
+    /**
+     * @brief Sorts the queued draws and merges them into commands
+     * @param jobs Pool used by the radix sort, nullptr keeps it on the calling thread
+     */
+    void build(Core::JobSystem *jobs = &Core::JobSystem::get());
+
+    [[nodiscard]] const std::vector<IndexedIndirectCommand> &getCommands() const { return m_commands; }
+    [[nodiscard]] const std::vector<DrawStateGroup> &getGroups() const { return m_groups; }
+
+    /// Object indices in sorted order, firstInstance of each command points into this
+    [[nodiscard]] const std::vector<uint32_t> &getInstances() const { return m_instances; }
+
+    [[nodiscard]] const std::vector<uint64_t> &getSortedKeys() const { return m_keys; }
+    [[nodiscard]] uint32_t getItemCount() const { return static_cast<uint32_t>(m_items.size()); }
+
+private:
+    std::vector<MeshRange> m_meshes;
+    std::vector<DrawItem> m_items;
+
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_order;
+    RadixSort m_sorter;
+
+    std::vector<IndexedIndirectCommand> m_commands;
+    std::vector<DrawStateGroup> m_groups;
+    std::vector<uint32_t> m_instances;
+};
+
+}
+
+#endif //DRAWBATCHER_H
@@ -0,0 +1,79 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef DRAWKEY_H
+#define DRAWKEY_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace Trin::Runtime::Render {
+/**
+ * 64 bit draw sort key. Most expensive state change sits in the highest bits so
+ * sorting the keys groups draws by pipeline, then material, then mesh.
+ *
+ * | pipeline 12 | material 16 | mesh 16 | depth 20 |
+ */
+struct DrawKey {
+    static constexpr uint32_t kDepthBits = 20;
+    static constexpr uint32_t kMeshBits = 16;
+    static constexpr uint32_t kMaterialBits = 16;
+    static constexpr uint32_t kPipelineBits = 12;
+
+    static constexpr uint32_t kMeshShift = kDepthBits;
+    static constexpr uint32_t kMaterialShift = kMeshShift + kMeshBits;
+    static constexpr uint32_t kPipelineShift = kMaterialShift + kMaterialBits;
+
+    static constexpr uint64_t kDepthMask = (1ull << kDepthBits) - 1;
+
+    /**
+     * @brief Packs draw state into a sortable key
+     * @param pipeline Pipeline index, below 4096
+     * @param material Material index, below 65536
+     * @param mesh Mesh index, below 65536
+     * @param depth View depth normalized to [0, 1], nearer draws sort first inside a batch
+     *
+     * Indices that do not fit their field would silently alias another draw's state, and a
+     * NaN depth has no integer value, so debug builds stop on both.
+     */
+    static constexpr uint64_t make(uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+        assert(pipeline < (1u << kPipelineBits) && "DrawKey pipeline index out of range");
+        assert(material < (1u << kMaterialBits) && "DrawKey material index out of range");
+        assert(mesh < (1u << kMeshBits) && "DrawKey mesh index out of range");
+        assert(depth == depth && "DrawKey depth is NaN");
+        const float clamped = std::clamp(depth, 0.0f, 1.0f);
+        const auto quantized = static_cast<uint64_t>(clamped * static_cast<float>(kDepthMask));
+        return (static_cast<uint64_t>(pipeline & ((1u << kPipelineBits) - 1)) << kPipelineShift) |
+               (static_cast<uint64_t>(material & ((1u << kMaterialBits) - 1)) << kMaterialShift) |
+               (static_cast<uint64_t>(mesh & ((1u << kMeshBits) - 1)) << kMeshShift) |
+               quantized;
+    }
+
+    static constexpr uint32_t pipeline(uint64_t key) {
+        return static_cast<uint32_t>(key >> kPipelineShift) & ((1u << kPipelineBits) - 1);
+    }
+
+    static constexpr uint32_t material(uint64_t key) {
+        return static_cast<uint32_t>(key >> kMaterialShift) & ((1u << kMaterialBits) - 1);
+    }
+
+    static constexpr uint32_t mesh(uint64_t key) {
+        return static_cast<uint32_t>(key >> kMeshShift) & ((1u << kMeshBits) - 1);
+    }
+
+    /// Draws that share everything but depth can be merged into one instanced draw
+    static constexpr uint64_t batchBits(uint64_t key) {
+        return key >> kDepthBits;
+    }
+
+    /// Draws that share pipeline and material can go out in one indirect call
+    static constexpr uint64_t stateBits(uint64_t key) {
+        return key >> kMaterialShift;
+    }
+};
+
+}
+
+#endif //DRAWKEY_H
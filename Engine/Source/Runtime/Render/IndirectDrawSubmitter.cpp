@@ -0,0 +1,73 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "IndirectDrawSubmitter.h"
+
+#include <cstring>
+
+namespace Trin::Runtime::Render {
+    static_assert(sizeof(IndexedIndirectCommand) == sizeof(VkDrawIndexedIndirectCommand),
+                  "IndexedIndirectCommand must match VkDrawIndexedIndirectCommand");
+
+    IndirectDrawSubmitter::IndirectDrawSubmitter(VkDevice device, bool multiDrawIndirect, bool drawIndirectCount)
+        : m_multiDrawIndirect(multiDrawIndirect) {
+        if (!drawIndirectCount) {
+            return;
+        }
+        auto function = vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCount");
+        if (!function) {
+            function = vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCountKHR");
+        }
+        m_drawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(function);
+    }
+
+    bool IndirectDrawSubmitter::upload(const DrawBatcher &batcher, const IndirectDrawBuffers &buffers) const {
+        const auto &commands = batcher.getCommands();
+        const auto &groups = batcher.getGroups();
+        const auto &instances = batcher.getInstances();
+        if (commands.size() > buffers.commandCapacity || instances.size() > buffers.instanceCapacity ||
+            (m_drawIndexedIndirectCount && groups.size() > buffers.countCapacity)) {
+            return false;
+        }
+
+        std::memcpy(buffers.commandMapped, commands.data(), commands.size() * sizeof(IndexedIndirectCommand));
+        std::memcpy(buffers.instanceMapped, instances.data(), instances.size() * sizeof(uint32_t));
+        if (m_drawIndexedIndirectCount) {
+            auto *counts = static_cast<uint32_t *>(buffers.countMapped);
+            for (size_t i = 0; i < groups.size(); i++) {
+                counts[i] = groups[i].commandCount;
+            }
+        }
+        return true;
+    }
+
+    uint32_t IndirectDrawSubmitter::record(VkCommandBuffer commandBuffer, const DrawBatcher &batcher,
+                                           const IndirectDrawBuffers &buffers, const BindState &bindState) const {
+        constexpr uint32_t stride = sizeof(IndexedIndirectCommand);
+        uint32_t calls = 0;
+
+        const auto &groups = batcher.getGroups();
+        for (size_t i = 0; i < groups.size(); i++) {
+            const DrawStateGroup &group = groups[i];
+            bindState(commandBuffer, group.pipeline, group.material);
+
+            const VkDeviceSize offset = static_cast<VkDeviceSize>(group.firstCommand) * stride;
+            if (m_drawIndexedIndirectCount) {
+                m_drawIndexedIndirectCount(commandBuffer, buffers.commandBuffer, offset,
+                                           buffers.countBuffer, i * sizeof(uint32_t), group.commandCount, stride);
+                calls++;
+            } else if (m_multiDrawIndirect) {
+                vkCmdDrawIndexedIndirect(commandBuffer, buffers.commandBuffer, offset, group.commandCount, stride);
+                calls++;
+            } else {
+                // Without multiDrawIndirect every command needs its own call, still instanced though
+                for (uint32_t command = 0; command < group.commandCount; command++) {
+                    vkCmdDrawIndexedIndirect(commandBuffer, buffers.commandBuffer, offset + command * stride, 1, stride);
+                    calls++;
+                }
+            }
+        }
+        return calls;
+    }
+}
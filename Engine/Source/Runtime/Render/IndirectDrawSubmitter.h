@@ -0,0 +1,66 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef INDIRECTDRAWSUBMITTER_H
+#define INDIRECTDRAWSUBMITTER_H
+
+#include <functional>
+#include <vulkan/vulkan.h>
+
+#include "DrawBatcher.h"
+
+namespace Trin::Runtime::Render {
+    /// Host visible buffers the batches are written into, owned by the caller
+    struct IndirectDrawBuffers {
+        VkBuffer commandBuffer = VK_NULL_HANDLE;    // Needs VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+        void *commandMapped = nullptr;
+        uint32_t commandCapacity = 0;
+
+        VkBuffer countBuffer = VK_NULL_HANDLE;      // One uint32_t per state group, also an indirect buffer
+        void *countMapped = nullptr;
+        uint32_t countCapacity = 0;
+
+        void *instanceMapped = nullptr;             // Object indices the vertex shader reads per instance
+        uint32_t instanceCapacity = 0;
+    };
+
+/**
+ * Records the output of a DrawBatcher as indirect draws.
+ *
+ * Each state group becomes one vkCmdDrawIndexedIndirectCount call when the device was
+ * created with it (core in Vulkan 1.2, VK_KHR_draw_indirect_count before that), and one
+ * multi draw vkCmdDrawIndexedIndirect otherwise. The count buffer is filled on the CPU for now,
+ * which leaves room for a GPU culling pass to shrink the counts later.
+ */
+class IndirectDrawSubmitter {
+public:
+    /// Binds the pipeline and material of a group before its draws are recorded
+    using BindState = std::function<void(VkCommandBuffer, uint32_t pipeline, uint32_t material)>;
+
+    /**
+     * @brief Looks up the draw indirect count entry point when the device has it enabled
+     * @param device Logical device the command buffers belong to
+     * @param multiDrawIndirect Whether the multiDrawIndirect feature was enabled, needed for drawCount > 1
+     * @param drawIndirectCount Whether VK_KHR_draw_indirect_count or the Vulkan 1.2 drawIndirectCount feature
+     *                          was enabled, the entry point can resolve even when it was not
+     */
+    IndirectDrawSubmitter(VkDevice device, bool multiDrawIndirect, bool drawIndirectCount);
+
+    /// Copies commands, counts and instances into the mapped buffers, false when they do not fit
+    bool upload(const DrawBatcher &batcher, const IndirectDrawBuffers &buffers) const;
+
+    /// Records every group into the command buffer, returns the number of draw calls issued
+    uint32_t record(VkCommandBuffer commandBuffer, const DrawBatcher &batcher, const IndirectDrawBuffers &buffers,
+                    const BindState &bindState) const;
+
+    [[nodiscard]] bool hasDrawIndirectCount() const { return m_drawIndexedIndirectCount != nullptr; }
+
+private:
+    PFN_vkCmdDrawIndexedIndirectCountKHR m_drawIndexedIndirectCount = nullptr;
+    bool m_multiDrawIndirect = false;
+};
+
+}
+
+#endif //INDIRECTDRAWSUBMITTER_H
@@ -0,0 +1,336 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Math/Simd.h"
+
+namespace Trin::Runtime::Render {
+    using Simd::Float4;
+
+    namespace {
+        double elapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        Vector4 lerp(const Vector4 &a, const Vector4 &b, float t) {
+            return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t};
+        }
+    }
+
+    OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height) {
+        m_tilesX = (width + kTileSize - 1) / kTileSize;
+        m_tilesY = (height + kTileSize - 1) / kTileSize;
+        m_width = m_tilesX * kTileSize;
+        m_height = m_tilesY * kTileSize;
+        m_tileBins.resize(m_tilesX * m_tilesY);
+
+        // Every level halves the previous one, rounding up, down to a single texel
+        uint32_t levelWidth = m_width, levelHeight = m_height;
+        for (;;) {
+            HiZLevel level;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.depth.assign(static_cast<size_t>(levelWidth) * levelHeight, 1.0f);
+            m_levels.push_back(std::move(level));
+            if (levelWidth == 1 && levelHeight == 1) {
+                break;
+            }
+            levelWidth = std::max(1u, (levelWidth + 1) / 2);
+            levelHeight = std::max(1u, (levelHeight + 1) / 2);
+        }
+    }
+
+    void OcclusionCuller::beginFrame(const Matrix4 &viewProjection) {
+        m_viewProjection = viewProjection;
+        m_triangles.clear();
+        for (auto &bin : m_tileBins) {
+            bin.clear();
+        }
+        std::fill(m_levels[0].depth.begin(), m_levels[0].depth.end(), 1.0f);
+        m_stats = {};
+    }
+
+    void OcclusionCuller::addOccluder(const std::vector<Vector3> &vertices, const std::vector<uint32_t> &indices,
+                                      const Matrix4 &world) {
+        const Matrix4 mvp = m_viewProjection * world;
+
+        std::vector<Vector4> clip(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            clip[i] = mvp.transform({vertices[i].x, vertices[i].y, vertices[i].z, 1.0f});
+        }
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const Vector4 triangle[3] = {clip[indices[i]], clip[indices[i + 1]], clip[indices[i + 2]]};
+
+            // Skip triangles entirely past one side of the frustum
+            bool rejected = false;
+            for (int axis = 0; axis < 2 && !rejected; axis++) {
+                const auto coord = [axis](const Vector4 &v) { return axis == 0 ? v.x : v.y; };
+                rejected = (coord(triangle[0]) < -triangle[0].w && coord(triangle[1]) < -triangle[1].w && coord(triangle[2]) < -triangle[2].w) ||
+                           (coord(triangle[0]) > triangle[0].w && coord(triangle[1]) > triangle[1].w && coord(triangle[2]) > triangle[2].w);
+            }
+            if (rejected) {
+                continue;
+            }
+
+            // Clip against the near plane (z >= 0 in Vulkan clip space), leaving a polygon of up to four points
+            Vector4 polygon[4];
+            int count = 0;
+            for (int v = 0; v < 3; v++) {
+                const Vector4 &a = triangle[v];
+                const Vector4 &b = triangle[(v + 1) % 3];
+                if (a.z >= 0.0f) {
+                    polygon[count++] = a;
+                }
+                if ((a.z >= 0.0f) != (b.z >= 0.0f)) {
+                    polygon[count++] = lerp(a, b, a.z / (a.z - b.z));
+                }
+            }
+
+            for (int v = 1; v + 1 < count; v++) {
+                const Vector4 fan[3] = {polygon[0], polygon[v], polygon[v + 1]};
+                addClippedTriangle(fan);
+            }
+        }
+    }
+
+    void OcclusionCuller::rasterize(Core::JobSystem *jobs) {
+        const auto start = std::chrono::steady_clock::now();
+
+        const uint32_t tileCount = m_tilesX * m_tilesY;
+        if (jobs) {
+            jobs->parallelFor(tileCount, 1, [this](uint32_t begin, uint32_t end) {
+                for (uint32_t tile = begin; tile < end; tile++) {
+                    rasterizeTile(tile);
+                }
+            });
+        } else {
+            for (uint32_t tile = 0; tile < tileCount; tile++) {
+                rasterizeTile(tile);
+            }
+        }
+        buildPyramid();
+
+        m_stats.occluderTriangles = static_cast<uint32_t>(m_triangles.size());
+        m_stats.rasterMs = elapsedMs(start);
+    }
+
+    bool OcclusionCuller::isVisible(const AABB &box) const {
+        const Matrix4 &m = m_viewProjection;
+
+        // Project all eight corners, four at a time
+        const Float4 xs(box.min.x, box.max.x, box.min.x, box.max.x);
+        const Float4 ys(box.min.y, box.min.y, box.max.y, box.max.y);
+        const Float4 zs[2] = {Float4(box.min.z), Float4(box.max.z)};
+
+        Float4 minX(FLT_MAX), minY(FLT_MAX), minZ(FLT_MAX);
+        Float4 maxX(-FLT_MAX), maxY(-FLT_MAX);
+        for (const Float4 &z : zs) {
+            const Float4 cx = Simd::madd(Float4(m.m[0]), xs, Simd::madd(Float4(m.m[4]), ys, Simd::madd(Float4(m.m[8]), z, Float4(m.m[12]))));
+            const Float4 cy = Simd::madd(Float4(m.m[1]), xs, Simd::madd(Float4(m.m[5]), ys, Simd::madd(Float4(m.m[9]), z, Float4(m.m[13]))));
+            const Float4 cz = Simd::madd(Float4(m.m[2]), xs, Simd::madd(Float4(m.m[6]), ys, Simd::madd(Float4(m.m[10]), z, Float4(m.m[14]))));
+            const Float4 cw = Simd::madd(Float4(m.m[3]), xs, Simd::madd(Float4(m.m[7]), ys, Simd::madd(Float4(m.m[11]), z, Float4(m.m[15]))));
+
+            // A corner behind the camera makes the projection meaningless, keep the box
+            if ((cw <= Float4(1e-5f)).mask() != 0) {
+                return true;
+            }
+
+            const Float4 invW = Float4(1.0f) / cw;
+            const Float4 sx = cx * invW, sy = cy * invW, sz = cz * invW;
+            minX = Float4::min(minX, sx);
+            maxX = Float4::max(maxX, sx);
+            minY = Float4::min(minY, sy);
+            maxY = Float4::max(maxY, sy);
+            minZ = Float4::min(minZ, sz);
+        }
+
+        const auto reduceMin = [](Float4 v) { return std::min(std::min(v.lane(0), v.lane(1)), std::min(v.lane(2), v.lane(3))); };
+        const auto reduceMax = [](Float4 v) { return std::max(std::max(v.lane(0), v.lane(1)), std::max(v.lane(2), v.lane(3))); };
+
+        const auto width = static_cast<float>(m_width), height = static_cast<float>(m_height);
+        const float x0 = (reduceMin(minX) * 0.5f + 0.5f) * width;
+        const float x1 = (reduceMax(maxX) * 0.5f + 0.5f) * width;
+        const float y0 = (reduceMin(minY) * 0.5f + 0.5f) * height;
+        const float y1 = (reduceMax(maxY) * 0.5f + 0.5f) * height;
+        const float nearestDepth = reduceMin(minZ);
+
+        // Off screen boxes are the frustum culler's business, not ours
+        if (x1 < 0.0f || y1 < 0.0f || x0 >= width || y0 >= height || nearestDepth <= 0.0f) {
+            return true;
+        }
+
+        const float px0 = std::max(x0, 0.0f), px1 = std::min(x1, width - 1.0f);
+        const float py0 = std::max(y0, 0.0f), py1 = std::min(y1, height - 1.0f);
+
+        // Pick the level where the rectangle spans about two texels each way
+        const float extent = std::max(px1 - px0, py1 - py0);
+        int levelIndex = extent > 2.0f ? static_cast<int>(std::ceil(std::log2(extent * 0.5f))) : 0;
+        levelIndex = std::clamp(levelIndex, 0, static_cast<int>(m_levels.size()) - 1);
+        const HiZLevel &level = m_levels[levelIndex];
+        const float scale = 1.0f / static_cast<float>(1u << levelIndex);
+
+        const auto tx0 = static_cast<uint32_t>(px0 * scale), tx1 = std::min(level.width - 1, static_cast<uint32_t>(px1 * scale));
+        const auto ty0 = static_cast<uint32_t>(py0 * scale), ty1 = std::min(level.height - 1, static_cast<uint32_t>(py1 * scale));
+
+        float farthest = 0.0f;
+        for (uint32_t ty = ty0; ty <= ty1; ty++) {
+            for (uint32_t tx = tx0; tx <= tx1; tx++) {
+                farthest = std::max(farthest, level.depth[ty * level.width + tx]);
+            }
+        }
+        return nearestDepth <= farthest;
+    }
+
+    void OcclusionCuller::testVisibility(const std::vector<AABB> &boxes, std::vector<uint8_t> &visible,
+                                         Core::JobSystem *jobs) {
+        const auto start = std::chrono::steady_clock::now();
+        visible.resize(boxes.size());
+
+        const auto test = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                visible[i] = isVisible(boxes[i]) ? 1 : 0;
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(static_cast<uint32_t>(boxes.size()), 256, test);
+        } else {
+            test(0, static_cast<uint32_t>(boxes.size()));
+        }
+
+        m_stats.tested += static_cast<uint32_t>(boxes.size());
+        m_stats.culled += static_cast<uint32_t>(std::count(visible.begin(), visible.end(), 0));
+        m_stats.testMs += elapsedMs(start);
+    }
+
+    void OcclusionCuller::addClippedTriangle(const Vector4 (&clip)[3]) {
+        ScreenTriangle triangle{};
+        const auto width = static_cast<float>(m_width), height = static_cast<float>(m_height);
+        for (int v = 0; v < 3; v++) {
+            const float invW = 1.0f / clip[v].w;
+            triangle.x[v] = (clip[v].x * invW * 0.5f + 0.5f) * width;
+            triangle.y[v] = (clip[v].y * invW * 0.5f + 0.5f) * height;
+            triangle.z[v] = clip[v].z * invW;
+        }
+
+        const float minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const float maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const float minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+        const float maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+        if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+            return;
+        }
+
+        const auto index = static_cast<uint32_t>(m_triangles.size());
+        m_triangles.push_back(triangle);
+
+        // Bin into every tile the bounding rectangle touches
+        const uint32_t tx0 = static_cast<uint32_t>(std::max(minX, 0.0f)) / kTileSize;
+        const uint32_t tx1 = std::min(static_cast<uint32_t>(std::min(maxX, width - 1.0f)) / kTileSize, m_tilesX - 1);
+        const uint32_t ty0 = static_cast<uint32_t>(std::max(minY, 0.0f)) / kTileSize;
+        const uint32_t ty1 = std::min(static_cast<uint32_t>(std::min(maxY, height - 1.0f)) / kTileSize, m_tilesY - 1);
+        for (uint32_t ty = ty0; ty <= ty1; ty++) {
+            for (uint32_t tx = tx0; tx <= tx1; tx++) {
+                m_tileBins[ty * m_tilesX + tx].push_back(index);
+            }
+        }
+    }
+
+    void OcclusionCuller::rasterizeTile(uint32_t tile) {
+        const uint32_t tileX = (tile % m_tilesX) * kTileSize;
+        const uint32_t tileY = (tile / m_tilesX) * kTileSize;
+        float *depth = m_levels[0].depth.data();
+        const Float4 laneOffsets(0.5f, 1.5f, 2.5f, 3.5f);
+        const Float4 zero;
+
+        for (const uint32_t index : m_tileBins[tile]) {
+            ScreenTriangle t = m_triangles[index];
+
+            float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+            if (area == 0.0f) {
+                continue;
+            }
+            // Either winding works for depth, flip clockwise triangles so inside is always positive
+            if (area < 0.0f) {
+                std::swap(t.x[1], t.x[2]);
+                std::swap(t.y[1], t.y[2]);
+                std::swap(t.z[1], t.z[2]);
+                area = -area;
+            }
+
+            // Edge i is opposite vertex i, e(p) = a * x + b * y + c
+            float a[3], b[3], c[3];
+            bool topLeft[3];
+            for (int e = 0; e < 3; e++) {
+                const int from = (e + 1) % 3, to = (e + 2) % 3;
+                a[e] = t.y[from] - t.y[to];
+                b[e] = t.x[to] - t.x[from];
+                c[e] = -a[e] * t.x[from] - b[e] * t.y[from];
+                // (a, b) points inside and rows grow downwards, so the inside is right of a left edge
+                // and below a top one. Only those own the pixel centers lying exactly on them
+                topLeft[e] = a[e] > 0.0f || (a[e] == 0.0f && b[e] > 0.0f);
+            }
+            const auto covers = [zero](Float4 edge, bool owned) { return owned ? edge >= zero : edge > zero; };
+
+            // Depth as a plane over the screen, built from the barycentric weights
+            const float invArea = 1.0f / area;
+            const float za = (a[0] * t.z[0] + a[1] * t.z[1] + a[2] * t.z[2]) * invArea;
+            const float zb = (b[0] * t.z[0] + b[1] * t.z[1] + b[2] * t.z[2]) * invArea;
+            const float zc = (c[0] * t.z[0] + c[1] * t.z[1] + c[2] * t.z[2]) * invArea;
+
+            const auto clampTo = [](float value, uint32_t low, uint32_t high) {
+                return static_cast<uint32_t>(std::clamp(value, static_cast<float>(low), static_cast<float>(high)));
+            };
+            // Columns start on a multiple of four so whole SIMD rows line up with the buffer
+            const uint32_t x0 = clampTo(std::min({t.x[0], t.x[1], t.x[2]}), tileX, tileX + kTileSize - 1) & ~3u;
+            const uint32_t x1 = clampTo(std::max({t.x[0], t.x[1], t.x[2]}), tileX, tileX + kTileSize - 1);
+            const uint32_t y0 = clampTo(std::min({t.y[0], t.y[1], t.y[2]}), tileY, tileY + kTileSize - 1);
+            const uint32_t y1 = clampTo(std::max({t.y[0], t.y[1], t.y[2]}), tileY, tileY + kTileSize - 1);
+
+            const Float4 a0(a[0]), a1(a[1]), a2(a[2]), depthA(za);
+            for (uint32_t y = y0; y <= y1; y++) {
+                const float py = static_cast<float>(y) + 0.5f;
+                const Float4 row0(b[0] * py + c[0]), row1(b[1] * py + c[1]), row2(b[2] * py + c[2]);
+                const Float4 rowDepth(zb * py + zc);
+                float *line = depth + static_cast<size_t>(y) * m_width;
+
+                for (uint32_t x = x0; x <= x1; x += 4) {
+                    const Float4 px = Float4(static_cast<float>(x)) + laneOffsets;
+                    const Float4 e0 = Simd::madd(a0, px, row0);
+                    const Float4 e1 = Simd::madd(a1, px, row1);
+                    const Float4 e2 = Simd::madd(a2, px, row2);
+                    const Float4 inside = covers(e0, topLeft[0]) & covers(e1, topLeft[1]) & covers(e2, topLeft[2]);
+                    if (inside.mask() == 0) {
+                        continue;
+                    }
+
+                    const Float4 current = Float4::load(line + x);
+                    const Float4 z = Simd::madd(depthA, px, rowDepth);
+                    Float4::select(current, Float4::min(current, z), inside).store(line + x);
+                }
+            }
+        }
+    }
+
+    void OcclusionCuller::buildPyramid() {
+        for (size_t i = 1; i < m_levels.size(); i++) {
+            const HiZLevel &source = m_levels[i - 1];
+            HiZLevel &target = m_levels[i];
+            for (uint32_t y = 0; y < target.height; y++) {
+                const uint32_t sy0 = y * 2, sy1 = std::min(sy0 + 1, source.height - 1);
+                for (uint32_t x = 0; x < target.width; x++) {
+                    const uint32_t sx0 = x * 2, sx1 = std::min(sx0 + 1, source.width - 1);
+                    target.depth[y * target.width + x] = std::max(
+                        std::max(source.depth[sy0 * source.width + sx0], source.depth[sy0 * source.width + sx1]),
+                        std::max(source.depth[sy1 * source.width + sx0], source.depth[sy1 * source.width + sx1]));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Math/Bounds.h"
+#include "Math/Matrix4.h"
+
+namespace Trin::Runtime::Render {
+    using namespace Trin::Math;
+
+    struct OcclusionStats {
+        uint32_t occluderTriangles = 0;     // Triangles that survived near plane clipping
+        uint32_t tested = 0;
+        uint32_t culled = 0;
+        double rasterMs = 0.0;              // Binning, tile rasterization and the Hi-Z build
+        double testMs = 0.0;
+
+        [[nodiscard]] float culledPercent() const {
+            return tested > 0 ? 100.0f * static_cast<float>(culled) / static_cast<float>(tested) : 0.0f;
+        }
+    };
+
+/**
+ * CPU occlusion culling against a small software depth buffer.
+ *
+ * A handful of large occluder meshes are rasterized into a low resolution depth buffer,
+ * tile by tile on the job system, then reduced into a Hi-Z pyramid holding the farthest
+ * depth of each region. Candidate boxes are projected and compared against the pyramid
+ * level where their screen rectangle covers only a couple of texels.
+ *
+ * Depth follows Vulkan's [0, 1] range with 0 at the near plane, so an empty buffer is 1.
+ */
+class OcclusionCuller {
+public:
+    static constexpr uint32_t kTileSize = 32;
+
+    /**
+     * @brief Allocates the depth buffer and its pyramid
+     * @param width Buffer width in pixels, rounded up to a whole number of tiles
+     * @param height Buffer height in pixels, rounded up to a whole number of tiles
+     */
+    explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+    /// Clears the depth buffer and drops the occluders of the previous frame
+    void beginFrame(const Matrix4 &viewProjection);
+
+    /**
+     * @brief Queues an indexed triangle mesh to be drawn into the depth buffer
+     * @param vertices Object space positions
+     * @param indices Three indices per triangle
+     * @param world Object to world transform
+     */
+    void addOccluder(const std::vector<Vector3> &vertices, const std::vector<uint32_t> &indices, const Matrix4 &world);
+
+    /// Rasterizes every queued occluder and builds the Hi-Z pyramid
+    void rasterize(Core::JobSystem *jobs = &Core::JobSystem::get());
+
+    /// True when any part of the box might be visible, only valid after rasterize()
+    [[nodiscard]] bool isVisible(const AABB &box) const;
+
+    /**
+     * @brief Tests a batch of boxes, spreading the work over the job system
+     * @param boxes World space bounds to test
+     * @param visible Receives 1 for every box that may be visible and 0 for hidden ones
+     */
+    void testVisibility(const std::vector<AABB> &boxes, std::vector<uint8_t> &visible,
+                        Core::JobSystem *jobs = &Core::JobSystem::get());
+
+    [[nodiscard]] const OcclusionStats &getStats() const { return m_stats; }
+    [[nodiscard]] uint32_t getWidth() const { return m_width; }
+    [[nodiscard]] uint32_t getHeight() const { return m_height; }
+
+    /// Full resolution depth, row major, for debug views
+    [[nodiscard]] const std::vector<float> &getDepthBuffer() const { return m_levels[0].depth; }
+
+private:
+    struct ScreenTriangle {
+        float x[3], y[3], z[3];
+    };
+
+    struct HiZLevel {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<float> depth;
+    };
+
+    void addClippedTriangle(const Vector4 (&clip)[3]);
+    void rasterizeTile(uint32_t tile);
+    void buildPyramid();
+
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_tilesX;
+    uint32_t m_tilesY;
+    Matrix4 m_viewProjection;
+
+    std::vector<ScreenTriangle> m_triangles;
+    std::vector<std::vector<uint32_t>> m_tileBins;
+    std::vector<HiZLevel> m_levels;
+
+    OcclusionStats m_stats;
+};
+
+}
+
+#endif //OCCLUSIONCULLER_H
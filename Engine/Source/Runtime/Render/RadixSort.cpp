@@ -0,0 +1,96 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "RadixSort.h"
+
+#include <algorithm>
+
+namespace Trin::Runtime::Render {
+    void RadixSort::sort(std::vector<uint64_t> &keys, std::vector<uint32_t> &values, Core::JobSystem *jobs) {
+        const auto count = static_cast<uint32_t>(keys.size());
+        if (count < 2) {
+            return;
+        }
+
+        const uint32_t threads = jobs ? jobs->getThreadCount() : 1;
+        const uint32_t chunks = std::clamp(count / kMinItemsPerChunk, 1u, threads);
+        const uint32_t chunkSize = (count + chunks - 1) / chunks;
+
+        m_keyScratch.resize(count);
+        m_valueScratch.resize(count);
+        m_histograms.resize(static_cast<size_t>(chunks) * kBuckets);
+
+        const auto forChunks = [&](const std::function<void(uint32_t, uint32_t, uint32_t)> &fn) {
+            const auto run = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t chunk = begin; chunk < end; chunk++) {
+                    fn(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+                }
+            };
+            if (chunks > 1) {
+                jobs->parallelFor(chunks, 1, run);
+            } else {
+                run(0, 1);
+            }
+        };
+
+        uint64_t *srcKeys = keys.data();
+        uint32_t *srcValues = values.data();
+        uint64_t *dstKeys = m_keyScratch.data();
+        uint32_t *dstValues = m_valueScratch.data();
+
+        for (uint32_t pass = 0; pass < kPasses; pass++) {
+            const uint32_t shift = pass * kRadixBits;
+
+            forChunks([&](uint32_t chunk, uint32_t begin, uint32_t end) {
+                uint32_t *histogram = &m_histograms[static_cast<size_t>(chunk) * kBuckets];
+                std::fill(histogram, histogram + kBuckets, 0u);
+                for (uint32_t i = begin; i < end; i++) {
+                    histogram[(srcKeys[i] >> shift) & (kBuckets - 1)]++;
+                }
+            });
+
+            // Nothing moves when every key shares this digit
+            bool trivial = false;
+            for (uint32_t bucket = 0; bucket < kBuckets && !trivial; bucket++) {
+                uint32_t total = 0;
+                for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+                    total += m_histograms[static_cast<size_t>(chunk) * kBuckets + bucket];
+                }
+                trivial = total == count;
+            }
+            if (trivial) {
+                continue;
+            }
+
+            // Bucket major, chunk minor prefix sum keeps the sort stable across chunks
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < kBuckets; bucket++) {
+                for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+                    uint32_t &slot = m_histograms[static_cast<size_t>(chunk) * kBuckets + bucket];
+                    const uint32_t bucketCount = slot;
+                    slot = offset;
+                    offset += bucketCount;
+                }
+            }
+
+            forChunks([&](uint32_t chunk, uint32_t begin, uint32_t end) {
+                uint32_t *offsets = &m_histograms[static_cast<size_t>(chunk) * kBuckets];
+                for (uint32_t i = begin; i < end; i++) {
+                    const uint32_t destination = offsets[(srcKeys[i] >> shift) & (kBuckets - 1)]++;
+                    dstKeys[destination] = srcKeys[i];
+                    dstValues[destination] = srcValues[i];
+                }
+            });
+
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcValues, dstValues);
+        }
+
+        // An odd number of real passes leaves the result in the scratch buffers
+        if (srcKeys != keys.data()) {
+            std::copy(srcKeys, srcKeys + count, keys.data());
+            std::copy(srcValues, srcValues + count, values.data());
+        }
+    }
+}
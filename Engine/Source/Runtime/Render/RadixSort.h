@@ -0,0 +1,46 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Core/JobSystem.h"
+
+namespace Trin::Runtime::Render {
+/**
+ * Stable least significant digit radix sort of 64 bit keys with a 32 bit payload.
+ *
+ * Each pass counts digits per chunk in parallel, turns the counts into per chunk
+ * offsets and scatters the chunks in parallel. Passes where every key has the same
+ * digit are skipped, which for draw keys usually removes the unused upper bits.
+ */
+class RadixSort {
+public:
+    /**
+     * @brief Sorts keys ascending and applies the same permutation to values
+     * @param keys Keys to sort, sorted in place
+     * @param values Payload carried along with each key, must be the same size as keys
+     * @param jobs Pool to spread large sorts over, nullptr sorts on the calling thread
+     */
+    void sort(std::vector<uint64_t> &keys, std::vector<uint32_t> &values,
+              Core::JobSystem *jobs = &Core::JobSystem::get());
+
+private:
+    static constexpr uint32_t kRadixBits = 8;
+    static constexpr uint32_t kBuckets = 1u << kRadixBits;
+    static constexpr uint32_t kPasses = 64 / kRadixBits;
+    // Below this a single thread finishes before the others would wake up
+    static constexpr uint32_t kMinItemsPerChunk = 16384;
+
+    std::vector<uint64_t> m_keyScratch;
+    std::vector<uint32_t> m_valueScratch;
+    std::vector<uint32_t> m_histograms;     // kBuckets counts per chunk, reused as offsets
+};
+
+}
+
+#endif //RADIXSORT_H
@@ -0,0 +1,344 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Trin::Runtime::Render {
+    TextureStreamer::TextureStreamer(TextureUploadBackend &backend, const TextureStreamerConfig &config) :
+    m_backend(backend), m_config(config) {
+        m_ioThread = std::thread(&TextureStreamer::ioLoop, this);
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        m_ioThread.join();
+    }
+
+    uint32_t TextureStreamer::add(const std::string &path) {
+        auto file = std::make_shared<Asset::TextureFile>();
+        if (!file->open(path)) {
+            return kInvalidTexture;
+        }
+
+        uint32_t texture;
+        if (!m_freeSlots.empty()) {
+            texture = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            texture = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        const Asset::TextureFileHeader &header = file->getHeader();
+        Slot &slot = m_slots[texture];
+        slot = {};
+        slot.mipCount = header.mipCount;
+        slot.tailMip = header.mipCount - 1;
+        while (slot.tailMip > 0) {
+            const Asset::TextureMipEntry &mip = file->getMip(slot.tailMip - 1);
+            if (std::max(mip.width, mip.height) > m_config.tailSize) {
+                break;
+            }
+            slot.tailMip--;
+        }
+        slot.residentMip = slot.mipCount;
+        slot.wantedMip = slot.tailMip;
+        slot.lastUsedFrame = m_frame;
+        slot.live = true;
+        slot.file = std::move(file);
+        lruPushFront(texture);
+
+        m_backend.createTexture(texture, {header.format, header.width, header.height, header.mipCount});
+
+        // The tail is pinned, so it is loaded whatever the budget says
+        queueLoad(texture, slot.tailMip, slot.mipCount, true);
+        return texture;
+    }
+
+    void TextureStreamer::remove(uint32_t texture) {
+        Slot &slot = m_slots[texture];
+        if (!slot.live || slot.removed) {
+            return;
+        }
+        slot.removed = true;
+        lruUnlink(texture);
+        if (slot.pendingMip == kNone) {
+            destroySlot(texture);
+        }
+    }
+
+    void TextureStreamer::reportScreenSize(uint32_t texture, float screenPixels) {
+        Slot &slot = m_slots[texture];
+        if (!slot.live || slot.removed) {
+            return;
+        }
+
+        uint32_t mip = slot.tailMip;
+        if (screenPixels > 0.0f) {
+            const Asset::TextureMipEntry &top = slot.file->getMip(0);
+            const float ratio = static_cast<float>(std::max(top.width, top.height)) / screenPixels;
+            const float level = std::floor(std::log2(std::max(ratio, 1.0f)) + m_config.lodBias);
+            mip = std::min(static_cast<uint32_t>(std::max(level, 0.0f)), slot.tailMip);
+        }
+
+        if (slot.reportedMip == kNone) {
+            m_reported.push_back(texture);
+            slot.reportedMip = mip;
+        } else {
+            slot.reportedMip = std::min(slot.reportedMip, mip);
+        }
+    }
+
+    void TextureStreamer::update(uint64_t frame) {
+        m_frame = frame;
+        applyCompletions();
+
+        for (const uint32_t texture : m_reported) {
+            Slot &slot = m_slots[texture];
+            if (slot.reportedMip == kNone) {
+                continue;
+            }
+            slot.wantedMip = slot.reportedMip;
+            slot.reportedMip = kNone;
+            if (slot.removed) {
+                continue;
+            }
+            slot.lastUsedFrame = frame;
+            lruUnlink(texture);
+            lruPushFront(texture);
+        }
+        m_reported.clear();
+
+        // Textures furthest from the detail they want go first, ties to the most recently seen
+        m_candidates.clear();
+        for (uint32_t texture = 0; texture < m_slots.size(); texture++) {
+            const Slot &slot = m_slots[texture];
+            if (slot.live && !slot.removed && slot.pendingMip == kNone && slot.residentMip <= slot.tailMip &&
+                effectiveWantedMip(slot) < slot.residentMip) {
+                m_candidates.push_back(texture);
+            }
+        }
+        std::sort(m_candidates.begin(), m_candidates.end(), [this](uint32_t a, uint32_t b) {
+            const Slot &slotA = m_slots[a];
+            const Slot &slotB = m_slots[b];
+            const uint32_t gapA = slotA.residentMip - effectiveWantedMip(slotA);
+            const uint32_t gapB = slotB.residentMip - effectiveWantedMip(slotB);
+            if (gapA != gapB) {
+                return gapA > gapB;
+            }
+            return slotA.lastUsedFrame > slotB.lastUsedFrame;
+        });
+
+        uint32_t issued = 0;
+        for (const uint32_t texture : m_candidates) {
+            if (issued >= m_config.maxRequestsPerUpdate || m_inFlight >= m_config.maxInFlight) {
+                break;
+            }
+            const Slot &slot = m_slots[texture];
+            const uint32_t mip = slot.residentMip - 1;
+            if (!makeRoom(mipBytes(slot, mip, mip + 1), texture)) {
+                m_stats.budgetStalls++;
+                continue;
+            }
+            queueLoad(texture, mip, mip + 1, false);
+            issued++;
+        }
+    }
+
+    void TextureStreamer::flush() {
+        {
+            std::unique_lock lock(m_mutex);
+            m_idle.wait(lock, [this] { return m_urgent.empty() && m_queue.empty() && !m_ioBusy; });
+        }
+        applyCompletions();
+    }
+
+    void TextureStreamer::ioLoop() {
+        for (;;) {
+            LoadRequest request;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_urgent.empty() || !m_queue.empty(); });
+                if (m_stopping) {
+                    return;
+                }
+                std::deque<LoadRequest> &queue = m_urgent.empty() ? m_queue : m_urgent;
+                request = std::move(queue.front());
+                queue.pop_front();
+                m_ioBusy = true;
+            }
+
+            // Reading through the mapping is what pulls the pages in, so the disk wait lands here too
+            for (uint32_t mip = request.firstMip; mip < request.endMip; mip++) {
+                m_backend.uploadMip(request.texture, mip, request.file->getMipData(mip));
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                request.file.reset();
+                m_completed.push_back(std::move(request));
+                m_ioBusy = false;
+            }
+            m_idle.notify_all();
+        }
+    }
+
+    void TextureStreamer::queueLoad(uint32_t texture, uint32_t firstMip, uint32_t endMip, bool urgent) {
+        Slot &slot = m_slots[texture];
+        slot.pendingMip = firstMip;
+        m_stats.pendingBytes += mipBytes(slot, firstMip, endMip);
+        m_stats.requests++;
+        if (!urgent) {
+            m_inFlight++;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            (urgent ? m_urgent : m_queue).push_back({texture, firstMip, endMip, urgent, slot.file});
+        }
+        m_wake.notify_one();
+    }
+
+    void TextureStreamer::applyCompletions() {
+        std::vector<LoadRequest> completed;
+        {
+            std::lock_guard lock(m_mutex);
+            completed.swap(m_completed);
+        }
+
+        for (const LoadRequest &request : completed) {
+            Slot &slot = m_slots[request.texture];
+            const uint64_t bytes = mipBytes(slot, request.firstMip, request.endMip);
+            m_stats.pendingBytes -= bytes;
+            m_stats.completedRequests++;
+            if (!request.urgent) {
+                m_inFlight--;
+            }
+
+            slot.pendingMip = kNone;
+            if (slot.removed) {
+                destroySlot(request.texture);
+                continue;
+            }
+            slot.residentMip = request.firstMip;
+            m_stats.residentBytes += bytes;
+            m_backend.setResidentMips(request.texture, slot.residentMip);
+        }
+    }
+
+    bool TextureStreamer::makeRoom(uint64_t bytes, uint32_t requester) {
+        const uint64_t requesterFrame = m_slots[requester].lastUsedFrame;
+        const uint64_t used = m_stats.residentBytes + m_stats.pendingBytes + bytes;
+        if (used <= m_config.budgetBytes) {
+            return true;
+        }
+
+        // Make sure enough can go before taking anything, a victim robbed for a request that
+        // then stalls would just load the same mip again next frame
+        const uint64_t needed = used - m_config.budgetBytes;
+        uint64_t freeable = 0;
+        for (uint32_t texture = m_lruTail; texture != kNone && freeable < needed; texture = m_slots[texture].lruPrev) {
+            const Slot &slot = m_slots[texture];
+            if (texture == requester || slot.pendingMip != kNone) {
+                continue;
+            }
+            const uint32_t limit = slot.lastUsedFrame < requesterFrame
+                                       ? slot.tailMip
+                                       : std::min(effectiveWantedMip(slot), slot.tailMip);
+            for (uint32_t mip = slot.residentMip; mip < limit && freeable < needed; mip++) {
+                freeable += mipBytes(slot, mip, mip + 1);
+            }
+        }
+        if (freeable < needed) {
+            return false;
+        }
+
+        uint32_t cursor = m_lruTail;
+        while (m_stats.residentBytes + m_stats.pendingBytes + bytes > m_config.budgetBytes) {
+            // Walk from the least recently used end, a texture stays the victim until it is down to its tail
+            for (; cursor != kNone; cursor = m_slots[cursor].lruPrev) {
+                const Slot &slot = m_slots[cursor];
+                if (cursor == requester || slot.pendingMip != kNone || slot.residentMip >= slot.tailMip) {
+                    continue;
+                }
+                // Only take detail that is not wanted any more, or that was seen before the requester was
+                if (slot.residentMip < effectiveWantedMip(slot) || slot.lastUsedFrame < requesterFrame) {
+                    break;
+                }
+            }
+            if (cursor == kNone) {
+                return false;
+            }
+            evictMip(cursor);
+        }
+        return true;
+    }
+
+    void TextureStreamer::evictMip(uint32_t texture) {
+        Slot &slot = m_slots[texture];
+        m_stats.residentBytes -= mipBytes(slot, slot.residentMip, slot.residentMip + 1);
+        m_stats.evictedMips++;
+        slot.residentMip++;
+        m_backend.evictMips(texture, slot.residentMip);
+    }
+
+    void TextureStreamer::destroySlot(uint32_t texture) {
+        Slot &slot = m_slots[texture];
+        if (slot.residentMip < slot.mipCount) {
+            m_stats.residentBytes -= mipBytes(slot, slot.residentMip, slot.mipCount);
+        }
+        m_backend.destroyTexture(texture);
+        slot = {};
+        m_freeSlots.push_back(texture);
+    }
+
+    void TextureStreamer::lruUnlink(uint32_t texture) {
+        Slot &slot = m_slots[texture];
+        if (slot.lruPrev != kNone) {
+            m_slots[slot.lruPrev].lruNext = slot.lruNext;
+        } else if (m_lruHead == texture) {
+            m_lruHead = slot.lruNext;
+        }
+        if (slot.lruNext != kNone) {
+            m_slots[slot.lruNext].lruPrev = slot.lruPrev;
+        } else if (m_lruTail == texture) {
+            m_lruTail = slot.lruPrev;
+        }
+        slot.lruPrev = kNone;
+        slot.lruNext = kNone;
+    }
+
+    void TextureStreamer::lruPushFront(uint32_t texture) {
+        Slot &slot = m_slots[texture];
+        slot.lruPrev = kNone;
+        slot.lruNext = m_lruHead;
+        if (m_lruHead != kNone) {
+            m_slots[m_lruHead].lruPrev = texture;
+        }
+        m_lruHead = texture;
+        if (m_lruTail == kNone) {
+            m_lruTail = texture;
+        }
+    }
+
+    uint32_t TextureStreamer::effectiveWantedMip(const Slot &slot) const {
+        // Feedback goes stale when a texture stops being drawn, after that only the tail is wanted
+        return m_frame - slot.lastUsedFrame <= m_config.feedbackFrames ? slot.wantedMip : slot.tailMip;
+    }
+
+    uint64_t TextureStreamer::mipBytes(const Slot &slot, uint32_t firstMip, uint32_t endMip) const {
+        uint64_t bytes = 0;
+        for (uint32_t mip = firstMip; mip < endMip; mip++) {
+            bytes += slot.file->getMip(mip).size;
+        }
+        return bytes;
+    }
+}
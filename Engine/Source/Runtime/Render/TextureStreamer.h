@@ -0,0 +1,159 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef TEXTURESTREAMER_H
+#define TEXTURESTREAMER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TextureUploadBackend.h"
+#include "Asset/TextureFile.h"
+
+namespace Trin::Runtime::Render {
+struct TextureStreamerConfig {
+    uint64_t budgetBytes = 256ull * 1024 * 1024;
+    uint32_t tailSize = 64;                 // Mips this size or smaller load on add() and are never evicted
+    uint32_t maxRequestsPerUpdate = 16;
+    uint32_t maxInFlight = 32;              // Queued or loading requests, the tail loads excluded
+    uint32_t feedbackFrames = 4;            // Frames a screen size report keeps a texture's detail wanted
+    float lodBias = 0.0f;                   // Positive values stream less detail
+};
+
+struct TextureStreamerStats {
+    uint64_t residentBytes = 0;
+    uint64_t pendingBytes = 0;
+    uint64_t requests = 0;
+    uint64_t completedRequests = 0;
+    uint64_t evictedMips = 0;
+    uint64_t budgetStalls = 0;              // Requests skipped because nothing could be evicted
+};
+
+/**
+ * Keeps each texture's resident mips in line with how large it is on screen.
+ *
+ * A texture starts with only its low resolution tail loaded. Renderers report the screen
+ * size a texture is drawn at, and every update() asks for the next mip up on the textures
+ * that are furthest from the detail they need, one level at a time so the smaller mips of
+ * every visible texture arrive before the larger ones of any. When the budget is full the
+ * least recently seen textures give up their largest mips first.
+ *
+ * Reads and uploads run on a dedicated I/O thread, everything else must be called from a
+ * single thread, usually the render thread once per frame.
+ */
+class TextureStreamer {
+public:
+    static constexpr uint32_t kInvalidTexture = ~0u;
+
+    explicit TextureStreamer(TextureUploadBackend &backend, const TextureStreamerConfig &config = {});
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer &) = delete;
+    TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+    /**
+     * @brief Opens a .ttex file and queues its mip tail
+     * @param path Cooked texture
+     * @return Texture id, kInvalidTexture when the file could not be opened
+     */
+    uint32_t add(const std::string &path);
+
+    /// Frees the texture, once any load for it in flight has finished
+    void remove(uint32_t texture);
+
+    /**
+     * @brief Feedback from rendering, the largest size reported during a frame wins
+     * @param texture Texture that was drawn
+     * @param screenPixels Approximate size it covers on screen along its longest axis
+     */
+    void reportScreenSize(uint32_t texture, float screenPixels);
+
+    /**
+     * @brief Applies finished loads, consumes this frame's feedback and issues new loads
+     * @param frame Monotonic frame number
+     */
+    void update(uint64_t frame);
+
+    /// Blocks until every queued load has finished and been applied, for loading screens and tests
+    void flush();
+
+    /// First mip that may be sampled, the mip count while not even the tail is loaded
+    [[nodiscard]] uint32_t getResidentMip(uint32_t texture) const { return m_slots[texture].residentMip; }
+    [[nodiscard]] uint32_t getWantedMip(uint32_t texture) const { return effectiveWantedMip(m_slots[texture]); }
+    [[nodiscard]] uint32_t getMipCount(uint32_t texture) const { return m_slots[texture].mipCount; }
+    [[nodiscard]] const TextureStreamerStats &getStats() const { return m_stats; }
+
+private:
+    static constexpr uint32_t kNone = ~0u;
+
+    struct Slot {
+        std::shared_ptr<const Asset::TextureFile> file;
+        uint32_t mipCount = 0;
+        uint32_t tailMip = 0;
+        uint32_t residentMip = 0;
+        uint32_t pendingMip = kNone;        // First mip of the load in flight
+        uint32_t wantedMip = 0;
+        uint32_t reportedMip = kNone;       // Smallest mip reported since the last update
+        uint64_t lastUsedFrame = 0;
+        uint32_t lruPrev = kNone;           // Towards more recently used
+        uint32_t lruNext = kNone;           // Towards less recently used
+        bool live = false;
+        bool removed = false;
+    };
+
+    struct LoadRequest {
+        uint32_t texture;
+        uint32_t firstMip;
+        uint32_t endMip;
+        bool urgent;
+        std::shared_ptr<const Asset::TextureFile> file;
+    };
+
+    void ioLoop();
+    void queueLoad(uint32_t texture, uint32_t firstMip, uint32_t endMip, bool urgent);
+    void applyCompletions();
+    bool makeRoom(uint64_t bytes, uint32_t requester);
+    void evictMip(uint32_t texture);
+    void destroySlot(uint32_t texture);
+
+    void lruUnlink(uint32_t texture);
+    void lruPushFront(uint32_t texture);
+
+    [[nodiscard]] uint32_t effectiveWantedMip(const Slot &slot) const;
+    [[nodiscard]] uint64_t mipBytes(const Slot &slot, uint32_t firstMip, uint32_t endMip) const;
+
+    TextureUploadBackend &m_backend;
+    TextureStreamerConfig m_config;
+    TextureStreamerStats m_stats;
+    uint64_t m_frame = 0;
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<uint32_t> m_reported;       // Textures with feedback since the last update
+    std::vector<uint32_t> m_candidates;
+    uint32_t m_lruHead = kNone;
+    uint32_t m_lruTail = kNone;
+    uint32_t m_inFlight = 0;
+
+    // Shared with the I/O thread
+    std::thread m_ioThread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<LoadRequest> m_urgent;
+    std::deque<LoadRequest> m_queue;
+    std::vector<LoadRequest> m_completed;
+    bool m_ioBusy = false;
+    bool m_stopping = false;
+};
+
+}
+
+#endif //TEXTURESTREAMER_H
@@ -0,0 +1,81 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "TextureUploadBackend.h"
+
+#include <algorithm>
+
+namespace Trin::Runtime::Render {
+    void MockTextureBackend::createTexture(uint32_t texture, const StreamedTextureDesc &desc) {
+        std::lock_guard lock(m_mutex);
+        MockTexture &mock = m_textures[texture];
+        mock.desc = desc;
+        mock.residentMip = desc.mipCount;
+        mock.mips.assign(desc.mipCount, {});
+    }
+
+    void MockTextureBackend::uploadMip(uint32_t texture, uint32_t mip, std::span<const std::byte> data) {
+        std::lock_guard lock(m_mutex);
+        MockTexture &mock = m_textures.at(texture);
+        m_allocatedBytes -= mock.mips[mip].size();
+        mock.mips[mip].assign(data.begin(), data.end());
+        m_allocatedBytes += data.size();
+        m_uploadedBytes += data.size();
+        m_uploadCount++;
+    }
+
+    void MockTextureBackend::setResidentMips(uint32_t texture, uint32_t firstMip) {
+        std::lock_guard lock(m_mutex);
+        m_textures.at(texture).residentMip = firstMip;
+    }
+
+    void MockTextureBackend::evictMips(uint32_t texture, uint32_t firstMip) {
+        std::lock_guard lock(m_mutex);
+        MockTexture &mock = m_textures.at(texture);
+        for (uint32_t mip = 0; mip < firstMip; mip++) {
+            m_allocatedBytes -= mock.mips[mip].size();
+            mock.mips[mip] = {};
+        }
+        mock.residentMip = std::max(mock.residentMip, firstMip);
+    }
+
+    void MockTextureBackend::destroyTexture(uint32_t texture) {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_textures.find(texture);
+        if (it == m_textures.end()) {
+            return;
+        }
+        for (const auto &mip : it->second.mips) {
+            m_allocatedBytes -= mip.size();
+        }
+        m_textures.erase(it);
+    }
+
+    uint32_t MockTextureBackend::getResidentMip(uint32_t texture) const {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_textures.find(texture);
+        return it == m_textures.end() ? 0 : it->second.residentMip;
+    }
+
+    uint64_t MockTextureBackend::getAllocatedBytes() const {
+        std::lock_guard lock(m_mutex);
+        return m_allocatedBytes;
+    }
+
+    uint64_t MockTextureBackend::getUploadedBytes() const {
+        std::lock_guard lock(m_mutex);
+        return m_uploadedBytes;
+    }
+
+    uint32_t MockTextureBackend::getUploadCount() const {
+        std::lock_guard lock(m_mutex);
+        return m_uploadCount;
+    }
+
+    bool MockTextureBackend::hasMip(uint32_t texture, uint32_t mip) const {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_textures.find(texture);
+        return it != m_textures.end() && mip < it->second.mips.size() && !it->second.mips[mip].empty();
+    }
+}
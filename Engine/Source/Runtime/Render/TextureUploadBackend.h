@@ -0,0 +1,89 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef TEXTUREUPLOADBACKEND_H
+#define TEXTUREUPLOADBACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Trin::Runtime::Render {
+/// What the backend needs to know to create the image for a streamed texture
+struct StreamedTextureDesc {
+    uint32_t format;        // VkFormat
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+};
+
+/**
+ * Where the TextureStreamer sends mip data.
+ *
+ * uploadMip() runs on the streamer's I/O thread, everything else on the thread that calls
+ * TextureStreamer::update(). A GPU backend copies through a staging ring on a transfer queue
+ * and clamps each image's min LOD to the first resident mip.
+ */
+class TextureUploadBackend {
+public:
+    virtual ~TextureUploadBackend() = default;
+
+    /// A texture was added, nothing of it is resident yet
+    virtual void createTexture(uint32_t texture, const StreamedTextureDesc &desc) = 0;
+
+    /// I/O thread, copies one mip level into the texture's storage
+    virtual void uploadMip(uint32_t texture, uint32_t mip, std::span<const std::byte> data) = 0;
+
+    /// Uploaded mips from firstMip down to the smallest may now be sampled
+    virtual void setResidentMips(uint32_t texture, uint32_t firstMip) = 0;
+
+    /// Mips above firstMip are no longer needed and their memory can be reused
+    virtual void evictMips(uint32_t texture, uint32_t firstMip) = 0;
+
+    /// The texture was removed and no uploads for it are in flight
+    virtual void destroyTexture(uint32_t texture) = 0;
+};
+
+/**
+ * Backend that keeps the mips in system memory.
+ *
+ * Lets the streaming and eviction policy run without a device, and records enough to check
+ * what a GPU backend would have been asked to do.
+ */
+class MockTextureBackend final : public TextureUploadBackend {
+public:
+    void createTexture(uint32_t texture, const StreamedTextureDesc &desc) override;
+    void uploadMip(uint32_t texture, uint32_t mip, std::span<const std::byte> data) override;
+    void setResidentMips(uint32_t texture, uint32_t firstMip) override;
+    void evictMips(uint32_t texture, uint32_t firstMip) override;
+    void destroyTexture(uint32_t texture) override;
+
+    /// First mip shaders would sample, the mip count when nothing is resident
+    [[nodiscard]] uint32_t getResidentMip(uint32_t texture) const;
+    /// Bytes held for mips that are uploaded and not evicted
+    [[nodiscard]] uint64_t getAllocatedBytes() const;
+    [[nodiscard]] uint64_t getUploadedBytes() const;
+    [[nodiscard]] uint32_t getUploadCount() const;
+    [[nodiscard]] bool hasMip(uint32_t texture, uint32_t mip) const;
+
+private:
+    struct MockTexture {
+        StreamedTextureDesc desc{};
+        uint32_t residentMip = 0;
+        std::vector<std::vector<std::byte>> mips;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint32_t, MockTexture> m_textures;
+    uint64_t m_allocatedBytes = 0;
+    uint64_t m_uploadedBytes = 0;
+    uint32_t m_uploadCount = 0;
+};
+
+}
+
+#endif //TEXTUREUPLOADBACKEND_H
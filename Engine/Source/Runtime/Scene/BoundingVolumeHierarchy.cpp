@@ -0,0 +1,643 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Math/Simd.h"
+
+namespace Trin::Runtime::Scene {
+    using Simd::Float4;
+
+    namespace {
+        struct NodeBoxes {
+            Float4 minX, minY, minZ, maxX, maxY, maxZ;
+
+            explicit NodeBoxes(const BvhNode &node)
+                : minX(Float4::load(node.minX)), minY(Float4::load(node.minY)), minZ(Float4::load(node.minZ)),
+                  maxX(Float4::load(node.maxX)), maxY(Float4::load(node.maxY)), maxZ(Float4::load(node.maxZ)) {}
+        };
+
+        /**
+         * @brief Tests the four child boxes of a node against every frustum plane at once
+         * @param outsideMask Lanes that are completely behind at least one plane
+         * @param insideMask Lanes that are completely in front of every plane
+         */
+        void testFrustum(const BvhNode &node, const Frustum &frustum, int &outsideMask, int &insideMask) {
+            const NodeBoxes boxes(node);
+            const Float4 half(0.5f);
+            const Float4 cx = (boxes.minX + boxes.maxX) * half;
+            const Float4 cy = (boxes.minY + boxes.maxY) * half;
+            const Float4 cz = (boxes.minZ + boxes.maxZ) * half;
+            const Float4 ex = (boxes.maxX - boxes.minX) * half;
+            const Float4 ey = (boxes.maxY - boxes.minY) * half;
+            const Float4 ez = (boxes.maxZ - boxes.minZ) * half;
+            const Float4 zero;
+
+            outsideMask = 0;
+            insideMask = 0xF;
+            for (const Plane &plane : frustum.planes) {
+                const Float4 nx(plane.normal.x), ny(plane.normal.y), nz(plane.normal.z);
+                const Float4 distance = Simd::madd(nx, cx, Simd::madd(ny, cy, Simd::madd(nz, cz, Float4(plane.d))));
+                const Float4 radius = Simd::madd(Float4::abs(nx), ex, Simd::madd(Float4::abs(ny), ey, Float4::abs(nz) * ez));
+                outsideMask |= (distance + radius < zero).mask();
+                insideMask &= (distance - radius >= zero).mask();
+            }
+        }
+    }
+
+    // ==============
+    //    EDITING
+    // ==============
+
+    BvhProxy BoundingVolumeHierarchy::insert(const AABB &bounds, uint32_t userData) {
+        BvhProxy proxy;
+        if (!m_freeProxies.empty()) {
+            proxy = m_freeProxies.back();
+            m_freeProxies.pop_back();
+        } else {
+            proxy = static_cast<BvhProxy>(m_proxyBounds.size());
+            m_proxyBounds.emplace_back();
+            m_proxyUserData.push_back(0);
+            m_proxyNode.push_back(kNoNode);
+            m_proxyLane.push_back(0);
+        }
+        m_proxyBounds[proxy] = bounds;
+        m_proxyUserData[proxy] = userData;
+        m_liveProxies++;
+
+        insertIntoTree(proxy);
+        m_treeEdits++;
+        return proxy;
+    }
+
+    void BoundingVolumeHierarchy::remove(BvhProxy proxy) {
+        const uint32_t node = m_proxyNode[proxy];
+        if (node != kNoNode) {
+            clearLane(node, m_proxyLane[proxy]);
+            markDirty(node);
+        }
+        m_proxyNode[proxy] = kNoNode;
+        m_freeProxies.push_back(proxy);
+        m_liveProxies--;
+        m_treeEdits++;
+    }
+
+    void BoundingVolumeHierarchy::update(BvhProxy proxy, const AABB &bounds) {
+        m_proxyBounds[proxy] = bounds;
+        const uint32_t node = m_proxyNode[proxy];
+        const uint32_t lane = m_proxyLane[proxy];
+
+        // The rest of the node is what the box was grouped with, measuring against it rather
+        // than the whole node keeps a slow drift from dragging the reference along
+        const BvhNode &n = m_nodes[node];
+        AABB siblings;
+        for (uint32_t other = 0; other < 4; other++) {
+            if (other != lane && (n.validMask & (1u << other))) {
+                siblings.expand(AABB({n.minX[other], n.minY[other], n.minZ[other]},
+                                     {n.maxX[other], n.maxY[other], n.maxZ[other]}));
+            }
+        }
+        if (!siblings.empty()) {
+            const Vector3 half = siblings.extent();
+            const float slack = std::max({half.x, half.y, half.z}) * 2.0f * kReinsertSlack;
+            if (bounds.min.x < siblings.min.x - slack || bounds.min.y < siblings.min.y - slack ||
+                bounds.min.z < siblings.min.z - slack || bounds.max.x > siblings.max.x + slack ||
+                bounds.max.y > siblings.max.y + slack || bounds.max.z > siblings.max.z + slack) {
+                clearLane(node, lane);
+                markDirty(node);
+                insertIntoTree(proxy);
+                m_treeEdits++;
+                return;
+            }
+        }
+
+        setLane(node, lane, bounds, encodeProxy(proxy));
+        markDirty(node);
+    }
+
+    void BoundingVolumeHierarchy::build() {
+        std::vector<BuildItem> items;
+        items.reserve(m_liveProxies);
+        for (BvhProxy proxy = 0; proxy < m_proxyBounds.size(); proxy++) {
+            if (m_proxyNode[proxy] == kNoNode) {
+                continue;
+            }
+            items.push_back({m_proxyBounds[proxy], m_proxyBounds[proxy].center(), proxy});
+        }
+
+        m_nodes.clear();
+        m_nodeDirty.clear();
+        m_dirtyNodes.clear();
+        m_nodeArea = 0.0;
+        m_builtCost = 0.0f;
+        m_root = kNoNode;
+        m_treeEdits = 0;
+
+        if (items.empty()) {
+            return;
+        }
+        // Roughly one node per three boxes for a four wide tree
+        m_nodes.reserve(items.size() / 3 + 1);
+        m_nodeDirty.reserve(items.size() / 3 + 1);
+        buildNode(items, 0, static_cast<uint32_t>(items.size()), kNoNode, 0);
+        m_root = 0;
+        m_builtCost = getSahCost();
+    }
+
+    float BoundingVolumeHierarchy::getSahCost() const {
+        if (m_root == kNoNode) {
+            return 0.0f;
+        }
+        const float rootArea = nodeBounds(m_root).surfaceArea();
+        return rootArea > 0.0f ? static_cast<float>(1.0 + m_nodeArea / rootArea) : 0.0f;
+    }
+
+    void BoundingVolumeHierarchy::refit() {
+        // Children always have higher indices than their parents, so draining the
+        // highest index first finishes every child before its parent is looked at
+        while (!m_dirtyNodes.empty()) {
+            std::pop_heap(m_dirtyNodes.begin(), m_dirtyNodes.end());
+            const uint32_t node = m_dirtyNodes.back();
+            m_dirtyNodes.pop_back();
+            m_nodeDirty[node] = 0;
+
+            const uint32_t parent = m_nodes[node].parent;
+            if (parent == kNoNode) {
+                continue;
+            }
+
+            const uint32_t lane = m_nodes[node].parentLane;
+            const BvhNode &p = m_nodes[parent];
+            if (m_nodes[node].validMask == 0) {
+                if (p.validMask & (1u << lane)) {
+                    clearLane(parent, lane);
+                    markDirty(parent);
+                }
+                continue;
+            }
+
+            const AABB bounds = nodeBounds(node);
+            if (p.minX[lane] != bounds.min.x || p.minY[lane] != bounds.min.y || p.minZ[lane] != bounds.min.z ||
+                p.maxX[lane] != bounds.max.x || p.maxY[lane] != bounds.max.y || p.maxZ[lane] != bounds.max.z) {
+                setLane(parent, lane, bounds, static_cast<int32_t>(node));
+                markDirty(parent);
+            }
+        }
+    }
+
+    // ==============
+    //    QUERIES
+    // ==============
+
+    void BoundingVolumeHierarchy::queryFrustum(const Frustum &frustum, std::vector<uint32_t> &out) {
+        refit();
+        if (m_root != kNoNode) {
+            collectFrustum(frustum, {static_cast<int32_t>(m_root), false}, out);
+        }
+    }
+
+    void BoundingVolumeHierarchy::queryFrustumParallel(const Frustum &frustum, std::vector<uint32_t> &out,
+                                                       Core::JobSystem &jobs) {
+        refit();
+        if (m_root == kNoNode) {
+            return;
+        }
+
+        // Open the top of the tree level by level, in lane order, until there are enough
+        // subtrees to keep every thread busy. Keeping lane order means concatenating the
+        // per subtree results gives exactly what the serial walk would have produced.
+        const size_t targetItems = static_cast<size_t>(jobs.getThreadCount()) * 8;
+        std::vector<TraversalEntry> frontier{{static_cast<int32_t>(m_root), false}};
+        std::vector<TraversalEntry> next;
+        for (bool opened = true; opened && frontier.size() < targetItems;) {
+            opened = false;
+            next.clear();
+            for (const TraversalEntry &entry : frontier) {
+                if (entry.child < 0 || entry.inside) {
+                    next.push_back(entry);
+                    continue;
+                }
+                opened = true;
+                const BvhNode &node = m_nodes[entry.child];
+                int outside = 0, inside = 0;
+                testFrustum(node, frustum, outside, inside);
+                const int visible = static_cast<int>(node.validMask) & ~outside;
+                for (int lane = 0; lane < 4; lane++) {
+                    if (visible & (1 << lane)) {
+                        next.push_back({node.child[lane], (inside & (1 << lane)) != 0});
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+
+        std::vector<std::vector<uint32_t>> results(frontier.size());
+        jobs.parallelFor(static_cast<uint32_t>(frontier.size()), 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                collectFrustum(frustum, frontier[i], results[i]);
+            }
+        });
+
+        size_t total = out.size();
+        for (const auto &result : results) {
+            total += result.size();
+        }
+        out.reserve(total);
+        for (const auto &result : results) {
+            out.insert(out.end(), result.begin(), result.end());
+        }
+    }
+
+    void BoundingVolumeHierarchy::querySphere(const Sphere &sphere, std::vector<uint32_t> &out) {
+        refit();
+        if (m_root == kNoNode) {
+            return;
+        }
+
+        const Float4 cx(sphere.center.x), cy(sphere.center.y), cz(sphere.center.z);
+        const Float4 radiusSq(sphere.radius * sphere.radius);
+        const Float4 zero;
+
+        std::vector<uint32_t> stack{m_root};
+        while (!stack.empty()) {
+            const BvhNode &node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            const NodeBoxes boxes(node);
+            // Distance from the centre to the closest point of each box
+            const Float4 dx = Float4::max(Float4::max(boxes.minX - cx, cx - boxes.maxX), zero);
+            const Float4 dy = Float4::max(Float4::max(boxes.minY - cy, cy - boxes.maxY), zero);
+            const Float4 dz = Float4::max(Float4::max(boxes.minZ - cz, cz - boxes.maxZ), zero);
+            const Float4 distanceSq = Simd::madd(dx, dx, Simd::madd(dy, dy, dz * dz));
+            const int hit = (distanceSq <= radiusSq).mask() & static_cast<int>(node.validMask);
+
+            for (int lane = 3; lane >= 0; lane--) {
+                if (!(hit & (1 << lane))) {
+                    continue;
+                }
+                const int32_t child = node.child[lane];
+                if (child < 0) {
+                    out.push_back(m_proxyUserData[decodeProxy(child)]);
+                } else {
+                    stack.push_back(static_cast<uint32_t>(child));
+                }
+            }
+        }
+    }
+
+    void BoundingVolumeHierarchy::queryRay(const Ray &ray, float maxDistance, std::vector<uint32_t> &out) {
+        refit();
+        if (m_root == kNoNode) {
+            return;
+        }
+
+        // An axis the direction has no finite inverse for, zero or denormal, would give 0 * inf = NaN
+        // for a ray starting on a slab plane and the min / max below would drop the box. The ray is
+        // parallel to that slab, so it is either inside it for its whole length or never
+        const float origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+        const float direction[3] = {ray.direction.x, ray.direction.y, ray.direction.z};
+        Float4 o[3], inverse[3];
+        bool parallel[3];
+        for (int axis = 0; axis < 3; axis++) {
+            const float reciprocal = 1.0f / direction[axis];
+            parallel[axis] = !std::isfinite(reciprocal);
+            o[axis] = Float4(origin[axis]);
+            inverse[axis] = Float4(parallel[axis] ? 0.0f : reciprocal);
+        }
+        const Float4 zero, limit(maxDistance), always(-INFINITY), never(INFINITY);
+        const auto slab = [&](int axis, Float4 min, Float4 max, Float4 &tNear, Float4 &tFar) {
+            if (parallel[axis]) {
+                const Float4 inside = (min <= o[axis]) & (o[axis] <= max);
+                tNear = Float4::select(never, always, inside);
+                tFar = Float4::select(always, never, inside);
+                return;
+            }
+            const Float4 t0 = (min - o[axis]) * inverse[axis], t1 = (max - o[axis]) * inverse[axis];
+            tNear = Float4::min(t0, t1);
+            tFar = Float4::max(t0, t1);
+        };
+
+        std::vector<uint32_t> stack{m_root};
+        while (!stack.empty()) {
+            const BvhNode &node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            // Slab test on all four boxes
+            const NodeBoxes boxes(node);
+            Float4 nearX, farX, nearY, farY, nearZ, farZ;
+            slab(0, boxes.minX, boxes.maxX, nearX, farX);
+            slab(1, boxes.minY, boxes.maxY, nearY, farY);
+            slab(2, boxes.minZ, boxes.maxZ, nearZ, farZ);
+            const Float4 tNear = Float4::max(Float4::max(nearX, nearY), Float4::max(nearZ, zero));
+            const Float4 tFar = Float4::min(Float4::min(farX, farY), Float4::min(farZ, limit));
+            const int hit = (tNear <= tFar).mask() & static_cast<int>(node.validMask);
+
+            for (int lane = 3; lane >= 0; lane--) {
+                if (!(hit & (1 << lane))) {
+                    continue;
+                }
+                const int32_t child = node.child[lane];
+                if (child < 0) {
+                    out.push_back(m_proxyUserData[decodeProxy(child)]);
+                } else {
+                    stack.push_back(static_cast<uint32_t>(child));
+                }
+            }
+        }
+    }
+
+    // ==============
+    //   INTERNALS
+    // ==============
+
+    uint32_t BoundingVolumeHierarchy::allocateNode(uint32_t parent, uint32_t parentLane) {
+        BvhNode node{};
+        for (int lane = 0; lane < 4; lane++) {
+            node.minX[lane] = node.minY[lane] = node.minZ[lane] = FLT_MAX;
+            node.maxX[lane] = node.maxY[lane] = node.maxZ[lane] = -FLT_MAX;
+            node.child[lane] = kEmptyChild;
+        }
+        node.parent = parent;
+        node.parentLane = parentLane;
+        node.validMask = 0;
+        m_nodes.push_back(node);
+        m_nodeDirty.push_back(0);
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    void BoundingVolumeHierarchy::setLane(uint32_t node, uint32_t lane, const AABB &bounds, int32_t child) {
+        m_nodeArea -= nodeLaneArea(node, lane);
+        if (child >= 0) {
+            m_nodeArea += bounds.surfaceArea();
+        }
+
+        BvhNode &n = m_nodes[node];
+        n.minX[lane] = bounds.min.x;
+        n.minY[lane] = bounds.min.y;
+        n.minZ[lane] = bounds.min.z;
+        n.maxX[lane] = bounds.max.x;
+        n.maxY[lane] = bounds.max.y;
+        n.maxZ[lane] = bounds.max.z;
+        n.child[lane] = child;
+        n.validMask |= 1u << lane;
+
+        if (child >= 0) {
+            m_nodes[child].parent = node;
+            m_nodes[child].parentLane = lane;
+        } else {
+            const BvhProxy proxy = decodeProxy(child);
+            m_proxyNode[proxy] = node;
+            m_proxyLane[proxy] = static_cast<uint8_t>(lane);
+        }
+    }
+
+    void BoundingVolumeHierarchy::clearLane(uint32_t node, uint32_t lane) {
+        m_nodeArea -= nodeLaneArea(node, lane);
+
+        BvhNode &n = m_nodes[node];
+        n.minX[lane] = n.minY[lane] = n.minZ[lane] = FLT_MAX;
+        n.maxX[lane] = n.maxY[lane] = n.maxZ[lane] = -FLT_MAX;
+        n.child[lane] = kEmptyChild;
+        n.validMask &= ~(1u << lane);
+    }
+
+    AABB BoundingVolumeHierarchy::nodeBounds(uint32_t node) const {
+        const BvhNode &n = m_nodes[node];
+        AABB out;
+        for (int lane = 0; lane < 4; lane++) {
+            if (n.validMask & (1u << lane)) {
+                out.expand(AABB({n.minX[lane], n.minY[lane], n.minZ[lane]}, {n.maxX[lane], n.maxY[lane], n.maxZ[lane]}));
+            }
+        }
+        return out;
+    }
+
+    float BoundingVolumeHierarchy::nodeLaneArea(uint32_t node, uint32_t lane) const {
+        const BvhNode &n = m_nodes[node];
+        if (!(n.validMask & (1u << lane)) || n.child[lane] < 0) {
+            return 0.0f;
+        }
+        return AABB({n.minX[lane], n.minY[lane], n.minZ[lane]}, {n.maxX[lane], n.maxY[lane], n.maxZ[lane]}).surfaceArea();
+    }
+
+    void BoundingVolumeHierarchy::markDirty(uint32_t node) {
+        if (!m_nodeDirty[node]) {
+            m_nodeDirty[node] = 1;
+            m_dirtyNodes.push_back(node);
+            std::push_heap(m_dirtyNodes.begin(), m_dirtyNodes.end());
+        }
+    }
+
+    void BoundingVolumeHierarchy::insertIntoTree(BvhProxy proxy) {
+        const AABB &bounds = m_proxyBounds[proxy];
+        if (m_root == kNoNode) {
+            m_root = allocateNode(kNoNode, 0);
+            setLane(m_root, 0, bounds, encodeProxy(proxy));
+            return;
+        }
+
+        uint32_t node = m_root;
+        for (;;) {
+            const BvhNode &n = m_nodes[node];
+            if (n.validMask != 0xF) {
+                for (uint32_t lane = 0; lane < 4; lane++) {
+                    if (!(n.validMask & (1u << lane))) {
+                        setLane(node, lane, bounds, encodeProxy(proxy));
+                        break;
+                    }
+                }
+                markDirty(node);
+                return;
+            }
+
+            // Follow the child that grows the least, measured in surface area
+            uint32_t best = 0;
+            float bestCost = FLT_MAX;
+            for (uint32_t lane = 0; lane < 4; lane++) {
+                const AABB laneBounds({n.minX[lane], n.minY[lane], n.minZ[lane]}, {n.maxX[lane], n.maxY[lane], n.maxZ[lane]});
+                const float cost = AABB::merge(laneBounds, bounds).surfaceArea() - laneBounds.surfaceArea();
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    best = lane;
+                }
+            }
+
+            const int32_t child = n.child[best];
+            if (child >= 0) {
+                node = static_cast<uint32_t>(child);
+                continue;
+            }
+
+            // Landed on a leaf, push it down into a fresh node next to the new box
+            const BvhProxy sibling = decodeProxy(child);
+            const uint32_t fresh = allocateNode(node, best);
+            setLane(fresh, 0, m_proxyBounds[sibling], child);
+            setLane(fresh, 1, bounds, encodeProxy(proxy));
+            setLane(node, best, AABB::merge(m_proxyBounds[sibling], bounds), static_cast<int32_t>(fresh));
+            markDirty(node);
+            return;
+        }
+    }
+
+    uint32_t BoundingVolumeHierarchy::splitBinary(std::vector<BuildItem> &items, uint32_t begin, uint32_t end) const {
+        AABB centroidBounds;
+        for (uint32_t i = begin; i < end; i++) {
+            centroidBounds.expand(items[i].centroid);
+        }
+
+        const float cmin[3] = {centroidBounds.min.x, centroidBounds.min.y, centroidBounds.min.z};
+        const float cmax[3] = {centroidBounds.max.x, centroidBounds.max.y, centroidBounds.max.z};
+        const auto axisValue = [](const Vector3 &v, int axis) { return axis == 0 ? v.x : axis == 1 ? v.y : v.z; };
+
+        int bestAxis = -1;
+        int bestBin = 0;
+        float bestCost = FLT_MAX;
+        for (int axis = 0; axis < 3; axis++) {
+            const float extent = cmax[axis] - cmin[axis];
+            if (extent <= 0.0f) {
+                continue;
+            }
+            const float scale = kSahBins / extent;
+
+            AABB binBounds[kSahBins];
+            uint32_t binCount[kSahBins] = {};
+            for (uint32_t i = begin; i < end; i++) {
+                const int bin = std::min(kSahBins - 1, static_cast<int>((axisValue(items[i].centroid, axis) - cmin[axis]) * scale));
+                binBounds[bin].expand(items[i].bounds);
+                binCount[bin]++;
+            }
+
+            // Sweep from the right to get the cost of every suffix, then from the left
+            float rightArea[kSahBins];
+            uint32_t rightCount[kSahBins];
+            AABB accumulated;
+            uint32_t count = 0;
+            for (int bin = kSahBins - 1; bin > 0; bin--) {
+                accumulated.expand(binBounds[bin]);
+                count += binCount[bin];
+                rightArea[bin] = accumulated.surfaceArea();
+                rightCount[bin] = count;
+            }
+
+            accumulated = AABB();
+            count = 0;
+            for (int bin = 0; bin < kSahBins - 1; bin++) {
+                accumulated.expand(binBounds[bin]);
+                count += binCount[bin];
+                const float cost = static_cast<float>(count) * accumulated.surfaceArea() +
+                                   static_cast<float>(rightCount[bin + 1]) * rightArea[bin + 1];
+                if (count > 0 && rightCount[bin + 1] > 0 && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        uint32_t mid = begin;
+        if (bestAxis >= 0) {
+            const float scale = kSahBins / (cmax[bestAxis] - cmin[bestAxis]);
+            const auto split = std::partition(items.begin() + begin, items.begin() + end, [&](const BuildItem &item) {
+                const int bin = std::min(kSahBins - 1, static_cast<int>((axisValue(item.centroid, bestAxis) - cmin[bestAxis]) * scale));
+                return bin <= bestBin;
+            });
+            mid = static_cast<uint32_t>(split - items.begin());
+        }
+
+        // Every centroid landed in the same spot, fall back to an even split
+        if (mid == begin || mid == end) {
+            mid = begin + (end - begin) / 2;
+        }
+        return mid;
+    }
+
+    void BoundingVolumeHierarchy::buildNode(std::vector<BuildItem> &items, uint32_t begin, uint32_t end,
+                                            uint32_t parent, uint32_t lane) {
+        const uint32_t node = allocateNode(parent, lane);
+
+        // Two binary splits give up to four groups, one per lane
+        uint32_t ranges[4][2];
+        uint32_t rangeCount = 0;
+        const uint32_t mid = splitBinary(items, begin, end);
+        for (const auto &[from, to] : {std::pair{begin, mid}, std::pair{mid, end}}) {
+            if (to - from > 1) {
+                const uint32_t quarter = splitBinary(items, from, to);
+                ranges[rangeCount][0] = from;
+                ranges[rangeCount++][1] = quarter;
+                ranges[rangeCount][0] = quarter;
+                ranges[rangeCount++][1] = to;
+            } else {
+                ranges[rangeCount][0] = from;
+                ranges[rangeCount++][1] = to;
+            }
+        }
+
+        for (uint32_t i = 0; i < rangeCount; i++) {
+            const uint32_t from = ranges[i][0], to = ranges[i][1];
+            AABB bounds;
+            for (uint32_t j = from; j < to; j++) {
+                bounds.expand(items[j].bounds);
+            }
+
+            if (to - from == 1) {
+                setLane(node, i, bounds, encodeProxy(items[from].proxy));
+            } else {
+                // The child index is only known after it is allocated, which is always the next node
+                const auto child = static_cast<int32_t>(m_nodes.size());
+                buildNode(items, from, to, node, i);
+                setLane(node, i, bounds, child);
+            }
+        }
+    }
+
+    void BoundingVolumeHierarchy::collectFrustum(const Frustum &frustum, TraversalEntry start,
+                                                 std::vector<uint32_t> &out) const {
+        std::vector<TraversalEntry> stack{start};
+        while (!stack.empty()) {
+            const TraversalEntry entry = stack.back();
+            stack.pop_back();
+            if (entry.child < 0) {
+                out.push_back(m_proxyUserData[decodeProxy(entry.child)]);
+                continue;
+            }
+            if (entry.inside) {
+                appendSubtree(static_cast<uint32_t>(entry.child), out);
+                continue;
+            }
+
+            const BvhNode &node = m_nodes[entry.child];
+            int outside = 0, inside = 0;
+            testFrustum(node, frustum, outside, inside);
+            const int visible = static_cast<int>(node.validMask) & ~outside;
+
+            // Pushed in reverse so lanes come off the stack in order
+            for (int lane = 3; lane >= 0; lane--) {
+                if (visible & (1 << lane)) {
+                    stack.push_back({node.child[lane], (inside & (1 << lane)) != 0});
+                }
+            }
+        }
+    }
+
+    void BoundingVolumeHierarchy::appendSubtree(uint32_t node, std::vector<uint32_t> &out) const {
+        std::vector<int32_t> stack{static_cast<int32_t>(node)};
+        while (!stack.empty()) {
+            const int32_t current = stack.back();
+            stack.pop_back();
+            if (current < 0) {
+                out.push_back(m_proxyUserData[decodeProxy(current)]);
+                continue;
+            }
+            const BvhNode &n = m_nodes[current];
+            for (int lane = 3; lane >= 0; lane--) {
+                if (n.validMask & (1u << lane)) {
+                    stack.push_back(n.child[lane]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef BOUNDINGVOLUMEHIERARCHY_H
+#define BOUNDINGVOLUMEHIERARCHY_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Math/Bounds.h"
+
+namespace Trin::Runtime::Scene {
+    using namespace Trin::Math;
+
+    using BvhProxy = uint32_t;
+    constexpr BvhProxy kInvalidProxy = std::numeric_limits<BvhProxy>::max();
+
+    /// Four children per node with their bounds stored component by component,
+    /// so one SIMD register holds the same coordinate of every child
+    struct alignas(16) BvhNode {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        int32_t child[4];       // >= 0 is a node index, < 0 is ~proxy, kEmptyChild is unused
+        uint32_t parent;
+        uint32_t parentLane;
+        uint32_t validMask;     // Bit per lane that holds a child
+        uint32_t pad;
+    };
+
+/**
+ * Dynamic four wide bounding volume hierarchy over axis aligned boxes.
+ *
+ * build() does a full binned SAH build, insert() and remove() patch the tree in place and
+ * update() moves a box, with the affected ancestors refit lazily by refit() or the next query.
+ * A box that wanders well away from the rest of its node is reinserted where it now belongs
+ * instead of stretching every box above it. Every node is stored after its parent so a
+ * whole-tree refit is a single reverse pass.
+ */
+class BoundingVolumeHierarchy {
+public:
+    static constexpr int32_t kEmptyChild = std::numeric_limits<int32_t>::min();
+
+    /**
+     * @brief Adds a box to the hierarchy
+     * @param bounds World space bounds of the object
+     * @param userData Value handed back by the queries, usually an entity or draw index
+     */
+    BvhProxy insert(const AABB &bounds, uint32_t userData);
+    void remove(BvhProxy proxy);
+
+    /**
+     * @brief Moves a box, the change reaches the upper levels on the next refit()
+     *
+     * When the box ends up further than kReinsertSlack from the other boxes sharing its node
+     * it is taken out and inserted again, which counts as a tree edit for needsRebuild().
+     */
+    void update(BvhProxy proxy, const AABB &bounds);
+
+    /// Rebuilds the whole tree from scratch using the surface area heuristic
+    void build();
+
+    /// Propagates pending update() calls up the tree, only touching the affected paths
+    void refit();
+
+    /**
+     * @brief True once a fresh build() would pay off
+     *
+     * Either enough inserts, removals and reinserts piled up, or updates stretched the nodes
+     * until the SAH cost of the tree grew kRebuildCostGrowth times past what build() left.
+     */
+    [[nodiscard]] bool needsRebuild() const {
+        return (m_treeEdits > 64 && m_treeEdits * 4 > m_liveProxies) ||
+               (m_builtCost > 0.0f && getSahCost() > m_builtCost * kRebuildCostGrowth);
+    }
+
+    /// Expected number of nodes a random ray visits, the sum of every node's area over the root's
+    [[nodiscard]] float getSahCost() const;
+
+    [[nodiscard]] uint32_t size() const { return m_liveProxies; }
+    [[nodiscard]] uint32_t getNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+    [[nodiscard]] const AABB &getBounds(BvhProxy proxy) const { return m_proxyBounds[proxy]; }
+    [[nodiscard]] uint32_t getUserData(BvhProxy proxy) const { return m_proxyUserData[proxy]; }
+
+    // ==============
+    //    QUERIES
+    // ==============
+
+    /// Appends the user data of every box that is at least partly inside the frustum
+    void queryFrustum(const Frustum &frustum, std::vector<uint32_t> &out);
+
+    /**
+     * @brief Same as queryFrustum, but splits the traversal into subtrees run on the job system
+     * @param frustum Culling volume
+     * @param out Receives the visible user data, in the same order the serial query produces
+     * @param jobs Pool to run the subtrees on
+     */
+    void queryFrustumParallel(const Frustum &frustum, std::vector<uint32_t> &out,
+                              Core::JobSystem &jobs = Core::JobSystem::get());
+
+    void querySphere(const Sphere &sphere, std::vector<uint32_t> &out);
+
+    /// Appends every box the ray passes through before maxDistance, in no particular order
+    void queryRay(const Ray &ray, float maxDistance, std::vector<uint32_t> &out);
+
+private:
+    struct BuildItem {
+        AABB bounds;
+        Vector3 centroid;
+        BvhProxy proxy;
+    };
+
+    struct TraversalEntry {
+        int32_t child;  // Same encoding as BvhNode::child, a node or a single leaf
+        bool inside;    // Already known to be fully inside, no further plane tests needed
+    };
+
+    static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+    static constexpr int kSahBins = 12;
+    // How far past its siblings' bounds a box may move before it is reinserted, in multiples of their largest side
+    static constexpr float kReinsertSlack = 1.0f;
+    static constexpr float kRebuildCostGrowth = 1.5f;
+
+    static int32_t encodeProxy(BvhProxy proxy) { return ~static_cast<int32_t>(proxy); }
+    static BvhProxy decodeProxy(int32_t child) { return static_cast<BvhProxy>(~child); }
+
+    uint32_t allocateNode(uint32_t parent, uint32_t parentLane);
+    void setLane(uint32_t node, uint32_t lane, const AABB &bounds, int32_t child);
+    void clearLane(uint32_t node, uint32_t lane);
+    [[nodiscard]] AABB nodeBounds(uint32_t node) const;
+    [[nodiscard]] float nodeLaneArea(uint32_t node, uint32_t lane) const;
+    void markDirty(uint32_t node);
+
+    void insertIntoTree(BvhProxy proxy);
+    uint32_t splitBinary(std::vector<BuildItem> &items, uint32_t begin, uint32_t end) const;
+    void buildNode(std::vector<BuildItem> &items, uint32_t begin, uint32_t end, uint32_t parent, uint32_t lane);
+
+    void collectFrustum(const Frustum &frustum, TraversalEntry start, std::vector<uint32_t> &out) const;
+    void appendSubtree(uint32_t node, std::vector<uint32_t> &out) const;
+
+    // ==============
+    //     NODES
+    // ==============
+
+    std::vector<BvhNode> m_nodes;
+    uint32_t m_root = kNoNode;
+    std::vector<uint8_t> m_nodeDirty;
+    std::vector<uint32_t> m_dirtyNodes;
+    double m_nodeArea = 0.0;        // Surface area of every lane that holds a node, kept up to date by setLane
+    float m_builtCost = 0.0f;       // getSahCost() right after the last build(), zero before the first
+
+    // ==============
+    //    PROXIES
+    // ==============
+
+    std::vector<AABB> m_proxyBounds;
+    std::vector<uint32_t> m_proxyUserData;
+    std::vector<uint32_t> m_proxyNode;
+    std::vector<uint8_t> m_proxyLane;
+    std::vector<BvhProxy> m_freeProxies;
+    uint32_t m_liveProxies = 0;
+    uint32_t m_treeEdits = 0;
+};
+
+}
+
+#endif //BOUNDINGVOLUMEHIERARCHY_H
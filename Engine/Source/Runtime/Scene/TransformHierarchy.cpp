@@ -0,0 +1,241 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+
+namespace Trin::Runtime::Scene {
+    TransformId TransformHierarchy::create(TransformId parent, const Matrix4 &local) {
+        const uint32_t parentSlot = parent == kInvalidTransform ? kNoParent : m_idToSlot[parent];
+        const uint32_t slot = size();
+
+        TransformId id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<TransformId>(m_idToSlot.size());
+            m_idToSlot.push_back(kNoParent);
+            m_idDirty.push_back(0);
+        }
+
+        m_parentSlot.push_back(parentSlot);
+        m_subtreeSize.push_back(1);
+        m_local.push_back(local);
+        m_world.push_back(local);
+        m_slotToId.push_back(id);
+        m_idToSlot[id] = slot;
+
+        // The back of the arrays is still depth first order when the parent's range ends there,
+        // which is every insert of a tree built top down
+        if (!m_layoutDirty && (parentSlot == kNoParent || parentSlot + m_subtreeSize[parentSlot] == slot)) {
+            for (uint32_t ancestor = parentSlot; ancestor != kNoParent; ancestor = m_parentSlot[ancestor]) {
+                m_subtreeSize[ancestor]++;
+            }
+        } else {
+            m_layoutDirty = true;
+        }
+
+        markDirty(id);
+        return id;
+    }
+
+    void TransformHierarchy::destroy(TransformId id) {
+        const uint32_t slot = m_idToSlot[id];
+        if (m_layoutDirty) {
+            // Descendants may be anywhere until the relayout, which releases them along with this hole
+            release(slot);
+        } else {
+            const uint32_t end = slot + m_subtreeSize[slot];
+            for (uint32_t i = slot; i < end; i++) {
+                release(i);
+            }
+        }
+        m_layoutDirty = true;
+    }
+
+    void TransformHierarchy::setLocal(TransformId id, const Matrix4 &local) {
+        m_local[m_idToSlot[id]] = local;
+        markDirty(id);
+    }
+
+    TransformUpdateStats TransformHierarchy::update(Core::JobSystem *jobs) {
+        m_lastStats = {};
+        if (m_layoutDirty) {
+            relayout();
+        }
+
+        // Resolve the flagged ids to slots, in depth first order
+        m_roots.clear();
+        for (const TransformId id : m_dirtyIds) {
+            if (m_idDirty[id]) {
+                m_idDirty[id] = 0;
+                m_roots.push_back(m_idToSlot[id]);
+            }
+        }
+        m_dirtyIds.clear();
+        std::sort(m_roots.begin(), m_roots.end());
+
+        // Drop every dirty node that already sits inside an earlier dirty subtree
+        uint32_t coveredEnd = 0;
+        uint32_t rootCount = 0;
+        for (const uint32_t slot : m_roots) {
+            if (slot < coveredEnd) {
+                continue;
+            }
+            m_roots[rootCount++] = slot;
+            coveredEnd = slot + m_subtreeSize[slot];
+            m_lastStats.nodesUpdated += m_subtreeSize[slot];
+        }
+        m_roots.resize(rootCount);
+        m_lastStats.subtreesUpdated = rootCount;
+
+        const uint32_t threads = jobs ? jobs->getThreadCount() : 1;
+        if (threads == 1 || m_lastStats.nodesUpdated < kMinNodesPerTask * 2) {
+            for (const uint32_t slot : m_roots) {
+                computeRange(slot, slot + m_subtreeSize[slot]);
+            }
+            m_lastStats.tasks = rootCount > 0 ? 1 : 0;
+            return m_lastStats;
+        }
+
+        // Break large subtrees into their children until every task is a reasonable size.
+        // The node being split is computed here so its children can run independently.
+        const uint32_t target = std::max(kMinNodesPerTask, m_lastStats.nodesUpdated / (threads * 4));
+        m_tasks.clear();
+        m_splitStack.assign(m_roots.rbegin(), m_roots.rend());
+        while (!m_splitStack.empty()) {
+            const uint32_t slot = m_splitStack.back();
+            m_splitStack.pop_back();
+
+            const uint32_t subtreeEnd = slot + m_subtreeSize[slot];
+            if (m_subtreeSize[slot] <= target) {
+                m_tasks.push_back(slot);
+                continue;
+            }
+
+            computeRange(slot, slot + 1);
+            for (uint32_t child = slot + 1; child < subtreeEnd; child += m_subtreeSize[child]) {
+                m_splitStack.push_back(child);
+            }
+        }
+        m_lastStats.tasks = static_cast<uint32_t>(m_tasks.size());
+
+        jobs->parallelFor(m_lastStats.tasks, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const uint32_t slot = m_tasks[i];
+                computeRange(slot, slot + m_subtreeSize[slot]);
+            }
+        });
+
+        return m_lastStats;
+    }
+
+    void TransformHierarchy::markDirty(TransformId id) {
+        if (!m_idDirty[id]) {
+            m_idDirty[id] = 1;
+            m_dirtyIds.push_back(id);
+        }
+    }
+
+    void TransformHierarchy::release(uint32_t slot) {
+        const TransformId id = m_slotToId[slot];
+        if (id == kInvalidTransform) {
+            return;
+        }
+        m_idToSlot[id] = kNoParent;
+        m_idDirty[id] = 0;
+        m_freeIds.push_back(id);
+        m_slotToId[slot] = kInvalidTransform;
+    }
+
+    void TransformHierarchy::relayout() {
+        const uint32_t count = size();
+
+        // Group every slot under its parent, roots under a virtual parent at the end. Counting
+        // sort keeps each group in slot order, so siblings keep the order they were created in.
+        m_childStart.assign(count + 2, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            m_childStart[(m_parentSlot[i] == kNoParent ? count : m_parentSlot[i]) + 1]++;
+        }
+        for (uint32_t i = 0; i <= count; i++) {
+            m_childStart[i + 1] += m_childStart[i];
+        }
+        m_children.resize(count);
+        m_slotScratch.assign(m_childStart.begin(), m_childStart.end() - 1);
+        for (uint32_t i = 0; i < count; i++) {
+            m_children[m_slotScratch[m_parentSlot[i] == kNoParent ? count : m_parentSlot[i]]++] = i;
+        }
+
+        // Walk depth first, a removed node takes its whole subtree with it
+        m_order.clear();
+        m_newSlot.resize(count);
+        m_splitStack.clear();
+        for (uint32_t i = m_childStart[count + 1]; i-- > m_childStart[count];) {
+            m_splitStack.push_back(m_children[i]);
+        }
+        while (!m_splitStack.empty()) {
+            const uint32_t slot = m_splitStack.back();
+            m_splitStack.pop_back();
+            const bool removed = m_slotToId[slot] == kInvalidTransform;
+            if (!removed) {
+                m_newSlot[slot] = static_cast<uint32_t>(m_order.size());
+                m_order.push_back(slot);
+            }
+            for (uint32_t i = m_childStart[slot + 1]; i-- > m_childStart[slot];) {
+                if (removed) {
+                    release(m_children[i]);
+                }
+                m_splitStack.push_back(m_children[i]);
+            }
+        }
+
+        const auto liveCount = static_cast<uint32_t>(m_order.size());
+        m_matrixScratch.resize(liveCount);
+        for (uint32_t i = 0; i < liveCount; i++) {
+            m_matrixScratch[i] = m_local[m_order[i]];
+        }
+        m_local.swap(m_matrixScratch);
+        m_matrixScratch.resize(liveCount);
+        for (uint32_t i = 0; i < liveCount; i++) {
+            m_matrixScratch[i] = m_world[m_order[i]];
+        }
+        m_world.swap(m_matrixScratch);
+
+        m_slotScratch.resize(liveCount);
+        for (uint32_t i = 0; i < liveCount; i++) {
+            const uint32_t parent = m_parentSlot[m_order[i]];
+            m_slotScratch[i] = parent == kNoParent ? kNoParent : m_newSlot[parent];
+        }
+        m_parentSlot.swap(m_slotScratch);
+        m_slotScratch.resize(liveCount);
+        for (uint32_t i = 0; i < liveCount; i++) {
+            m_slotScratch[i] = m_slotToId[m_order[i]];
+            m_idToSlot[m_slotScratch[i]] = i;
+        }
+        m_slotToId.swap(m_slotScratch);
+
+        // Children come after their parent, so one backwards pass sums every subtree
+        m_subtreeSize.assign(liveCount, 1);
+        for (uint32_t i = liveCount; i-- > 0;) {
+            if (m_parentSlot[i] != kNoParent) {
+                m_subtreeSize[m_parentSlot[i]] += m_subtreeSize[i];
+            }
+        }
+        m_layoutDirty = false;
+    }
+
+    void TransformHierarchy::computeRange(uint32_t begin, uint32_t end) {
+        // Depth first order guarantees each parent is finished before its children are reached
+        for (uint32_t i = begin; i < end; i++) {
+            const uint32_t parent = m_parentSlot[i];
+            if (parent == kNoParent) {
+                m_world[i] = m_local[i];
+            } else {
+                Matrix4::multiply(m_world[parent], m_local[i], m_world[i]);
+            }
+        }
+    }
+}
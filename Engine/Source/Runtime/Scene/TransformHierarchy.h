@@ -0,0 +1,135 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Math/Matrix4.h"
+
+namespace Trin::Runtime::Scene {
+    using namespace Trin::Math;
+
+    using TransformId = uint32_t;
+    constexpr TransformId kInvalidTransform = std::numeric_limits<TransformId>::max();
+
+    struct TransformUpdateStats {
+        uint32_t nodesUpdated = 0;      // World matrices recomputed this update
+        uint32_t subtreesUpdated = 0;   // Disjoint dirty subtrees that were walked
+        uint32_t tasks = 0;             // Pieces of work handed to the job system
+    };
+
+/**
+ * Parent/child transforms stored depth first in flat arrays, so every subtree is a
+ * contiguous range and a parent always sits before its children.
+ *
+ * setLocal only flags the node, update() then walks just the dirty subtrees, which keeps
+ * the per frame cost tied to what moved rather than to how big the scene is.
+ *
+ * Structural edits never shift the arrays. New nodes are appended and removed ones are left
+ * as holes, and the next update() restores the depth first layout in a single pass. A tree
+ * built top down, every child added right after its parent's last descendant, stays in
+ * order and skips that pass.
+ */
+class TransformHierarchy {
+public:
+    /**
+     * @brief Adds a node as the last child of parent
+     * @param parent Owning node, kInvalidTransform for a new root
+     * @param local Transform relative to the parent
+     * @return Stable id of the node, unaffected by later inserts and removals
+     */
+    TransformId create(TransformId parent = kInvalidTransform, const Matrix4 &local = Matrix4::identity());
+
+    /**
+     * @brief Removes a node together with all of its children
+     *
+     * The node is invalid straight away. Its descendants are too when the layout is settled,
+     * otherwise they are released by the next update().
+     */
+    void destroy(TransformId id);
+
+    /// Replaces the local transform and flags the node's subtree for the next update
+    void setLocal(TransformId id, const Matrix4 &local);
+
+    [[nodiscard]] const Matrix4 &getLocal(TransformId id) const { return m_local[m_idToSlot[id]]; }
+
+    /// World transform as of the last update()
+    [[nodiscard]] const Matrix4 &getWorld(TransformId id) const { return m_world[m_idToSlot[id]]; }
+
+    [[nodiscard]] TransformId getParent(TransformId id) const {
+        const uint32_t parentSlot = m_parentSlot[m_idToSlot[id]];
+        return parentSlot == kNoParent ? kInvalidTransform : m_slotToId[parentSlot];
+    }
+
+    [[nodiscard]] bool isValid(TransformId id) const {
+        return id < m_idToSlot.size() && m_idToSlot[id] != kNoParent;
+    }
+
+    [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_slotToId.size()); }
+
+    /**
+     * @brief Recomputes the world matrix of every node below a changed node
+     * @param jobs Pool to spread large updates over, nullptr keeps everything on the calling thread
+     * @return How much work this update did, also kept in getLastStats()
+     */
+    TransformUpdateStats update(Core::JobSystem *jobs = &Core::JobSystem::get());
+
+    [[nodiscard]] const TransformUpdateStats &getLastStats() const { return m_lastStats; }
+
+private:
+    static constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+    // Below this many dirty nodes the job system costs more than it saves
+    static constexpr uint32_t kMinNodesPerTask = 2048;
+
+    void markDirty(TransformId id);
+    void release(uint32_t slot);
+    void relayout();
+    void computeRange(uint32_t begin, uint32_t end);
+
+    // ==============
+    //  DEPTH FIRST
+    // ==============
+
+    std::vector<uint32_t> m_parentSlot;
+    std::vector<uint32_t> m_subtreeSize;    // Node plus all descendants, only meaningful while the layout is settled
+    std::vector<Matrix4> m_local;
+    std::vector<Matrix4> m_world;
+    std::vector<TransformId> m_slotToId;    // kInvalidTransform marks a removed node until the next relayout
+    bool m_layoutDirty = false;
+
+    // ==============
+    //      IDS
+    // ==============
+
+    std::vector<uint32_t> m_idToSlot;
+    std::vector<uint8_t> m_idDirty;
+    std::vector<TransformId> m_freeIds;
+    std::vector<TransformId> m_dirtyIds;
+
+    // ==============
+    //    SCRATCH
+    // ==============
+
+    std::vector<uint32_t> m_roots;
+    std::vector<uint32_t> m_tasks;
+    std::vector<uint32_t> m_splitStack;
+
+    std::vector<uint32_t> m_childStart;     // Children of every slot, grouped by parent in slot order
+    std::vector<uint32_t> m_children;
+    std::vector<uint32_t> m_order;          // Old slots in their new depth first order
+    std::vector<uint32_t> m_newSlot;
+    std::vector<Matrix4> m_matrixScratch;
+    std::vector<uint32_t> m_slotScratch;
+
+    TransformUpdateStats m_lastStats;
+};
+
+}
+
+#endif //TRANSFORMHIERARCHY_H
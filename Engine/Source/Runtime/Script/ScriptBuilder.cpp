@@ -0,0 +1,436 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "ScriptBuilder.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdio>
+
+#include "Helpers/Console.h"
+#include "ScriptVM.h"
+
+namespace Trin::Runtime::Script {
+    namespace {
+        enum class Format {
+            ABC,
+            ABx,
+            AsBx
+        };
+
+        Format format(Op op) {
+            switch (op) {
+                case Op::LoadK:
+                case Op::GetGlobal:
+                case Op::SetGlobal:
+                case Op::Native:
+                    return Format::ABx;
+                case Op::LoadI:
+                case Op::Jmp:
+                case Op::JmpIf:
+                case Op::JmpIfNot:
+                case Op::ForPrep:
+                case Op::ForLoop:
+                    return Format::AsBx;
+                default:
+                    return Format::ABC;
+            }
+        }
+
+        bool isJump(Op op) {
+            return format(op) == Format::AsBx && op != Op::LoadI;
+        }
+    }
+
+    const char *Bytecode::name(Op op) {
+        static constexpr const char *kNames[] = {
+#define TRIN_SCRIPT_OPCODE_NAME(name, description) #name,
+            TRIN_SCRIPT_OPCODES(TRIN_SCRIPT_OPCODE_NAME)
+#undef TRIN_SCRIPT_OPCODE_NAME
+        };
+        return op < Op::Count ? kNames[static_cast<uint8_t>(op)] : "Invalid";
+    }
+
+    FunctionBuilder::FunctionBuilder(ScriptVM &vm, std::string_view name, uint8_t paramCount, uint8_t registerCount)
+        : m_vm(vm), m_function(vm.getHeap().newFunction()) {
+        m_function->name = name;
+        m_function->paramCount = paramCount;
+        m_function->registerCount = registerCount;
+        vm.addFunction(m_function);
+    }
+
+    void FunctionBuilder::emit(Op op, uint8_t a, uint8_t b, uint8_t c) {
+        m_function->code.push_back(Bytecode::encode(op, a, b, c));
+    }
+
+    void FunctionBuilder::emitBx(Op op, uint8_t a, uint16_t bx) {
+        m_function->code.push_back(Bytecode::encodeBx(op, a, bx));
+    }
+
+    void FunctionBuilder::loadNumber(uint8_t reg, double value) {
+        // -0.0 passes the range check but would come back as +0
+        const bool negativeZero = value == 0.0 && std::signbit(value);
+        if (value == std::trunc(value) && value >= INT16_MIN && value <= INT16_MAX && !negativeZero) {
+            emitBx(Op::LoadI, reg, static_cast<uint16_t>(static_cast<int16_t>(value)));
+        } else {
+            emitBx(Op::LoadK, reg, constant(value));
+        }
+    }
+
+    void FunctionBuilder::native(uint8_t reg, std::string_view name) {
+        const int32_t index = m_vm.findNative(name);
+        if (index < 0) {
+            Helpers::Console::error(m_function->name + ": no native named " + std::string(name));
+            m_failed = true;
+            return;
+        }
+        emitBx(Op::Native, reg, static_cast<uint16_t>(index));
+    }
+
+    FunctionBuilder::Label FunctionBuilder::label() {
+        m_labels.push_back(-1);
+        return static_cast<Label>(m_labels.size() - 1);
+    }
+
+    void FunctionBuilder::bind(Label label) {
+        m_labels[label] = static_cast<int32_t>(m_function->code.size());
+    }
+
+    void FunctionBuilder::jump(Op op, uint8_t a, Label target) {
+        // Offsets are only known once every label is bound, finish() fills them in
+        m_patches.push_back({static_cast<uint32_t>(m_function->code.size()), target});
+        emitBx(op, a, 0);
+    }
+
+    uint16_t FunctionBuilder::constant(Value value) {
+        std::vector<Value> &constants = m_function->constants;
+        for (size_t i = 0; i < constants.size(); i++) {
+            if (constants[i].bits() == value.bits()) {
+                return static_cast<uint16_t>(i);
+            }
+        }
+        if (constants.size() > UINT16_MAX) {
+            Helpers::Console::error(m_function->name + ": too many constants");
+            m_failed = true;
+            return 0;
+        }
+        m_vm.getHeap().writeBarrier(m_function, value);
+        constants.push_back(value);
+        return static_cast<uint16_t>(constants.size() - 1);
+    }
+
+    uint16_t FunctionBuilder::constant(std::string_view text) {
+        for (size_t i = 0; i < m_function->constants.size(); i++) {
+            const Value existing = m_function->constants[i];
+            if (isType(existing, ObjectType::String) && asString(existing)->view() == text) {
+                return static_cast<uint16_t>(i);
+            }
+        }
+        return constant(Value::object(m_vm.getHeap().newString(text)));
+    }
+
+    Value FunctionBuilder::finish() {
+        std::vector<uint32_t> &code = m_function->code;
+        for (const Patch &patch : m_patches) {
+            const int32_t target = m_labels[patch.target];
+            if (target < 0) {
+                fail(patch.instruction, "jump to a label that was never bound");
+                return Value::nil();
+            }
+            const int32_t offset = target - static_cast<int32_t>(patch.instruction) - 1;
+            if (offset < INT16_MIN || offset > INT16_MAX) {
+                fail(patch.instruction, "jump too far");
+                return Value::nil();
+            }
+            const uint32_t instruction = code[patch.instruction];
+            code[patch.instruction] = Bytecode::encodeBx(Bytecode::op(instruction), Bytecode::a(instruction),
+                                                         static_cast<uint16_t>(static_cast<int16_t>(offset)));
+        }
+        m_patches.clear();
+
+        if (m_failed || !validate()) {
+            return Value::nil();
+        }
+        return Value::object(m_function);
+    }
+
+    bool FunctionBuilder::validate() const {
+        const std::vector<uint32_t> &code = m_function->code;
+        const uint32_t registers = m_function->registerCount;
+        if (m_function->paramCount > registers) {
+            return fail(0, "more parameters than registers");
+        }
+        if (code.empty() || (Bytecode::op(code.back()) != Op::Return && Bytecode::op(code.back()) != Op::Jmp)) {
+            return fail(static_cast<uint32_t>(code.size()), "code can run past the end of the function");
+        }
+
+        for (uint32_t pc = 0; pc < code.size(); pc++) {
+            const uint32_t instruction = code[pc];
+            const Op op = Bytecode::op(instruction);
+            const uint32_t a = Bytecode::a(instruction);
+            const uint32_t b = Bytecode::b(instruction);
+            const uint32_t c = Bytecode::c(instruction);
+            if (op >= Op::Count) {
+                return fail(pc, "invalid opcode");
+            }
+
+            // Highest register the instruction touches through A
+            uint32_t lastA = a;
+            switch (op) {
+                case Op::Jmp:
+                    lastA = 0;
+                    break;
+                case Op::ForPrep:
+                case Op::ForLoop:
+                    lastA = a + 2;
+                    break;
+                case Op::Call:
+                    lastA = a + b;
+                    break;
+                case Op::Native: {
+                    if (Bytecode::bx(instruction) >= m_vm.getNativeCount()) {
+                        return fail(pc, "unknown native");
+                    }
+                    const NativeBinding &native = m_vm.getNative(static_cast<uint16_t>(Bytecode::bx(instruction)));
+                    lastA = a + std::max<uint32_t>(std::max(native.argSlots, native.resultSlots), 1) - 1;
+                    break;
+                }
+                default:
+                    break;
+            }
+            if (lastA >= registers) {
+                return fail(pc, std::string(Bytecode::name(op)) + " uses registers past the frame");
+            }
+
+            switch (op) {
+                case Op::LoadK:
+                    if (Bytecode::bx(instruction) >= m_function->constants.size()) {
+                        return fail(pc, "constant out of range");
+                    }
+                    break;
+                case Op::GetGlobal:
+                case Op::SetGlobal:
+                    if (Bytecode::bx(instruction) >= m_vm.getGlobalCount()) {
+                        return fail(pc, "undefined global");
+                    }
+                    break;
+                case Op::Move:
+                case Op::AddI:
+                case Op::Neg:
+                case Op::Not:
+                case Op::Push:
+                case Op::Len:
+                    if (b >= registers) {
+                        return fail(pc, "B register past the frame");
+                    }
+                    break;
+                case Op::Add:
+                case Op::Sub:
+                case Op::Mul:
+                case Op::Div:
+                case Op::Mod:
+                case Op::Eq:
+                case Op::Lt:
+                case Op::Le:
+                case Op::GetIndex:
+                case Op::SetIndex:
+                    if (b >= registers || c >= registers) {
+                        return fail(pc, "B or C register past the frame");
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            if (isJump(op)) {
+                const int32_t target = static_cast<int32_t>(pc) + 1 + Bytecode::sbx(instruction);
+                if (target < 0 || target >= static_cast<int32_t>(code.size())) {
+                    return fail(pc, "jump out of the function");
+                }
+            }
+        }
+        return validateCallClobbers();
+    }
+
+    bool FunctionBuilder::validateCallClobbers() const {
+        // Forward dataflow over the registers a Call may have clobbered on some path to each
+        // instruction, a read of one of them is a read of whatever the callee left there
+        using Registers = std::bitset<256>;
+        const std::vector<uint32_t> &code = m_function->code;
+        std::vector<Registers> clobbered(code.size());
+        std::vector<bool> reached(code.size(), false);
+        std::vector<uint32_t> pending = {0};
+        reached[0] = true;
+
+        while (!pending.empty()) {
+            const uint32_t pc = pending.back();
+            pending.pop_back();
+            const uint32_t instruction = code[pc];
+            const Op op = Bytecode::op(instruction);
+            const uint32_t a = Bytecode::a(instruction);
+            const uint32_t b = Bytecode::b(instruction);
+            const uint32_t c = Bytecode::c(instruction);
+            Registers state = clobbered[pc];
+
+            uint32_t reads[3];
+            uint32_t readCount = 0;
+            uint32_t firstWrite = a;
+            uint32_t writeCount = 1;
+            switch (op) {
+                case Op::LoadK:
+                case Op::LoadI:
+                case Op::LoadNil:
+                case Op::LoadBool:
+                case Op::GetGlobal:
+                case Op::NewArray:
+                    break;
+                case Op::Move:
+                case Op::AddI:
+                case Op::Neg:
+                case Op::Not:
+                case Op::Len:
+                    reads[readCount++] = b;
+                    break;
+                case Op::Add:
+                case Op::Sub:
+                case Op::Mul:
+                case Op::Div:
+                case Op::Mod:
+                case Op::Eq:
+                case Op::Lt:
+                case Op::Le:
+                case Op::GetIndex:
+                    reads[readCount++] = b;
+                    reads[readCount++] = c;
+                    break;
+                case Op::SetGlobal:
+                case Op::JmpIf:
+                case Op::JmpIfNot:
+                    reads[readCount++] = a;
+                    writeCount = 0;
+                    break;
+                case Op::SetIndex:
+                    reads[readCount++] = a;
+                    reads[readCount++] = b;
+                    reads[readCount++] = c;
+                    writeCount = 0;
+                    break;
+                case Op::Push:
+                    reads[readCount++] = a;
+                    reads[readCount++] = b;
+                    writeCount = 0;
+                    break;
+                case Op::Return:
+                    if (b) {
+                        reads[readCount++] = a;
+                    }
+                    writeCount = 0;
+                    break;
+                case Op::ForPrep:
+                case Op::ForLoop:
+                    reads[readCount++] = a;
+                    reads[readCount++] = a + 1;
+                    reads[readCount++] = a + 2;
+                    break;
+                default:
+                    writeCount = 0;
+                    break;
+            }
+            for (uint32_t i = 0; i < readCount; i++) {
+                if (state.test(reads[i])) {
+                    return fail(pc, "reads R" + std::to_string(reads[i]) + " after a Call clobbered it");
+                }
+            }
+
+            // Ranges that the checks above can't express as three single registers
+            if (op == Op::Call) {
+                for (uint32_t reg = a; reg <= a + b; reg++) {
+                    if (state.test(reg)) {
+                        return fail(pc, "reads R" + std::to_string(reg) + " after a Call clobbered it");
+                    }
+                }
+                for (uint32_t reg = a + 1; reg < state.size(); reg++) {
+                    state.set(reg);
+                }
+                firstWrite = a;
+                writeCount = 1;
+            } else if (op == Op::Native) {
+                const NativeBinding &native = m_vm.getNative(static_cast<uint16_t>(Bytecode::bx(instruction)));
+                for (uint32_t reg = a; reg < a + native.argSlots; reg++) {
+                    if (state.test(reg)) {
+                        return fail(pc, "reads R" + std::to_string(reg) + " after a Call clobbered it");
+                    }
+                }
+                writeCount = native.resultSlots;
+            }
+            for (uint32_t reg = firstWrite; reg < firstWrite + writeCount; reg++) {
+                state.reset(reg);
+            }
+
+            // Successors get the union of every path into them, so the walk stops once nothing grows
+            const auto flow = [&](uint32_t next) {
+                if (next >= code.size()) {
+                    return;
+                }
+                const Registers merged = clobbered[next] | state;
+                if (!reached[next] || merged != clobbered[next]) {
+                    reached[next] = true;
+                    clobbered[next] = merged;
+                    pending.push_back(next);
+                }
+            };
+            if (isJump(op)) {
+                flow(static_cast<uint32_t>(static_cast<int32_t>(pc) + 1 + Bytecode::sbx(instruction)));
+            }
+            if (op != Op::Return && op != Op::Jmp && op != Op::ForPrep) {
+                flow(pc + 1);
+            }
+        }
+        return true;
+    }
+
+    bool FunctionBuilder::fail(uint32_t pc, const std::string &message) const {
+        Helpers::Console::error(m_function->name + ":" + std::to_string(pc) + ": " + message);
+        return false;
+    }
+
+    std::string disassemble(Value function) {
+        if (!isType(function, ObjectType::Function)) {
+            return "<not a function>\n";
+        }
+        const FunctionObject *fn = asFunction(function);
+        std::string out = fn->name + " (" + std::to_string(fn->paramCount) + " params, " +
+                          std::to_string(fn->registerCount) + " registers, " + std::to_string(fn->constants.size()) +
+                          " constants)\n";
+
+        char line[96];
+        for (size_t pc = 0; pc < fn->code.size(); pc++) {
+            const uint32_t instruction = fn->code[pc];
+            const Op op = Bytecode::op(instruction);
+            switch (op < Op::Count ? format(op) : Format::ABC) {
+                case Format::ABC:
+                    std::snprintf(line, sizeof(line), "%4zu  %-9s %3u %3u %3u\n", pc, Bytecode::name(op),
+                                  Bytecode::a(instruction), Bytecode::b(instruction), Bytecode::c(instruction));
+                    break;
+                case Format::ABx:
+                    std::snprintf(line, sizeof(line), "%4zu  %-9s %3u %7u\n", pc, Bytecode::name(op),
+                                  Bytecode::a(instruction), Bytecode::bx(instruction));
+                    break;
+                case Format::AsBx:
+                    if (isJump(op)) {
+                        std::snprintf(line, sizeof(line), "%4zu  %-9s %3u %7d  ; to %zd\n", pc, Bytecode::name(op),
+                                      Bytecode::a(instruction), Bytecode::sbx(instruction),
+                                      static_cast<ptrdiff_t>(pc) + 1 + Bytecode::sbx(instruction));
+                    } else {
+                        std::snprintf(line, sizeof(line), "%4zu  %-9s %3u %7d\n", pc, Bytecode::name(op),
+                                      Bytecode::a(instruction), Bytecode::sbx(instruction));
+                    }
+                    break;
+            }
+            out += line;
+        }
+        return out;
+    }
+}
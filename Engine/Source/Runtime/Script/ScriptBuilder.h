@@ -0,0 +1,84 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTBUILDER_H
+#define SCRIPTBUILDER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ScriptOpcodes.h"
+#include "ScriptValue.h"
+
+namespace Trin::Runtime::Script {
+    class ScriptVM;
+    struct FunctionObject;
+
+/**
+ * Assembles the bytecode of one script function.
+ *
+ * This is what a language front end emits into. Jumps go to labels that can be bound
+ * before or after the jump, and finish() checks every operand against the frame size, the
+ * constant table and the VM's globals and natives, so the interpreter never has to. It also
+ * rejects reads of registers a Call clobbered, on any path, since the callee's window
+ * overlaps everything above the call's A.
+ */
+class FunctionBuilder {
+public:
+    using Label = uint32_t;
+
+    /**
+     * @param vm VM the function will run in, it keeps the function alive
+     * @param name Shown in runtime errors
+     * @param paramCount Arguments arrive in R[0] .. R[paramCount - 1]
+     * @param registerCount Frame size, parameters included
+     */
+    FunctionBuilder(ScriptVM &vm, std::string_view name, uint8_t paramCount, uint8_t registerCount);
+
+    void emit(Op op, uint8_t a = 0, uint8_t b = 0, uint8_t c = 0);
+    void emitBx(Op op, uint8_t a, uint16_t bx);
+
+    /// Smallest instruction that puts the number in a register, LoadI when it fits
+    void loadNumber(uint8_t reg, double value);
+
+    /// Calls a bound native on the registers starting at reg
+    void native(uint8_t reg, std::string_view name);
+
+    [[nodiscard]] Label label();
+    void bind(Label label);
+
+    /// Jmp, JmpIf, JmpIfNot, ForPrep or ForLoop to a label, bound or not
+    void jump(Op op, uint8_t a, Label target);
+
+    uint16_t constant(Value value);
+    uint16_t constant(double value) { return constant(Value::number(value)); }
+    uint16_t constant(std::string_view text);
+
+    /// Validates the code and returns the function, nil when something is wrong with it
+    Value finish();
+
+private:
+    struct Patch {
+        uint32_t instruction;
+        Label target;
+    };
+
+    bool validate() const;
+    bool validateCallClobbers() const;
+    bool fail(uint32_t pc, const std::string &message) const;
+
+    ScriptVM &m_vm;
+    FunctionObject *m_function;
+    std::vector<int32_t> m_labels;      // Instruction index, -1 until bound
+    std::vector<Patch> m_patches;
+    bool m_failed = false;
+};
+
+    /// One line per instruction, for debugging generated code
+    std::string disassemble(Value function);
+}
+
+#endif //SCRIPTBUILDER_H
@@ -0,0 +1,292 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "ScriptHeap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "Helpers/StringId.h"
+#include "Memory/MemoryTracker.h"
+
+namespace Trin::Runtime::Script {
+    namespace {
+        constexpr size_t kMarkBudget = ScriptHeap::kStepBytes * 4;  // Bytes traversed per slice
+        constexpr size_t kSweepBudget = 2048;                       // Objects visited per slice
+
+        size_t roundSize(size_t size) {
+            return (size + ScriptHeap::kSizeClassStep - 1) & ~(ScriptHeap::kSizeClassStep - 1);
+        }
+
+        GcColor otherWhite(GcColor white) {
+            return white == GcColor::White0 ? GcColor::White1 : GcColor::White0;
+        }
+    }
+
+    ScriptHeap::ScriptHeap(ScriptRoots &roots) : m_roots(roots) {}
+
+    ScriptHeap::~ScriptHeap() {
+        for (Object *object = m_objects; object;) {
+            Object *next = object->next;
+            freeObject(object);
+            object = next;
+        }
+        for (void *chunk : m_chunks) {
+            ::operator delete(chunk);
+        }
+        Memory::MemoryTracker::onFree(Memory::MemoryTag::Script, m_chunks.size() * kChunkSize, m_chunks.size());
+    }
+
+    StringObject *ScriptHeap::newString(std::string_view text) {
+        const size_t size = sizeof(StringObject) + text.size() + 1;
+        auto *string = static_cast<StringObject *>(allocateObject(size, ObjectType::String));
+        string->length = static_cast<uint32_t>(text.size());
+        string->hash = static_cast<uint32_t>(Helpers::fnv1a(text));
+        auto *chars = reinterpret_cast<char *>(string + 1);
+        std::memcpy(chars, text.data(), text.size());
+        chars[text.size()] = '\0';
+        return string;
+    }
+
+    ArrayObject *ScriptHeap::newArray(uint32_t capacity) {
+        onAllocate(capacity * sizeof(Value));
+        auto *array = static_cast<ArrayObject *>(allocateObject(sizeof(ArrayObject), ObjectType::Array));
+        array->count = 0;
+        array->capacity = capacity;
+        array->elements = capacity ? static_cast<Value *>(allocateBlock(capacity * sizeof(Value))) : nullptr;
+        m_stats.liveBytes += roundSize(capacity * sizeof(Value));
+        return array;
+    }
+
+    FunctionObject *ScriptHeap::newFunction() {
+        void *memory = allocateObject(sizeof(FunctionObject), ObjectType::Function);
+        // The constructor clears the header, so save and restore it around placement new
+        const Object header = *static_cast<Object *>(memory);
+        auto *function = new (memory) FunctionObject{};
+        static_cast<Object &>(*function) = header;
+        return function;
+    }
+
+    void ScriptHeap::push(ArrayObject *array, Value value) {
+        if (array->count == array->capacity) {
+            const uint32_t capacity = std::max(4u, array->capacity * 2);
+            onAllocate(capacity * sizeof(Value));
+            auto *elements = static_cast<Value *>(allocateBlock(capacity * sizeof(Value)));
+            if (array->count) {
+                std::memcpy(elements, array->elements, array->count * sizeof(Value));
+            }
+            if (array->elements) {
+                freeBlock(array->elements, array->capacity * sizeof(Value));
+                m_stats.liveBytes -= roundSize(array->capacity * sizeof(Value));
+            }
+            array->elements = elements;
+            array->capacity = capacity;
+            m_stats.liveBytes += roundSize(capacity * sizeof(Value));
+        }
+        writeBarrier(array, value);
+        array->elements[array->count++] = value;
+    }
+
+    void ScriptHeap::markObject(Object *object) {
+        if (object->color == m_currentWhite) {
+            object->color = GcColor::Gray;
+            m_gray.push_back(object);
+        }
+    }
+
+    void ScriptHeap::step() {
+        m_stats.steps++;
+        switch (m_phase) {
+            case Phase::Idle:
+                if (m_stats.liveBytes >= m_threshold) {
+                    beginCycle();
+                }
+                break;
+            case Phase::Mark:
+                if (markSlice(kMarkBudget)) {
+                    finishMark();
+                }
+                break;
+            case Phase::Sweep:
+                sweepSlice(kSweepBudget);
+                break;
+        }
+    }
+
+    void ScriptHeap::collect() {
+        if (m_phase == Phase::Idle) {
+            beginCycle();
+        }
+        while (m_phase != Phase::Idle) {
+            if (m_phase == Phase::Mark) {
+                markSlice(SIZE_MAX);
+                finishMark();
+            } else {
+                sweepSlice(SIZE_MAX);
+            }
+        }
+    }
+
+    void *ScriptHeap::allocateBlock(size_t size) {
+        size = roundSize(size);
+        if (size > kMaxSmallSize) {
+            Memory::MemoryTracker::onAllocate(Memory::MemoryTag::Script, size);
+            return ::operator new(size);
+        }
+
+        FreeBlock *&freeList = m_freeLists[size / kSizeClassStep - 1];
+        if (freeList) {
+            FreeBlock *block = freeList;
+            freeList = block->next;
+            return block;
+        }
+        if (m_cursor + size > m_chunkEnd) {
+            // The tail of the old chunk is dropped, at most one block's worth
+            m_cursor = static_cast<std::byte *>(::operator new(kChunkSize));
+            m_chunkEnd = m_cursor + kChunkSize;
+            m_chunks.push_back(m_cursor);
+            m_stats.arenaBytes += kChunkSize;
+            Memory::MemoryTracker::onAllocate(Memory::MemoryTag::Script, kChunkSize);
+        }
+        void *block = m_cursor;
+        m_cursor += size;
+        return block;
+    }
+
+    void ScriptHeap::freeBlock(void *block, size_t size) {
+        size = roundSize(size);
+        if (size > kMaxSmallSize) {
+            ::operator delete(block);
+            Memory::MemoryTracker::onFree(Memory::MemoryTag::Script, size);
+            return;
+        }
+        auto *free = static_cast<FreeBlock *>(block);
+        FreeBlock *&freeList = m_freeLists[size / kSizeClassStep - 1];
+        free->next = freeList;
+        freeList = free;
+    }
+
+    void *ScriptHeap::allocateObject(size_t size, ObjectType type) {
+        // Pay off the collection debt first, the new object is not reachable from anything yet
+        onAllocate(size);
+
+        size = roundSize(size);
+        auto *object = static_cast<Object *>(allocateBlock(size));
+        object->next = m_objects;
+        object->allocSize = static_cast<uint32_t>(size);
+        object->type = type;
+        // Objects born during marking are already black, ones born while sweeping are past the sweep
+        object->color = m_phase == Phase::Mark ? GcColor::Black : m_currentWhite;
+        m_objects = object;
+        m_stats.liveBytes += size;
+        return object;
+    }
+
+    void ScriptHeap::freeObject(Object *object) {
+        const uint32_t size = object->allocSize;
+        if (object->type == ObjectType::Array) {
+            const auto *array = static_cast<ArrayObject *>(object);
+            if (array->elements) {
+                freeBlock(array->elements, array->capacity * sizeof(Value));
+                m_stats.liveBytes -= roundSize(array->capacity * sizeof(Value));
+            }
+        } else if (object->type == ObjectType::Function) {
+            static_cast<FunctionObject *>(object)->~FunctionObject();
+        }
+        m_stats.liveBytes -= size;
+        m_stats.freedObjects++;
+        freeBlock(object, size);
+    }
+
+    void ScriptHeap::onAllocate(size_t size) {
+        m_allocatedSinceStep += size;
+        if (m_allocatedSinceStep >= kStepBytes) {
+            m_allocatedSinceStep = 0;
+            step();
+        }
+    }
+
+    void ScriptHeap::beginCycle() {
+        m_phase = Phase::Mark;
+        m_roots.markRoots(*this);
+    }
+
+    bool ScriptHeap::markSlice(size_t budget) {
+        while (!m_gray.empty()) {
+            Object *object = m_gray.back();
+            m_gray.pop_back();
+            // The barrier can queue an object twice, the second entry finds it black already
+            if (object->color != GcColor::Gray) {
+                continue;
+            }
+            traverse(object);
+
+            size_t work = object->allocSize;
+            if (object->type == ObjectType::Array) {
+                work += static_cast<ArrayObject *>(object)->count * sizeof(Value);
+            }
+            budget = work >= budget ? 0 : budget - work;
+            if (budget == 0) {
+                return m_gray.empty();
+            }
+        }
+        return true;
+    }
+
+    void ScriptHeap::finishMark() {
+        // Registers and globals change without barriers, so they get one last look in a single step
+        m_roots.markRoots(*this);
+        markSlice(SIZE_MAX);
+
+        // Everything still white is garbage, new objects get the other white from here on
+        m_currentWhite = otherWhite(m_currentWhite);
+        m_phase = Phase::Sweep;
+        m_sweepCursor = &m_objects;
+    }
+
+    bool ScriptHeap::sweepSlice(size_t budget) {
+        const GcColor dead = otherWhite(m_currentWhite);
+        while (*m_sweepCursor && budget > 0) {
+            Object *object = *m_sweepCursor;
+            if (object->color == dead) {
+                *m_sweepCursor = object->next;
+                freeObject(object);
+            } else {
+                object->color = m_currentWhite;
+                m_sweepCursor = &object->next;
+            }
+            budget--;
+        }
+        if (*m_sweepCursor) {
+            return false;
+        }
+
+        m_phase = Phase::Idle;
+        m_sweepCursor = nullptr;
+        m_threshold = std::max<uint64_t>(1024 * 1024, static_cast<uint64_t>(m_stats.liveBytes * m_growthFactor));
+        m_stats.cycles++;
+        return true;
+    }
+
+    void ScriptHeap::traverse(Object *object) {
+        switch (object->type) {
+            case ObjectType::String:
+                break;
+            case ObjectType::Array: {
+                const auto *array = static_cast<ArrayObject *>(object);
+                for (uint32_t i = 0; i < array->count; i++) {
+                    markValue(array->elements[i]);
+                }
+                break;
+            }
+            case ObjectType::Function:
+                for (const Value constant : static_cast<FunctionObject *>(object)->constants) {
+                    markValue(constant);
+                }
+                break;
+        }
+        object->color = GcColor::Black;
+    }
+}
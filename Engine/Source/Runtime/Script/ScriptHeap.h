@@ -0,0 +1,149 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTHEAP_H
+#define SCRIPTHEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "ScriptObject.h"
+
+namespace Trin::Runtime::Script {
+    class ScriptHeap;
+
+    /// Whoever owns references the heap cannot see, the VM with its registers and globals
+    class ScriptRoots {
+    public:
+        virtual ~ScriptRoots() = default;
+        virtual void markRoots(ScriptHeap &heap) = 0;
+    };
+
+    struct ScriptHeapStats {
+        uint64_t liveBytes = 0;
+        uint64_t arenaBytes = 0;        // Chunk memory reserved, live or free
+        uint64_t cycles = 0;            // Completed collections
+        uint64_t steps = 0;             // Incremental slices run
+        uint64_t freedObjects = 0;
+    };
+
+/**
+ * Garbage collected heap for script objects.
+ *
+ * Small blocks are carved out of 64KB arena chunks by size class and recycled through
+ * per-class free lists, so objects of one script end up packed together and the whole
+ * heap is released at once when the VM goes away. Only arrays past 512 bytes of elements
+ * go to the general allocator.
+ *
+ * Collection is an incremental tri-color mark and sweep. Allocation pays for the work in
+ * small slices, so no single frame takes the whole pause. Stores into arrays go through
+ * writeBarrier() to keep marking correct while the script keeps running. Registers and
+ * globals are not barriered, the roots are scanned again in one go before sweeping starts.
+ */
+class ScriptHeap {
+public:
+    static constexpr size_t kChunkSize = 64 * 1024;
+    static constexpr size_t kSizeClassStep = 16;
+    static constexpr size_t kMaxSmallSize = 512;
+
+    /// Bytes allocated between two incremental slices
+    static constexpr size_t kStepBytes = 16 * 1024;
+
+    explicit ScriptHeap(ScriptRoots &roots);
+    ~ScriptHeap();
+
+    ScriptHeap(const ScriptHeap &) = delete;
+    ScriptHeap &operator=(const ScriptHeap &) = delete;
+
+    StringObject *newString(std::string_view text);
+    ArrayObject *newArray(uint32_t capacity);
+    FunctionObject *newFunction();
+
+    /// Appends to an array, growing its storage through the heap
+    void push(ArrayObject *array, Value value);
+
+    /// Call before storing value into parent, keeps a black parent from hiding a white child
+    void writeBarrier(Object *parent, Value value) {
+        if (m_phase == Phase::Mark && parent->color == GcColor::Black && value.isObject() &&
+            value.asObject()->color == m_currentWhite) {
+            parent->color = GcColor::Gray;
+            m_gray.push_back(parent);
+        }
+    }
+
+    /// Roots report what they hold through these while marking
+    void markValue(Value value) {
+        if (value.isObject()) {
+            markObject(value.asObject());
+        }
+    }
+    void markObject(Object *object);
+
+    /// Runs one incremental slice, starting a new cycle when the heap has grown enough
+    void step();
+
+    /// Finishes the current cycle, or runs a whole new one, before returning
+    void collect();
+
+    /// Heap size that starts the next cycle, as a multiple of what survived the last one
+    void setGrowthFactor(float factor) { m_growthFactor = factor; }
+
+    [[nodiscard]] const ScriptHeapStats &getStats() const { return m_stats; }
+    [[nodiscard]] bool isCollecting() const { return m_phase != Phase::Idle; }
+
+private:
+    enum class Phase {
+        Idle,
+        Mark,
+        Sweep
+    };
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    void *allocateBlock(size_t size);
+    void freeBlock(void *block, size_t size);
+    void *allocateObject(size_t size, ObjectType type);
+    void freeObject(Object *object);
+
+    void onAllocate(size_t size);
+    void beginCycle();
+    bool markSlice(size_t budget);
+    void finishMark();
+    bool sweepSlice(size_t budget);
+    void traverse(Object *object);
+
+    ScriptRoots &m_roots;
+
+    // ==============
+    //     ARENA
+    // ==============
+
+    std::vector<void *> m_chunks;
+    std::byte *m_cursor = nullptr;
+    std::byte *m_chunkEnd = nullptr;
+    FreeBlock *m_freeLists[kMaxSmallSize / kSizeClassStep] = {};
+
+    // ==============
+    //       GC
+    // ==============
+
+    Phase m_phase = Phase::Idle;
+    GcColor m_currentWhite = GcColor::White0;
+    Object *m_objects = nullptr;
+    Object **m_sweepCursor = nullptr;
+    std::vector<Object *> m_gray;
+    size_t m_allocatedSinceStep = 0;
+    uint64_t m_threshold = 1024 * 1024;
+    float m_growthFactor = 2.0f;
+
+    ScriptHeapStats m_stats;
+};
+
+}
+
+#endif //SCRIPTHEAP_H
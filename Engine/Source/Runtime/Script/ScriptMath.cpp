@@ -0,0 +1,51 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "ScriptMath.h"
+
+#include <cmath>
+
+#include "ScriptVM.h"
+
+namespace Trin::Runtime::Script {
+    using Math::Vector2;
+    using Math::Vector3;
+    using Math::Vector4;
+
+    void bindMath(ScriptVM &vm) {
+        // Vector operators write into their left operand, the lambdas get copies to spend
+
+        vm.bind("vec2.add", [](Vector2 a, Vector2 b) { return a + b; });
+        vm.bind("vec2.sub", [](Vector2 a, Vector2 b) { return a - b; });
+        vm.bind("vec2.mul", [](Vector2 a, Vector2 b) { return a * b; });
+        vm.bind("vec2.scale", [](Vector2 a, float s) { return a * Vector2(s); });
+        vm.bind("vec2.dot", [](Vector2 a, Vector2 b) { return a.dot(b); });
+        vm.bind("vec2.length", [](Vector2 a) { return a.magnitude(); });
+        vm.bind("vec2.normalize", [](Vector2 a) { return a.normalize(); });
+
+        vm.bind("vec3.add", [](Vector3 a, Vector3 b) { return a + b; });
+        vm.bind("vec3.sub", [](Vector3 a, Vector3 b) { return a - b; });
+        vm.bind("vec3.mul", [](Vector3 a, Vector3 b) { return a * b; });
+        vm.bind("vec3.scale", [](Vector3 a, float s) { return a * Vector3(s); });
+        vm.bind("vec3.dot", [](Vector3 a, Vector3 b) { return a.dot(b); });
+        vm.bind("vec3.cross", [](Vector3 a, Vector3 b) { return a.cross(b); });
+        vm.bind("vec3.length", [](Vector3 a) { return a.magnitude(); });
+        vm.bind("vec3.normalize", [](Vector3 a) { return a.normalize(); });
+
+        vm.bind("vec4.add", [](Vector4 a, Vector4 b) { return a + b; });
+        vm.bind("vec4.sub", [](Vector4 a, Vector4 b) { return a - b; });
+        vm.bind("vec4.mul", [](Vector4 a, Vector4 b) { return a * b; });
+        vm.bind("vec4.scale", [](Vector4 a, float s) { return a * Vector4(s); });
+        vm.bind("vec4.dot", [](Vector4 a, Vector4 b) { return a.dot(b); });
+        vm.bind("vec4.length", [](Vector4 a) { return a.magnitude(); });
+        vm.bind("vec4.normalize", [](Vector4 a) { return a.normalize(); });
+
+        vm.bind("math.sqrt", [](double x) { return std::sqrt(x); });
+        vm.bind("math.sin", [](double x) { return std::sin(x); });
+        vm.bind("math.cos", [](double x) { return std::cos(x); });
+        vm.bind("math.floor", [](double x) { return std::floor(x); });
+        vm.bind("math.min", [](double a, double b) { return std::fmin(a, b); });
+        vm.bind("math.max", [](double a, double b) { return std::fmax(a, b); });
+    }
+}
@@ -0,0 +1,18 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTMATH_H
+#define SCRIPTMATH_H
+
+namespace Trin::Runtime::Script {
+    class ScriptVM;
+
+    /**
+     * @brief Binds Trin::Math to scripts as natives named "vec3.add", "vec2.dot", "math.sqrt" ...
+     * @param vm VM to bind into
+     */
+    void bindMath(ScriptVM &vm);
+}
+
+#endif //SCRIPTMATH_H
@@ -0,0 +1,210 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTNATIVE_H
+#define SCRIPTNATIVE_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+#include "Math/Vector4.h"
+#include "ScriptValue.h"
+
+namespace Trin::Runtime::Script {
+    /// Native entry point, reads its arguments from regs[0..] and writes the result over them
+    using NativeFn = bool (*)(Value *regs);
+
+    // ==============
+    //     CODECS
+    // ==============
+
+    /**
+     * How a C++ type maps onto consecutive registers. Vectors are spread over one register
+     * per component, so a Vector3 argument is three plain numbers and never a heap object.
+     * read() fails on a register of the wrong type, which the VM reports as a bad argument.
+     */
+    template<typename T>
+    struct NativeCodec;
+
+    template<>
+    struct NativeCodec<double> {
+        static constexpr uint32_t kSlots = 1;
+        static bool read(const Value *regs, double &out) {
+            out = regs[0].asNumber();
+            return regs[0].isNumber();
+        }
+        static void write(Value *regs, double value) { regs[0] = Value::number(value); }
+    };
+
+    template<>
+    struct NativeCodec<float> {
+        static constexpr uint32_t kSlots = 1;
+        static bool read(const Value *regs, float &out) {
+            out = static_cast<float>(regs[0].asNumber());
+            return regs[0].isNumber();
+        }
+        static void write(Value *regs, float value) { regs[0] = Value::number(value); }
+    };
+
+    template<>
+    struct NativeCodec<int32_t> {
+        static constexpr uint32_t kSlots = 1;
+        static bool read(const Value *regs, int32_t &out) {
+            if (!regs[0].isNumber()) {
+                return false;
+            }
+            const double number = regs[0].asNumber();
+            out = static_cast<int32_t>(number);
+            return number == std::trunc(number) && std::abs(number) <= INT32_MAX;
+        }
+        static void write(Value *regs, int32_t value) { regs[0] = Value::number(value); }
+    };
+
+    template<>
+    struct NativeCodec<bool> {
+        static constexpr uint32_t kSlots = 1;
+        static bool read(const Value *regs, bool &out) {
+            out = regs[0].asBool();
+            return regs[0].isBool();
+        }
+        static void write(Value *regs, bool value) { regs[0] = Value::boolean(value); }
+    };
+
+    /// Passed through untouched, for natives that look at the type themselves
+    template<>
+    struct NativeCodec<Value> {
+        static constexpr uint32_t kSlots = 1;
+        static bool read(const Value *regs, Value &out) {
+            out = regs[0];
+            return true;
+        }
+        static void write(Value *regs, Value value) { regs[0] = value; }
+    };
+
+    template<>
+    struct NativeCodec<Math::Vector2> {
+        static constexpr uint32_t kSlots = 2;
+        static bool read(const Value *regs, Math::Vector2 &out) {
+            out.x = static_cast<float>(regs[0].asNumber());
+            out.y = static_cast<float>(regs[1].asNumber());
+            return regs[0].isNumber() && regs[1].isNumber();
+        }
+        static void write(Value *regs, const Math::Vector2 &value) {
+            regs[0] = Value::number(value.x);
+            regs[1] = Value::number(value.y);
+        }
+    };
+
+    template<>
+    struct NativeCodec<Math::Vector3> {
+        static constexpr uint32_t kSlots = 3;
+        static bool read(const Value *regs, Math::Vector3 &out) {
+            out.x = static_cast<float>(regs[0].asNumber());
+            out.y = static_cast<float>(regs[1].asNumber());
+            out.z = static_cast<float>(regs[2].asNumber());
+            return regs[0].isNumber() && regs[1].isNumber() && regs[2].isNumber();
+        }
+        static void write(Value *regs, const Math::Vector3 &value) {
+            regs[0] = Value::number(value.x);
+            regs[1] = Value::number(value.y);
+            regs[2] = Value::number(value.z);
+        }
+    };
+
+    template<>
+    struct NativeCodec<Math::Vector4> {
+        static constexpr uint32_t kSlots = 4;
+        static bool read(const Value *regs, Math::Vector4 &out) {
+            out.x = static_cast<float>(regs[0].asNumber());
+            out.y = static_cast<float>(regs[1].asNumber());
+            out.z = static_cast<float>(regs[2].asNumber());
+            out.w = static_cast<float>(regs[3].asNumber());
+            return regs[0].isNumber() && regs[1].isNumber() && regs[2].isNumber() && regs[3].isNumber();
+        }
+        static void write(Value *regs, const Math::Vector4 &value) {
+            regs[0] = Value::number(value.x);
+            regs[1] = Value::number(value.y);
+            regs[2] = Value::number(value.z);
+            regs[3] = Value::number(value.w);
+        }
+    };
+
+    // ==============
+    //    BINDER
+    // ==============
+
+    namespace Detail {
+        template<typename Fn>
+        struct NativeSignature : NativeSignature<decltype(&Fn::operator())> {};
+
+        template<typename C, typename R, typename... Args>
+        struct NativeSignature<R (C::*)(Args...) const> {
+            using Result = R;
+            using Arguments = std::tuple<std::decay_t<Args>...>;
+        };
+
+        template<typename R>
+        constexpr uint32_t resultSlots() {
+            if constexpr (std::is_void_v<R>) {
+                return 0;
+            } else {
+                return NativeCodec<R>::kSlots;
+            }
+        }
+
+        template<typename Fn, typename R, typename Arguments>
+        struct NativeBinder;
+
+        template<typename Fn, typename R, typename... Args>
+        struct NativeBinder<Fn, R, std::tuple<Args...>> {
+            static constexpr uint32_t kArgSlots = (0u + ... + NativeCodec<Args>::kSlots);
+            static constexpr uint32_t kResultSlots = resultSlots<R>();
+
+            /// Register offset of every argument, worked out once at compile time
+            static constexpr std::array<uint32_t, sizeof...(Args) + 1> kOffsets = [] {
+                constexpr uint32_t slots[] = {NativeCodec<Args>::kSlots..., 0u};
+                std::array<uint32_t, sizeof...(Args) + 1> offsets{};
+                for (size_t i = 0; i < sizeof...(Args); i++) {
+                    offsets[i + 1] = offsets[i] + slots[i];
+                }
+                return offsets;
+            }();
+
+            static bool call(Value *regs) { return invoke(regs, std::index_sequence_for<Args...>{}); }
+
+            template<size_t... I>
+            static bool invoke(Value *regs, std::index_sequence<I...>) {
+                // Every argument is read before the result can overwrite its registers
+                std::tuple<Args...> args;
+                if (!(NativeCodec<Args>::read(regs + kOffsets[I], std::get<I>(args)) && ...)) {
+                    return false;
+                }
+                if constexpr (std::is_void_v<R>) {
+                    std::apply(Fn{}, args);
+                } else {
+                    NativeCodec<R>::write(regs, std::apply(Fn{}, args));
+                }
+                return true;
+            }
+        };
+    }
+
+    /**
+     * Turns a captureless lambda into a NativeFn. The signature is read off the lambda, so
+     * binding [](Math::Vector3 a, Math::Vector3 b) { return a.dot(b); } produces a
+     * trampoline that pulls six numbers out of the registers and writes one back, with no
+     * allocation or type dispatch beyond one number check per register.
+     */
+    template<typename Fn>
+    using NativeBinder = Detail::NativeBinder<Fn, typename Detail::NativeSignature<Fn>::Result,
+                                              typename Detail::NativeSignature<Fn>::Arguments>;
+}
+
+#endif //SCRIPTNATIVE_H
@@ -0,0 +1,71 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTOBJECT_H
+#define SCRIPTOBJECT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ScriptValue.h"
+
+namespace Trin::Runtime::Script {
+    enum class ObjectType : uint8_t {
+        String,
+        Array,
+        Function
+    };
+
+    /// Tri-color marking state, the two whites swap meaning every collection cycle
+    enum class GcColor : uint8_t {
+        White0,
+        White1,
+        Gray,
+        Black
+    };
+
+    /// Header in front of every heap object, objects are linked for the sweep
+    struct Object {
+        Object *next;
+        uint32_t allocSize;     // Bytes taken from the heap, handed back when the object is freed
+        ObjectType type;
+        GcColor color;
+    };
+
+    /// Immutable string with its characters stored right after the header
+    struct StringObject : Object {
+        uint32_t length;
+        uint32_t hash;
+
+        [[nodiscard]] const char *chars() const { return reinterpret_cast<const char *>(this + 1); }
+        [[nodiscard]] std::string_view view() const { return {chars(), length}; }
+    };
+
+    struct ArrayObject : Object {
+        Value *elements;
+        uint32_t count;
+        uint32_t capacity;
+    };
+
+    /// Compiled script function, produced by FunctionBuilder
+    struct FunctionObject : Object {
+        std::string name;
+        std::vector<uint32_t> code;
+        std::vector<Value> constants;
+        uint8_t paramCount;
+        uint8_t registerCount;
+    };
+
+    inline StringObject *asString(Value value) { return static_cast<StringObject *>(value.asObject()); }
+    inline ArrayObject *asArray(Value value) { return static_cast<ArrayObject *>(value.asObject()); }
+    inline FunctionObject *asFunction(Value value) { return static_cast<FunctionObject *>(value.asObject()); }
+
+    inline bool isType(Value value, ObjectType type) {
+        return value.isObject() && value.asObject()->type == type;
+    }
+}
+
+#endif //SCRIPTOBJECT_H
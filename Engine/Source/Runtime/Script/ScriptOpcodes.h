@@ -0,0 +1,83 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTOPCODES_H
+#define SCRIPTOPCODES_H
+
+#include <cstdint>
+
+namespace Trin::Runtime::Script {
+/**
+ * Every instruction is 32 bits, the opcode in the low byte and then either three 8 bit
+ * operands A B C, or A and a 16 bit Bx that jumps read as signed. A, B and C name registers
+ * of the current frame unless the opcode says otherwise.
+ *
+ * A callee's registers start at R[A+1] of the caller, so a Call leaves every caller register
+ * above A undefined. FunctionBuilder rejects code that reads one of them before writing it.
+ *
+ * X(name, description) so the enum, the dispatch table and the disassembler stay in step.
+ */
+#define TRIN_SCRIPT_OPCODES(X) \
+    X(Move,      "R[A] = R[B]") \
+    X(LoadK,     "R[A] = K[Bx]") \
+    X(LoadI,     "R[A] = sBx") \
+    X(LoadNil,   "R[A] = nil") \
+    X(LoadBool,  "R[A] = B != 0") \
+    X(GetGlobal, "R[A] = G[Bx]") \
+    X(SetGlobal, "G[Bx] = R[A]") \
+    X(Add,       "R[A] = R[B] + R[C]") \
+    X(Sub,       "R[A] = R[B] - R[C]") \
+    X(Mul,       "R[A] = R[B] * R[C]") \
+    X(Div,       "R[A] = R[B] / R[C]") \
+    X(Mod,       "R[A] = R[B] mod R[C], floored") \
+    X(AddI,      "R[A] = R[B] + sC") \
+    X(Neg,       "R[A] = -R[B]") \
+    X(Not,       "R[A] = not R[B]") \
+    X(Eq,        "R[A] = R[B] == R[C]") \
+    X(Lt,        "R[A] = R[B] < R[C]") \
+    X(Le,        "R[A] = R[B] <= R[C]") \
+    X(Jmp,       "pc += sBx") \
+    X(JmpIf,     "if R[A] then pc += sBx") \
+    X(JmpIfNot,  "if not R[A] then pc += sBx") \
+    X(ForPrep,   "R[A] -= R[A+2], pc += sBx") \
+    X(ForLoop,   "R[A] += R[A+2], if R[A] has not passed R[A+1] then pc += sBx") \
+    X(Call,      "R[A] = R[A](R[A+1] .. R[A+B]), clobbers every register above A") \
+    X(Native,    "R[A..] = natives[Bx](R[A..]), unboxed arguments and results") \
+    X(Return,    "return B ? R[A] : nil") \
+    X(NewArray,  "R[A] = array with capacity B") \
+    X(GetIndex,  "R[A] = R[B][R[C]]") \
+    X(SetIndex,  "R[A][R[B]] = R[C]") \
+    X(Push,      "append R[B] to R[A]") \
+    X(Len,       "R[A] = length of R[B]")
+
+    enum class Op : uint8_t {
+#define TRIN_SCRIPT_OPCODE_ENUM(name, description) name,
+        TRIN_SCRIPT_OPCODES(TRIN_SCRIPT_OPCODE_ENUM)
+#undef TRIN_SCRIPT_OPCODE_ENUM
+        Count
+    };
+
+    namespace Bytecode {
+        constexpr uint32_t encode(Op op, uint8_t a, uint8_t b, uint8_t c) {
+            return static_cast<uint32_t>(op) | static_cast<uint32_t>(a) << 8 |
+                   static_cast<uint32_t>(b) << 16 | static_cast<uint32_t>(c) << 24;
+        }
+
+        constexpr uint32_t encodeBx(Op op, uint8_t a, uint16_t bx) {
+            return static_cast<uint32_t>(op) | static_cast<uint32_t>(a) << 8 | static_cast<uint32_t>(bx) << 16;
+        }
+
+        constexpr Op op(uint32_t instruction) { return static_cast<Op>(instruction & 0xff); }
+        constexpr uint32_t a(uint32_t instruction) { return (instruction >> 8) & 0xff; }
+        constexpr uint32_t b(uint32_t instruction) { return (instruction >> 16) & 0xff; }
+        constexpr uint32_t c(uint32_t instruction) { return instruction >> 24; }
+        constexpr uint32_t bx(uint32_t instruction) { return instruction >> 16; }
+        constexpr int32_t sbx(uint32_t instruction) { return static_cast<int16_t>(instruction >> 16); }
+        constexpr int32_t sc(uint32_t instruction) { return static_cast<int8_t>(instruction >> 24); }
+
+        const char *name(Op op);
+    }
+}
+
+#endif //SCRIPTOPCODES_H
@@ -0,0 +1,465 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "ScriptVM.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Helpers/Console.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TRIN_SCRIPT_COMPUTED_GOTO 1
+#endif
+
+namespace Trin::Runtime::Script {
+    namespace {
+        const char *typeName(Value value) {
+            if (value.isNumber()) {
+                return "number";
+            }
+            if (value.isNil()) {
+                return "nil";
+            }
+            if (value.isBool()) {
+                return "boolean";
+            }
+            switch (value.asObject()->type) {
+                case ObjectType::String: return "string";
+                case ObjectType::Array: return "array";
+                case ObjectType::Function: return "function";
+            }
+            return "object";
+        }
+
+        bool valuesEqual(Value a, Value b) {
+            if (a.isNumber() && b.isNumber()) {
+                return a.asNumber() == b.asNumber();
+            }
+            if (isType(a, ObjectType::String) && isType(b, ObjectType::String)) {
+                const StringObject *x = asString(a);
+                const StringObject *y = asString(b);
+                return x->length == y->length && x->hash == y->hash && std::memcmp(x->chars(), y->chars(), x->length) == 0;
+            }
+            return a.bits() == b.bits();
+        }
+
+        std::string operandError(const char *operation, Value a, Value b) {
+            return std::string("attempt to ") + operation + " " + typeName(a) + " and " + typeName(b);
+        }
+
+        /// Arrays are indexed from 0 by whole numbers
+        bool arrayIndex(Value key, const ArrayObject *array, uint32_t &index) {
+            if (!key.isNumber()) {
+                return false;
+            }
+            const double number = key.asNumber();
+            index = static_cast<uint32_t>(number);
+            return number >= 0.0 && number < array->count && number == static_cast<double>(index);
+        }
+    }
+
+    ScriptVM::ScriptVM() : m_heap(*this), m_stack(kStackSlots) {
+        // Frames are referenced while running, growing the vector must not move them
+        m_frames.reserve(kMaxFrames);
+    }
+
+    uint16_t ScriptVM::defineGlobal(std::string_view name) {
+        const int32_t existing = findGlobal(name);
+        if (existing >= 0) {
+            return static_cast<uint16_t>(existing);
+        }
+        if (m_globals.size() > UINT16_MAX) {
+            Helpers::Console::error("ScriptVM: too many globals, can't define " + std::string(name));
+            return 0;
+        }
+        m_globals.push_back(Value::nil());
+        m_globalNames.emplace_back(name);
+        return static_cast<uint16_t>(m_globals.size() - 1);
+    }
+
+    int32_t ScriptVM::findGlobal(std::string_view name) const {
+        const auto it = std::find(m_globalNames.begin(), m_globalNames.end(), name);
+        return it == m_globalNames.end() ? -1 : static_cast<int32_t>(it - m_globalNames.begin());
+    }
+
+    int32_t ScriptVM::findNative(std::string_view name) const {
+        const auto it = std::find_if(m_natives.begin(), m_natives.end(), [name](const NativeBinding &native) {
+            return native.name == name;
+        });
+        return it == m_natives.end() ? -1 : static_cast<int32_t>(it - m_natives.begin());
+    }
+
+    uint16_t ScriptVM::addNative(std::string_view name, NativeFn fn, uint32_t argSlots, uint32_t resultSlots) {
+        if (m_natives.size() > UINT16_MAX) {
+            Helpers::Console::error("ScriptVM: too many natives, can't bind " + std::string(name));
+            return 0;
+        }
+        m_natives.push_back({std::string(name), fn, static_cast<uint8_t>(argSlots), static_cast<uint8_t>(resultSlots)});
+        return static_cast<uint16_t>(m_natives.size() - 1);
+    }
+
+    bool ScriptVM::call(Value function, std::span<const Value> args, Value *result) {
+        m_error.clear();
+        if (!m_frames.empty()) {
+            m_error = "call: the VM is already running";
+            return false;
+        }
+        if (!isType(function, ObjectType::Function)) {
+            m_error = std::string("call: attempt to call ") + typeName(function);
+            return false;
+        }
+        const FunctionObject *callee = asFunction(function);
+        if (args.size() != callee->paramCount) {
+            m_error = callee->name + ": expected " + std::to_string(callee->paramCount) + " arguments, got " +
+                      std::to_string(args.size());
+            return false;
+        }
+
+        // Same layout as a script call, the function sits right below the callee's registers
+        m_stack[0] = function;
+        std::copy(args.begin(), args.end(), m_stack.begin() + 1);
+        if (!enterFrame(callee, m_stack.data() + 1, static_cast<uint32_t>(args.size())) || !execute(0)) {
+            return false;
+        }
+        if (result) {
+            *result = m_stack[0];
+        }
+        return true;
+    }
+
+    void ScriptVM::markRoots(ScriptHeap &heap) {
+        for (const Value global : m_globals) {
+            heap.markValue(global);
+        }
+        for (FunctionObject *function : m_functions) {
+            heap.markObject(function);
+        }
+        if (m_frames.empty()) {
+            return;
+        }
+        // A callee's window can be smaller than what its caller uses above the call, so the
+        // live part of the stack ends at the highest window of any frame, not the innermost one
+        const Value *end = m_stack.data();
+        for (const Frame &frame : m_frames) {
+            end = std::max(end, static_cast<const Value *>(frame.base + frame.function->registerCount));
+        }
+        for (const Value *slot = m_stack.data(); slot < end; slot++) {
+            heap.markValue(*slot);
+        }
+    }
+
+    bool ScriptVM::enterFrame(const FunctionObject *function, Value *base, uint32_t argCount) {
+        if (argCount != function->paramCount) {
+            m_error = function->name + ": expected " + std::to_string(function->paramCount) + " arguments, got " +
+                      std::to_string(argCount);
+            return false;
+        }
+        if (m_frames.size() == kMaxFrames || base + function->registerCount > m_stack.data() + m_stack.size()) {
+            m_error = "stack overflow calling " + function->name;
+            return false;
+        }
+        // Whatever the caller left above the arguments must not leak into the new frame. Those
+        // registers are dead to the caller, FunctionBuilder rejects code that reads them after a Call
+        std::fill(base + argCount, base + function->registerCount, Value::nil());
+        m_frames.push_back({function, nullptr, base});
+        return true;
+    }
+
+    bool ScriptVM::fail(const uint32_t *pc, const std::string &message, size_t baseDepth) {
+        const FunctionObject *function = m_frames.back().function;
+        const auto offset = pc - function->code.data() - 1;
+        m_error = function->name + ":" + std::to_string(offset) + ": " + message;
+        m_frames.resize(baseDepth);
+        return false;
+    }
+
+    // ==============
+    //  INTERPRETER
+    // ==============
+
+#define VM_RA regs[Bytecode::a(instruction)]
+#define VM_RB regs[Bytecode::b(instruction)]
+#define VM_RC regs[Bytecode::c(instruction)]
+
+#define VM_FAIL(message)                              \
+    do {                                              \
+        m_executed += executed;                       \
+        return fail(pc, message, baseDepth);          \
+    } while (false)
+
+#ifdef TRIN_SCRIPT_COMPUTED_GOTO
+#define VM_CASE(name) op_##name:
+#define VM_NEXT()                                     \
+    do {                                              \
+        instruction = *pc++;                          \
+        executed++;                                   \
+        goto *kLabels[instruction & 0xff];            \
+    } while (false)
+#else
+#define VM_CASE(name) case Op::name:
+#define VM_NEXT() goto dispatch
+#endif
+
+#define VM_ARITHMETIC(name, verb, expression)                  \
+    VM_CASE(name) {                                            \
+        const Value lhs = VM_RB;                               \
+        const Value rhs = VM_RC;                               \
+        if (!lhs.isNumber() || !rhs.isNumber()) {              \
+            VM_FAIL(operandError(verb, lhs, rhs));             \
+        }                                                      \
+        const double x = lhs.asNumber();                       \
+        const double y = rhs.asNumber();                       \
+        VM_RA = Value::number(expression);                     \
+        VM_NEXT();                                             \
+    }
+
+#define VM_COMPARE(name, expression)                           \
+    VM_CASE(name) {                                            \
+        const Value lhs = VM_RB;                               \
+        const Value rhs = VM_RC;                               \
+        if (!lhs.isNumber() || !rhs.isNumber()) {              \
+            VM_FAIL(operandError("compare", lhs, rhs));        \
+        }                                                      \
+        const double x = lhs.asNumber();                       \
+        const double y = rhs.asNumber();                       \
+        VM_RA = Value::boolean(expression);                    \
+        VM_NEXT();                                             \
+    }
+
+    bool ScriptVM::execute(size_t baseDepth) {
+#ifdef TRIN_SCRIPT_COMPUTED_GOTO
+        static const void *const kLabels[] = {
+#define TRIN_SCRIPT_OPCODE_LABEL(name, description) &&op_##name,
+            TRIN_SCRIPT_OPCODES(TRIN_SCRIPT_OPCODE_LABEL)
+#undef TRIN_SCRIPT_OPCODE_LABEL
+        };
+#endif
+
+        // Hot state lives in locals, it is only written back to the frame around calls
+        const FunctionObject *function = m_frames.back().function;
+        const uint32_t *pc = function->code.data();
+        const Value *constants = function->constants.data();
+        Value *regs = m_frames.back().base;
+        Value *globals = m_globals.data();
+        const NativeBinding *natives = m_natives.data();
+        uint32_t instruction;
+        uint64_t executed = 0;
+
+#ifdef TRIN_SCRIPT_COMPUTED_GOTO
+        VM_NEXT();
+#else
+    dispatch:
+        instruction = *pc++;
+        executed++;
+        switch (Bytecode::op(instruction)) {
+#endif
+
+        VM_CASE(Move) {
+            VM_RA = VM_RB;
+            VM_NEXT();
+        }
+        VM_CASE(LoadK) {
+            VM_RA = constants[Bytecode::bx(instruction)];
+            VM_NEXT();
+        }
+        VM_CASE(LoadI) {
+            VM_RA = Value::number(Bytecode::sbx(instruction));
+            VM_NEXT();
+        }
+        VM_CASE(LoadNil) {
+            VM_RA = Value::nil();
+            VM_NEXT();
+        }
+        VM_CASE(LoadBool) {
+            VM_RA = Value::boolean(Bytecode::b(instruction) != 0);
+            VM_NEXT();
+        }
+        VM_CASE(GetGlobal) {
+            VM_RA = globals[Bytecode::bx(instruction)];
+            VM_NEXT();
+        }
+        VM_CASE(SetGlobal) {
+            globals[Bytecode::bx(instruction)] = VM_RA;
+            VM_NEXT();
+        }
+
+        VM_ARITHMETIC(Add, "add", x + y)
+        VM_ARITHMETIC(Sub, "subtract", x - y)
+        VM_ARITHMETIC(Mul, "multiply", x * y)
+        VM_ARITHMETIC(Div, "divide", x / y)
+        VM_ARITHMETIC(Mod, "take the modulo of", x - std::floor(x / y) * y)
+
+        VM_CASE(AddI) {
+            const Value lhs = VM_RB;
+            if (!lhs.isNumber()) {
+                VM_FAIL(operandError("add", lhs, Value::number(0)));
+            }
+            VM_RA = Value::number(lhs.asNumber() + Bytecode::sc(instruction));
+            VM_NEXT();
+        }
+        VM_CASE(Neg) {
+            const Value operand = VM_RB;
+            if (!operand.isNumber()) {
+                VM_FAIL(std::string("attempt to negate ") + typeName(operand));
+            }
+            VM_RA = Value::number(-operand.asNumber());
+            VM_NEXT();
+        }
+        VM_CASE(Not) {
+            VM_RA = Value::boolean(!VM_RB.isTruthy());
+            VM_NEXT();
+        }
+        VM_CASE(Eq) {
+            VM_RA = Value::boolean(valuesEqual(VM_RB, VM_RC));
+            VM_NEXT();
+        }
+
+        VM_COMPARE(Lt, x < y)
+        VM_COMPARE(Le, x <= y)
+
+        VM_CASE(Jmp) {
+            pc += Bytecode::sbx(instruction);
+            VM_NEXT();
+        }
+        VM_CASE(JmpIf) {
+            if (VM_RA.isTruthy()) {
+                pc += Bytecode::sbx(instruction);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(JmpIfNot) {
+            if (!VM_RA.isTruthy()) {
+                pc += Bytecode::sbx(instruction);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(ForPrep) {
+            // R[A] index, R[A+1] limit, R[A+2] step, the first ForLoop adds the step back
+            Value *loop = &VM_RA;
+            if (!loop[0].isNumber() || !loop[1].isNumber() || !loop[2].isNumber()) {
+                VM_FAIL("for loop index, limit and step must be numbers");
+            }
+            loop[0] = Value::number(loop[0].asNumber() - loop[2].asNumber());
+            pc += Bytecode::sbx(instruction);
+            VM_NEXT();
+        }
+        VM_CASE(ForLoop) {
+            Value *loop = &VM_RA;
+            const double step = loop[2].asNumber();
+            const double index = loop[0].asNumber() + step;
+            if (step > 0.0 ? index <= loop[1].asNumber() : index >= loop[1].asNumber()) {
+                loop[0] = Value::number(index);
+                pc += Bytecode::sbx(instruction);
+            }
+            VM_NEXT();
+        }
+
+        VM_CASE(Call) {
+            const Value callee = VM_RA;
+            if (!isType(callee, ObjectType::Function)) {
+                VM_FAIL(std::string("attempt to call ") + typeName(callee));
+            }
+            m_frames.back().pc = pc;
+            if (!enterFrame(asFunction(callee), &VM_RA + 1, Bytecode::b(instruction))) {
+                VM_FAIL(std::string(m_error));
+            }
+            function = asFunction(callee);
+            pc = function->code.data();
+            constants = function->constants.data();
+            regs = m_frames.back().base;
+            VM_NEXT();
+        }
+        VM_CASE(Native) {
+            const NativeBinding &native = natives[Bytecode::bx(instruction)];
+            if (!native.fn(&VM_RA)) {
+                VM_FAIL("bad argument to native " + native.name);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(Return) {
+            // The caller's R[A] sits right below the callee's registers
+            regs[-1] = Bytecode::b(instruction) ? VM_RA : Value::nil();
+            m_frames.pop_back();
+            if (m_frames.size() == baseDepth) {
+                m_executed += executed;
+                return true;
+            }
+            const Frame &caller = m_frames.back();
+            function = caller.function;
+            pc = caller.pc;
+            constants = function->constants.data();
+            regs = caller.base;
+            VM_NEXT();
+        }
+
+        VM_CASE(NewArray) {
+            VM_RA = Value::object(m_heap.newArray(Bytecode::b(instruction)));
+            VM_NEXT();
+        }
+        VM_CASE(GetIndex) {
+            const Value container = VM_RB;
+            if (!isType(container, ObjectType::Array)) {
+                VM_FAIL(std::string("attempt to index ") + typeName(container));
+            }
+            const ArrayObject *array = asArray(container);
+            uint32_t index;
+            if (!arrayIndex(VM_RC, array, index)) {
+                VM_FAIL("array index out of range");
+            }
+            VM_RA = array->elements[index];
+            VM_NEXT();
+        }
+        VM_CASE(SetIndex) {
+            const Value container = VM_RA;
+            if (!isType(container, ObjectType::Array)) {
+                VM_FAIL(std::string("attempt to index ") + typeName(container));
+            }
+            ArrayObject *array = asArray(container);
+            uint32_t index;
+            if (!arrayIndex(VM_RB, array, index)) {
+                VM_FAIL("array index out of range");
+            }
+            m_heap.writeBarrier(array, VM_RC);
+            array->elements[index] = VM_RC;
+            VM_NEXT();
+        }
+        VM_CASE(Push) {
+            const Value container = VM_RA;
+            if (!isType(container, ObjectType::Array)) {
+                VM_FAIL(std::string("attempt to push to ") + typeName(container));
+            }
+            m_heap.push(asArray(container), VM_RB);
+            VM_NEXT();
+        }
+        VM_CASE(Len) {
+            const Value operand = VM_RB;
+            if (isType(operand, ObjectType::Array)) {
+                VM_RA = Value::number(asArray(operand)->count);
+            } else if (isType(operand, ObjectType::String)) {
+                VM_RA = Value::number(asString(operand)->length);
+            } else {
+                VM_FAIL(std::string("attempt to get the length of ") + typeName(operand));
+            }
+            VM_NEXT();
+        }
+
+#ifndef TRIN_SCRIPT_COMPUTED_GOTO
+            case Op::Count:
+                break;
+        }
+        VM_FAIL("invalid opcode");
+#endif
+    }
+
+#undef VM_COMPARE
+#undef VM_ARITHMETIC
+#undef VM_NEXT
+#undef VM_CASE
+#undef VM_FAIL
+#undef VM_RC
+#undef VM_RB
+#undef VM_RA
+}
@@ -0,0 +1,138 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTVM_H
+#define SCRIPTVM_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ScriptHeap.h"
+#include "ScriptNative.h"
+#include "ScriptOpcodes.h"
+
+namespace Trin::Runtime::Script {
+    struct NativeBinding {
+        std::string name;
+        NativeFn fn;
+        uint8_t argSlots;       // Registers read from R[A] on
+        uint8_t resultSlots;    // Registers written from R[A] on
+    };
+
+/**
+ * Register based bytecode interpreter.
+ *
+ * Every call frame is a window of up to 255 registers on one shared value stack, a callee's
+ * window starts right after the function register of the caller, so arguments are already
+ * in place and calls copy nothing. Dispatch is a computed goto table on GCC and Clang and
+ * a plain switch elsewhere.
+ *
+ * Natives are bound once with bind() and called through the Native opcode by index. They
+ * read and write the caller's registers directly, a Vector3 travels as three numbers.
+ *
+ * The VM is single threaded, one instance per script context.
+ */
+class ScriptVM final : public ScriptRoots {
+public:
+    static constexpr uint32_t kStackSlots = 1 << 16;
+    static constexpr uint32_t kMaxFrames = 1024;
+
+    ScriptVM();
+    ~ScriptVM() override = default;
+
+    ScriptVM(const ScriptVM &) = delete;
+    ScriptVM &operator=(const ScriptVM &) = delete;
+
+    // ==============
+    //    GLOBALS
+    // ==============
+
+    /// Slot for a global, the existing one when the name is already defined
+    uint16_t defineGlobal(std::string_view name);
+
+    /// Slot of a defined global, -1 when there is none
+    [[nodiscard]] int32_t findGlobal(std::string_view name) const;
+
+    void setGlobal(uint16_t slot, Value value) { m_globals[slot] = value; }
+    [[nodiscard]] Value getGlobal(uint16_t slot) const { return m_globals[slot]; }
+    [[nodiscard]] uint32_t getGlobalCount() const { return static_cast<uint32_t>(m_globals.size()); }
+
+    // ==============
+    //    NATIVES
+    // ==============
+
+    /**
+     * @brief Exposes a captureless lambda to scripts
+     * @param name Looked up by findNative() when building code
+     * @param fn Arguments and result types need a NativeCodec
+     * @return Index for the Native opcode
+     */
+    template<typename Fn>
+    uint16_t bind(std::string_view name, Fn fn) {
+        (void)fn;
+        using Binder = NativeBinder<Fn>;
+        static_assert(Binder::kArgSlots < 256 && Binder::kResultSlots < 256, "Too many registers for one native");
+        return addNative(name, &Binder::call, Binder::kArgSlots, Binder::kResultSlots);
+    }
+
+    /// Index of a bound native, -1 when there is none
+    [[nodiscard]] int32_t findNative(std::string_view name) const;
+
+    [[nodiscard]] const NativeBinding &getNative(uint16_t index) const { return m_natives[index]; }
+    [[nodiscard]] uint32_t getNativeCount() const { return static_cast<uint32_t>(m_natives.size()); }
+
+    // ==============
+    //   EXECUTION
+    // ==============
+
+    /**
+     * @brief Runs a script function to completion
+     * @param function Function value, as returned by FunctionBuilder::finish()
+     * @param args Must match the function's parameter count
+     * @param result Receives the returned value, may be null
+     * @return False on a runtime error, getError() says what and where
+     */
+    bool call(Value function, std::span<const Value> args = {}, Value *result = nullptr);
+
+    [[nodiscard]] const std::string &getError() const { return m_error; }
+
+    /// Instructions dispatched over the VM's lifetime
+    [[nodiscard]] uint64_t getExecutedInstructions() const { return m_executed; }
+
+    [[nodiscard]] ScriptHeap &getHeap() { return m_heap; }
+
+    /// Keeps a function alive for as long as the VM, FunctionBuilder registers what it builds
+    void addFunction(FunctionObject *function) { m_functions.push_back(function); }
+
+    void markRoots(ScriptHeap &heap) override;
+
+private:
+    struct Frame {
+        const FunctionObject *function;
+        const uint32_t *pc;     // Where the caller resumes, saved when this frame calls out
+        Value *base;
+    };
+
+    uint16_t addNative(std::string_view name, NativeFn fn, uint32_t argSlots, uint32_t resultSlots);
+    bool enterFrame(const FunctionObject *function, Value *base, uint32_t argCount);
+    bool execute(size_t baseDepth);
+    bool fail(const uint32_t *pc, const std::string &message, size_t baseDepth);
+
+    ScriptHeap m_heap;
+    std::vector<Value> m_stack;
+    std::vector<Frame> m_frames;
+    std::vector<Value> m_globals;
+    std::vector<std::string> m_globalNames;
+    std::vector<NativeBinding> m_natives;
+    std::vector<FunctionObject *> m_functions;
+    std::string m_error;
+    uint64_t m_executed = 0;
+};
+
+}
+
+#endif //SCRIPTVM_H
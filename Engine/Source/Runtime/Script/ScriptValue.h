@@ -0,0 +1,76 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef SCRIPTVALUE_H
+#define SCRIPTVALUE_H
+
+#include <bit>
+#include <cstdint>
+
+namespace Trin::Runtime::Script {
+    struct Object;
+
+/**
+ * Script value packed into the bits of a double.
+ *
+ * Any double that is not a quiet NaN with bit 50 set is a plain number. Inside that NaN
+ * space the low bits tag nil, false and true, and with the sign bit set the low 48 bits
+ * hold an object pointer. Arithmetic passes NaN payloads through and data can carry any
+ * payload, so number() folds every NaN into the one canonical quiet NaN, which sits
+ * outside the tagged space. Numbers need no boxing or tag check before math.
+ */
+class Value {
+public:
+    static constexpr uint64_t kQuietNan = 0x7ffc000000000000ull;
+    static constexpr uint64_t kCanonicalNan = 0x7ff8000000000000ull;    // The only NaN a number ever holds
+    static constexpr uint64_t kSignBit = 0x8000000000000000ull;
+    static constexpr uint64_t kNilBits = kQuietNan | 1;
+    static constexpr uint64_t kFalseBits = kQuietNan | 2;
+    static constexpr uint64_t kTrueBits = kQuietNan | 3;
+
+    constexpr Value() = default;
+
+    static Value number(double value) {
+        // Only NaN compares unequal to itself, one well predicted branch on the hot path
+        return fromBits(value == value ? std::bit_cast<uint64_t>(value) : kCanonicalNan);
+    }
+    static constexpr Value nil() { return fromBits(kNilBits); }
+    static constexpr Value boolean(bool value) { return fromBits(value ? kTrueBits : kFalseBits); }
+    static Value object(Object *object) {
+        return fromBits(kSignBit | kQuietNan | reinterpret_cast<uintptr_t>(object));
+    }
+
+    static constexpr Value fromBits(uint64_t bits) {
+        Value value;
+        value.m_bits = bits;
+        return value;
+    }
+
+    [[nodiscard]] constexpr bool isNumber() const { return (m_bits & kQuietNan) != kQuietNan; }
+    [[nodiscard]] constexpr bool isNil() const { return m_bits == kNilBits; }
+    [[nodiscard]] constexpr bool isBool() const { return (m_bits | 1) == kTrueBits; }
+    [[nodiscard]] constexpr bool isObject() const {
+        return (m_bits & (kQuietNan | kSignBit)) == (kQuietNan | kSignBit);
+    }
+
+    /// Everything but nil and false counts as true in conditions
+    [[nodiscard]] constexpr bool isTruthy() const { return m_bits != kNilBits && m_bits != kFalseBits; }
+
+    [[nodiscard]] double asNumber() const { return std::bit_cast<double>(m_bits); }
+    [[nodiscard]] constexpr bool asBool() const { return m_bits == kTrueBits; }
+    [[nodiscard]] Object *asObject() const {
+        return reinterpret_cast<Object *>(static_cast<uintptr_t>(m_bits & ~(kSignBit | kQuietNan)));
+    }
+
+    [[nodiscard]] constexpr uint64_t bits() const { return m_bits; }
+
+private:
+    uint64_t m_bits = kNilBits;
+};
+
+static_assert(sizeof(Value) == 8, "Values must stay one machine word");
+
+}
+
+#endif //SCRIPTVALUE_H
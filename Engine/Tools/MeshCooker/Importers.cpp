@@ -0,0 +1,598 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include "Importers.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "Helpers/Console.h"
+
+using Trin::Helpers::Console;
+using Trin::Runtime::Asset::SourceMesh;
+
+namespace Trin::Tools {
+    namespace {
+        bool readFile(const std::string &path, std::vector<char> &out) {
+            std::ifstream stream(path, std::ios::binary | std::ios::ate);
+            if (!stream) {
+                return false;
+            }
+            out.resize(static_cast<size_t>(stream.tellg()));
+            stream.seekg(0);
+            stream.read(out.data(), static_cast<std::streamsize>(out.size()));
+            return static_cast<bool>(stream);
+        }
+
+        // ==============
+        //      OBJ
+        // ==============
+
+        struct ObjCorner {
+            int position;
+            int uv;
+            int normal;
+
+            bool operator==(const ObjCorner &other) const {
+                return position == other.position && uv == other.uv && normal == other.normal;
+            }
+        };
+
+        struct ObjCornerHash {
+            size_t operator()(const ObjCorner &corner) const {
+                return (static_cast<size_t>(corner.position) * 73856093u) ^
+                       (static_cast<size_t>(corner.uv) * 19349663u) ^
+                       (static_cast<size_t>(corner.normal) * 83492791u);
+            }
+        };
+
+        /// OBJ indices are one based and negative ones count back from the end, -1 means absent
+        int resolveObjIndex(const char *&cursor, const char *tokenEnd, size_t count) {
+            int value = 0;
+            const auto [end, error] = std::from_chars(cursor, tokenEnd, value);
+            if (error != std::errc{}) {
+                return -1;
+            }
+            cursor = end;
+            return value < 0 ? static_cast<int>(count) + value : value - 1;
+        }
+
+        // ==============
+        //      JSON
+        // ==============
+
+        /// Just enough JSON for glTF, numbers are doubles and objects keep their keys sorted
+        struct JsonValue {
+            using Array = std::vector<JsonValue>;
+            using Object = std::map<std::string, JsonValue, std::less<>>;
+
+            std::variant<std::nullptr_t, bool, double, std::string, std::shared_ptr<Array>, std::shared_ptr<Object>> value;
+
+            [[nodiscard]] const JsonValue *find(std::string_view key) const {
+                const auto *object = std::get_if<std::shared_ptr<Object>>(&value);
+                if (!object) {
+                    return nullptr;
+                }
+                const auto it = (*object)->find(key);
+                return it == (*object)->end() ? nullptr : &it->second;
+            }
+
+            [[nodiscard]] const Array *array() const {
+                const auto *array = std::get_if<std::shared_ptr<Array>>(&value);
+                return array ? array->get() : nullptr;
+            }
+
+            [[nodiscard]] double number(std::string_view key, double fallback) const {
+                const JsonValue *member = find(key);
+                const auto *number = member ? std::get_if<double>(&member->value) : nullptr;
+                return number ? *number : fallback;
+            }
+
+            [[nodiscard]] std::string string(std::string_view key) const {
+                const JsonValue *member = find(key);
+                const auto *text = member ? std::get_if<std::string>(&member->value) : nullptr;
+                return text ? *text : std::string();
+            }
+        };
+
+        class JsonParser {
+        public:
+            explicit JsonParser(std::string_view text) : m_text(text) {}
+
+            bool parse(JsonValue &out) {
+                return parseValue(out);
+            }
+
+        private:
+            void skipWhitespace() {
+                while (m_cursor < m_text.size() &&
+                       (m_text[m_cursor] == ' ' || m_text[m_cursor] == '\t' || m_text[m_cursor] == '\r' || m_text[m_cursor] == '\n')) {
+                    m_cursor++;
+                }
+            }
+
+            bool consume(char expected) {
+                skipWhitespace();
+                if (m_cursor < m_text.size() && m_text[m_cursor] == expected) {
+                    m_cursor++;
+                    return true;
+                }
+                return false;
+            }
+
+            bool parseString(std::string &out) {
+                if (!consume('"')) {
+                    return false;
+                }
+                while (m_cursor < m_text.size() && m_text[m_cursor] != '"') {
+                    char c = m_text[m_cursor++];
+                    if (c == '\\' && m_cursor < m_text.size()) {
+                        c = m_text[m_cursor++];
+                        switch (c) {
+                            case 'n': c = '\n'; break;
+                            case 't': c = '\t'; break;
+                            case 'r': c = '\r'; break;
+                            case 'b': c = '\b'; break;
+                            case 'f': c = '\f'; break;
+                            case 'u':
+                                // Names and uris in practice are ASCII, keep a placeholder
+                                m_cursor += 4;
+                                c = '?';
+                                break;
+                            default: break;
+                        }
+                    }
+                    out.push_back(c);
+                }
+                return consume('"');
+            }
+
+            bool parseValue(JsonValue &out) {
+                skipWhitespace();
+                if (m_cursor >= m_text.size()) {
+                    return false;
+                }
+
+                const char c = m_text[m_cursor];
+                if (c == '{') {
+                    m_cursor++;
+                    auto object = std::make_shared<JsonValue::Object>();
+                    if (!consume('}')) {
+                        do {
+                            std::string key;
+                            JsonValue member;
+                            if (!parseString(key) || !consume(':') || !parseValue(member)) {
+                                return false;
+                            }
+                            object->emplace(std::move(key), std::move(member));
+                        } while (consume(','));
+                        if (!consume('}')) {
+                            return false;
+                        }
+                    }
+                    out.value = std::move(object);
+                    return true;
+                }
+                if (c == '[') {
+                    m_cursor++;
+                    auto array = std::make_shared<JsonValue::Array>();
+                    if (!consume(']')) {
+                        do {
+                            array->emplace_back();
+                            if (!parseValue(array->back())) {
+                                return false;
+                            }
+                        } while (consume(','));
+                        if (!consume(']')) {
+                            return false;
+                        }
+                    }
+                    out.value = std::move(array);
+                    return true;
+                }
+                if (c == '"') {
+                    std::string text;
+                    if (!parseString(text)) {
+                        return false;
+                    }
+                    out.value = std::move(text);
+                    return true;
+                }
+                if (m_text.substr(m_cursor, 4) == "true") {
+                    m_cursor += 4;
+                    out.value = true;
+                    return true;
+                }
+                if (m_text.substr(m_cursor, 5) == "false") {
+                    m_cursor += 5;
+                    out.value = false;
+                    return true;
+                }
+                if (m_text.substr(m_cursor, 4) == "null") {
+                    m_cursor += 4;
+                    out.value = nullptr;
+                    return true;
+                }
+
+                // from_chars rejects a leading '+', which JSON does not allow either
+                double number = 0.0;
+                const char *begin = m_text.data() + m_cursor;
+                const auto [end, error] = std::from_chars(begin, m_text.data() + m_text.size(), number);
+                if (error != std::errc{}) {
+                    return false;
+                }
+                m_cursor += static_cast<size_t>(end - begin);
+                out.value = number;
+                return true;
+            }
+
+            std::string_view m_text;
+            size_t m_cursor = 0;
+        };
+
+        // ==============
+        //      GLTF
+        // ==============
+
+        constexpr uint32_t kGlbMagic = 0x46546C67;      // "glTF"
+        constexpr uint32_t kGlbChunkJson = 0x4E4F534A;  // "JSON"
+        constexpr uint32_t kGlbChunkBin = 0x004E4942;   // "BIN\0"
+
+        bool decodeBase64(std::string_view text, std::vector<char> &out) {
+            auto decode = [](char c) -> int {
+                if (c >= 'A' && c <= 'Z') return c - 'A';
+                if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if (c >= '0' && c <= '9') return c - '0' + 52;
+                if (c == '+') return 62;
+                if (c == '/') return 63;
+                return -1;
+            };
+
+            uint32_t accumulator = 0;
+            int bits = 0;
+            for (const char c : text) {
+                if (c == '=') {
+                    break;
+                }
+                const int value = decode(c);
+                if (value < 0) {
+                    return false;
+                }
+                accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+                bits += 6;
+                if (bits >= 8) {
+                    bits -= 8;
+                    out.push_back(static_cast<char>((accumulator >> bits) & 0xFF));
+                }
+            }
+            return true;
+        }
+
+        class GltfReader {
+        public:
+            GltfReader(const JsonValue &root, std::vector<std::vector<char>> buffers) :
+            m_root(root), m_buffers(std::move(buffers)) {}
+
+            /// Reads an accessor as floats, any normalized or plain component type
+            bool readFloats(int accessorIndex, uint32_t components, std::vector<float> &out) const {
+                return readAccessor(accessorIndex, [&](double value) { out.push_back(static_cast<float>(value)); }, components);
+            }
+
+            bool readIndices(int accessorIndex, uint32_t base, std::vector<uint32_t> &out) const {
+                return readAccessor(accessorIndex, [&](double value) { out.push_back(base + static_cast<uint32_t>(value)); }, 1);
+            }
+
+            [[nodiscard]] uint32_t count(int accessorIndex) const {
+                const JsonValue *accessor = element("accessors", accessorIndex);
+                return accessor ? static_cast<uint32_t>(accessor->number("count", 0)) : 0;
+            }
+
+        private:
+            [[nodiscard]] const JsonValue *element(std::string_view list, int index) const {
+                const JsonValue *member = m_root.find(list);
+                const JsonValue::Array *array = member ? member->array() : nullptr;
+                if (!array || index < 0 || static_cast<size_t>(index) >= array->size()) {
+                    return nullptr;
+                }
+                return &(*array)[static_cast<size_t>(index)];
+            }
+
+            template<typename Sink>
+            bool readAccessor(int accessorIndex, Sink &&sink, uint32_t expectedComponents) const {
+                const JsonValue *accessor = element("accessors", accessorIndex);
+                if (!accessor) {
+                    return false;
+                }
+                const JsonValue *view = element("bufferViews", static_cast<int>(accessor->number("bufferView", -1)));
+                if (!view) {
+                    return false;
+                }
+                const int bufferIndex = static_cast<int>(view->number("buffer", -1));
+                if (bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= m_buffers.size()) {
+                    return false;
+                }
+
+                static const std::map<std::string, uint32_t, std::less<>> kComponentCounts = {
+                    {"SCALAR", 1}, {"VEC2", 2}, {"VEC3", 3}, {"VEC4", 4}
+                };
+                const auto type = kComponentCounts.find(accessor->string("type"));
+                if (type == kComponentCounts.end() || type->second != expectedComponents) {
+                    return false;
+                }
+
+                const int componentType = static_cast<int>(accessor->number("componentType", 0));
+                const bool normalized = [&] {
+                    const JsonValue *flag = accessor->find("normalized");
+                    const auto *value = flag ? std::get_if<bool>(&flag->value) : nullptr;
+                    return value && *value;
+                }();
+                uint32_t componentSize = 0;
+                switch (componentType) {
+                    case 5120: case 5121: componentSize = 1; break;
+                    case 5122: case 5123: componentSize = 2; break;
+                    case 5125: case 5126: componentSize = 4; break;
+                    default: return false;
+                }
+
+                const uint32_t elementCount = static_cast<uint32_t>(accessor->number("count", 0));
+                const uint64_t elementSize = static_cast<uint64_t>(componentSize) * expectedComponents;
+                const uint64_t stride = view->number("byteStride", 0) > 0 ? static_cast<uint64_t>(view->number("byteStride", 0)) : elementSize;
+                const uint64_t start = static_cast<uint64_t>(view->number("byteOffset", 0)) + static_cast<uint64_t>(accessor->number("byteOffset", 0));
+                const std::vector<char> &buffer = m_buffers[static_cast<size_t>(bufferIndex)];
+                if (elementCount > 0 && start + stride * (elementCount - 1) + elementSize > buffer.size()) {
+                    return false;
+                }
+
+                for (uint32_t i = 0; i < elementCount; i++) {
+                    const char *source = buffer.data() + start + stride * i;
+                    for (uint32_t component = 0; component < expectedComponents; component++) {
+                        const char *data = source + component * componentSize;
+                        double value = 0.0;
+                        switch (componentType) {
+                            case 5120: { int8_t v; std::memcpy(&v, data, 1); value = normalized ? std::max(v / 127.0, -1.0) : v; break; }
+                            case 5121: { uint8_t v; std::memcpy(&v, data, 1); value = normalized ? v / 255.0 : v; break; }
+                            case 5122: { int16_t v; std::memcpy(&v, data, 2); value = normalized ? std::max(v / 32767.0, -1.0) : v; break; }
+                            case 5123: { uint16_t v; std::memcpy(&v, data, 2); value = normalized ? v / 65535.0 : v; break; }
+                            case 5125: { uint32_t v; std::memcpy(&v, data, 4); value = v; break; }
+                            case 5126: { float v; std::memcpy(&v, data, 4); value = v; break; }
+                            default: break;
+                        }
+                        sink(value);
+                    }
+                }
+                return true;
+            }
+
+            const JsonValue &m_root;
+            std::vector<std::vector<char>> m_buffers;
+        };
+    }
+
+    bool importObj(const std::string &path, SourceMesh &mesh) {
+        std::ifstream stream(path);
+        if (!stream) {
+            Console::error("Failed to open OBJ: " + path);
+            return false;
+        }
+
+        std::vector<float> positions;
+        std::vector<float> uvs;
+        std::vector<float> normals;
+        std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> corners;
+        std::vector<ObjCorner> unique;
+        std::vector<uint32_t> polygon;
+
+        std::string line;
+        while (std::getline(stream, line)) {
+            std::istringstream tokens(line);
+            std::string keyword;
+            tokens >> keyword;
+
+            if (keyword == "v") {
+                float x = 0, y = 0, z = 0;
+                tokens >> x >> y >> z;
+                positions.insert(positions.end(), {x, y, z});
+            } else if (keyword == "vt") {
+                float u = 0, v = 0;
+                tokens >> u >> v;
+                // OBJ puts the origin bottom left, Vulkan samples from the top left
+                uvs.insert(uvs.end(), {u, 1.0f - v});
+            } else if (keyword == "vn") {
+                float x = 0, y = 0, z = 0;
+                tokens >> x >> y >> z;
+                normals.insert(normals.end(), {x, y, z});
+            } else if (keyword == "f") {
+                polygon.clear();
+                std::string token;
+                while (tokens >> token) {
+                    // The terminator keeps the '/' checks in bounds, from_chars must stop before it
+                    const char *cursor = token.c_str();
+                    const char *tokenEnd = cursor + token.size();
+                    ObjCorner corner{resolveObjIndex(cursor, tokenEnd, positions.size() / 3), -1, -1};
+                    if (*cursor == '/') {
+                        cursor++;
+                        if (*cursor != '/') {
+                            corner.uv = resolveObjIndex(cursor, tokenEnd, uvs.size() / 2);
+                        }
+                        if (*cursor == '/') {
+                            cursor++;
+                            corner.normal = resolveObjIndex(cursor, tokenEnd, normals.size() / 3);
+                        }
+                    }
+                    if (corner.position < 0 || static_cast<size_t>(corner.position) >= positions.size() / 3) {
+                        Console::error("OBJ face references a missing vertex: " + path);
+                        return false;
+                    }
+
+                    const auto [it, inserted] = corners.try_emplace(corner, static_cast<uint32_t>(unique.size()));
+                    if (inserted) {
+                        unique.push_back(corner);
+                    }
+                    polygon.push_back(it->second);
+                }
+                for (size_t i = 2; i < polygon.size(); i++) {
+                    mesh.indices.insert(mesh.indices.end(), {polygon[0], polygon[i - 1], polygon[i]});
+                }
+            }
+        }
+
+        if (mesh.indices.empty()) {
+            Console::error("OBJ has no faces: " + path);
+            return false;
+        }
+
+        // Only keep attributes every corner has, partial ones would have to be made up
+        const bool hasUvs = std::all_of(unique.begin(), unique.end(), [&](const ObjCorner &c) {
+            return c.uv >= 0 && static_cast<size_t>(c.uv) < uvs.size() / 2;
+        });
+        const bool hasNormals = std::all_of(unique.begin(), unique.end(), [&](const ObjCorner &c) {
+            return c.normal >= 0 && static_cast<size_t>(c.normal) < normals.size() / 3;
+        });
+        for (const ObjCorner &corner : unique) {
+            mesh.positions.insert(mesh.positions.end(), &positions[corner.position * 3], &positions[corner.position * 3] + 3);
+            if (hasUvs) {
+                mesh.uvs.insert(mesh.uvs.end(), &uvs[corner.uv * 2], &uvs[corner.uv * 2] + 2);
+            }
+            if (hasNormals) {
+                mesh.normals.insert(mesh.normals.end(), &normals[corner.normal * 3], &normals[corner.normal * 3] + 3);
+            }
+        }
+        return true;
+    }
+
+    bool importGltf(const std::string &path, SourceMesh &mesh) {
+        std::vector<char> file;
+        if (!readFile(path, file)) {
+            Console::error("Failed to open glTF: " + path);
+            return false;
+        }
+
+        std::string_view json(file.data(), file.size());
+        std::vector<char> glbBinary;
+        uint32_t magic = 0;
+        if (file.size() >= 12) {
+            std::memcpy(&magic, file.data(), 4);
+        }
+        if (magic == kGlbMagic) {
+            // Header is magic, version, length, followed by length prefixed chunks
+            size_t offset = 12;
+            json = {};
+            while (offset + 8 <= file.size()) {
+                uint32_t chunkLength = 0;
+                uint32_t chunkType = 0;
+                std::memcpy(&chunkLength, file.data() + offset, 4);
+                std::memcpy(&chunkType, file.data() + offset + 4, 4);
+                offset += 8;
+                if (offset + chunkLength > file.size()) {
+                    break;
+                }
+                if (chunkType == kGlbChunkJson) {
+                    json = {file.data() + offset, chunkLength};
+                } else if (chunkType == kGlbChunkBin) {
+                    glbBinary.assign(file.data() + offset, file.data() + offset + chunkLength);
+                }
+                offset += chunkLength;
+            }
+        }
+
+        JsonValue root;
+        if (json.empty() || !JsonParser(json).parse(root)) {
+            Console::error("glTF has malformed JSON: " + path);
+            return false;
+        }
+
+        std::vector<std::vector<char>> buffers;
+        if (const JsonValue *list = root.find("buffers"); list && list->array()) {
+            const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+            for (const JsonValue &buffer : *list->array()) {
+                std::vector<char> data;
+                const std::string uri = buffer.string("uri");
+                if (uri.empty()) {
+                    data = glbBinary;
+                } else if (uri.rfind("data:", 0) == 0) {
+                    const size_t comma = uri.find(',');
+                    if (comma == std::string::npos || !decodeBase64(std::string_view(uri).substr(comma + 1), data)) {
+                        Console::error("glTF has a malformed data uri: " + path);
+                        return false;
+                    }
+                } else if (!readFile((directory / uri).string(), data)) {
+                    Console::error("glTF buffer is missing: " + (directory / uri).string());
+                    return false;
+                }
+                buffers.push_back(std::move(data));
+            }
+        }
+
+        const GltfReader reader(root, std::move(buffers));
+        bool missingNormals = false;
+        const JsonValue *meshes = root.find("meshes");
+        if (meshes && meshes->array()) {
+            for (const JsonValue &gltfMesh : *meshes->array()) {
+                const JsonValue *primitives = gltfMesh.find("primitives");
+                if (!primitives || !primitives->array()) {
+                    continue;
+                }
+                for (const JsonValue &primitive : *primitives->array()) {
+                    // 4 is TRIANGLES, strips and fans are rare enough in exported assets to skip
+                    const JsonValue *attributes = primitive.find("attributes");
+                    if (primitive.number("mode", 4) != 4 || !attributes) {
+                        continue;
+                    }
+                    const int position = static_cast<int>(attributes->number("POSITION", -1));
+                    const int normal = static_cast<int>(attributes->number("NORMAL", -1));
+                    const int uv = static_cast<int>(attributes->number("TEXCOORD_0", -1));
+                    const int indices = static_cast<int>(primitive.number("indices", -1));
+                    const uint32_t base = mesh.getVertexCount();
+                    const uint32_t count = reader.count(position);
+
+                    if (!reader.readFloats(position, 3, mesh.positions)) {
+                        Console::error("glTF primitive has unreadable positions: " + path);
+                        return false;
+                    }
+
+                    // Attributes missing from a primitive are zero filled, normals are dropped
+                    // entirely and recomputed by the cooker instead
+                    if (normal < 0 || !reader.readFloats(normal, 3, mesh.normals)) {
+                        missingNormals = true;
+                    }
+                    if (uv < 0 || !reader.readFloats(uv, 2, mesh.uvs)) {
+                        mesh.uvs.resize(mesh.positions.size() / 3 * 2, 0.0f);
+                    }
+
+                    if (indices >= 0) {
+                        if (!reader.readIndices(indices, base, mesh.indices)) {
+                            Console::error("glTF primitive has unreadable indices: " + path);
+                            return false;
+                        }
+                    } else {
+                        for (uint32_t i = 0; i < count; i++) {
+                            mesh.indices.push_back(base + i);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (mesh.indices.empty()) {
+            Console::error("glTF has no triangle primitives: " + path);
+            return false;
+        }
+        if (missingNormals || mesh.normals.size() != mesh.positions.size()) {
+            mesh.normals.clear();
+        }
+        if (mesh.uvs.size() != mesh.positions.size() / 3 * 2) {
+            mesh.uvs.clear();
+        }
+        return true;
+    }
+}
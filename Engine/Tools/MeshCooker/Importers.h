@@ -0,0 +1,30 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#ifndef IMPORTERS_H
+#define IMPORTERS_H
+
+#include <string>
+
+#include "Asset/MeshCooker.h"
+
+namespace Trin::Tools {
+    /**
+     * @brief Reads a Wavefront OBJ, polygons are fanned into triangles and v/vt/vn triples deduplicated
+     * @param path .obj file
+     * @param mesh Receives every object in the file as one mesh
+     * @return False when the file could not be read or has no faces
+     */
+    bool importObj(const std::string &path, Runtime::Asset::SourceMesh &mesh);
+
+    /**
+     * @brief Reads the triangle primitives of a glTF 2.0 file, .gltf with external or embedded buffers, or .glb
+     * @param path .gltf or .glb file
+     * @param mesh Receives every triangle primitive as one mesh, node transforms are not applied
+     * @return False when the file could not be read or has no triangle primitives
+     */
+    bool importGltf(const std::string &path, Runtime::Asset::SourceMesh &mesh);
+}
+
+#endif //IMPORTERS_H
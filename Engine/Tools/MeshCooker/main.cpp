@@ -0,0 +1,97 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "Importers.h"
+#include "Asset/MeshCooker.h"
+#include "Asset/MeshLoader.h"
+
+using namespace Trin;
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: TrinVK_MeshCooker <input.obj|.gltf|.glb> <output.tmesh> [--float] [--no-reorder]" << std::endl;
+    }
+
+    /// Times opening the cooked file and touching every page, the way a loader feeding a staging buffer would
+    double measureLoadMs(const std::string &path, uint64_t &checksum) {
+        const auto start = std::chrono::steady_clock::now();
+        Runtime::Asset::CookedMesh mesh;
+        if (!mesh.open(path)) {
+            return -1.0;
+        }
+        for (const auto block : {mesh.getVertexData(), mesh.getIndexData()}) {
+            for (size_t offset = 0; offset < block.size(); offset += 4096) {
+                checksum += static_cast<uint8_t>(block[offset]);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printUsage();
+        return -1;
+    }
+
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+    Runtime::Asset::MeshCookOptions options;
+    for (int i = 3; i < argc; i++) {
+        if (std::strcmp(argv[i], "--float") == 0) {
+            options.quantize = false;
+        } else if (std::strcmp(argv[i], "--no-reorder") == 0) {
+            options.optimizeVertexCache = false;
+        } else {
+            printUsage();
+            return -1;
+        }
+    }
+
+    Runtime::Asset::SourceMesh mesh;
+    const std::string extension = std::filesystem::path(input).extension().string();
+    const auto importStart = std::chrono::steady_clock::now();
+    bool imported = false;
+    if (extension == ".obj") {
+        imported = Tools::importObj(input, mesh);
+    } else if (extension == ".gltf" || extension == ".glb") {
+        imported = Tools::importGltf(input, mesh);
+    } else {
+        std::cerr << "Unsupported mesh format: " << extension << std::endl;
+    }
+    if (!imported) {
+        return -1;
+    }
+    const double importMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - importStart).count();
+
+    Runtime::Asset::MeshCookStats stats;
+    const auto cookStart = std::chrono::steady_clock::now();
+    if (!Runtime::Asset::MeshCooker::cook(mesh, output, options, &stats)) {
+        return -1;
+    }
+    const double cookMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cookStart).count();
+
+    uint64_t checksum = 0;
+    const double loadMs = measureLoadMs(output, checksum);
+
+    const double floatBytes = static_cast<double>(sizeof(Runtime::Asset::FloatVertex));
+    const double cookedBytes = static_cast<double>(stats.fileBytes) / stats.vertexCount;
+    std::cout << "Cooked " << input << " -> " << output << "\n"
+              << "  vertices:          " << stats.vertexCount << "\n"
+              << "  triangles:         " << stats.triangleCount << "\n"
+              << "  vertex stride:     " << stats.vertexStride << " bytes (float layout " << floatBytes << ")\n"
+              << "  bytes per vertex:  " << cookedBytes << " including indices and header\n"
+              << "  ACMR:              " << stats.acmrBefore << " -> " << stats.acmrAfter << "\n"
+              << "  max pos error:     " << stats.maxPositionError << "\n"
+              << "  source import:     " << importMs << " ms\n"
+              << "  cook:              " << cookMs << " ms\n"
+              << "  cooked load:       " << loadMs << " ms (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
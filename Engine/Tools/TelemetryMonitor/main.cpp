@@ -0,0 +1,248 @@
+//
+// Created by lepag on 10/18/26.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Core/TelemetryLayout.h"
+
+using namespace Trin::Runtime::Core;
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: TrinVK_TelemetryMonitor [--name <segment>] [--interval <ms>] [--once]" << std::endl;
+    }
+
+    /// Read only view of the engine's segment, the engine never waits on anything done here
+    class SegmentView {
+    public:
+        ~SegmentView() { detach(); }
+
+        bool attach(const char *name) {
+            detach();
+#ifdef _WIN32
+            m_mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+            if (!m_mapping) {
+                return false;
+            }
+            m_segment = static_cast<const TelemetryLayout::Segment *>(
+                MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, sizeof(TelemetryLayout::Segment)));
+#else
+            const int fd = shm_open(name, O_RDONLY, 0);
+            if (fd < 0) {
+                return false;
+            }
+            struct stat info{};
+            if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(TelemetryLayout::Segment)) {
+                void *memory = mmap(nullptr, sizeof(TelemetryLayout::Segment), PROT_READ, MAP_SHARED, fd, 0);
+                m_segment = memory == MAP_FAILED ? nullptr : static_cast<const TelemetryLayout::Segment *>(memory);
+            }
+            close(fd);
+#endif
+            if (m_segment && (m_segment->magic != TelemetryLayout::kMagic ||
+                              m_segment->version != TelemetryLayout::kVersion ||
+                              m_segment->size != sizeof(TelemetryLayout::Segment))) {
+                std::cerr << "Segment " << name << " has layout version " << m_segment->version
+                          << ", this monitor reads version " << TelemetryLayout::kVersion << std::endl;
+                detach();
+            }
+            return m_segment != nullptr;
+        }
+
+        void detach() {
+#ifdef _WIN32
+            if (m_segment) {
+                UnmapViewOfFile(m_segment);
+            }
+            if (m_mapping) {
+                CloseHandle(m_mapping);
+                m_mapping = nullptr;
+            }
+#else
+            if (m_segment) {
+                munmap(const_cast<TelemetryLayout::Segment *>(m_segment), sizeof(TelemetryLayout::Segment));
+            }
+#endif
+            m_segment = nullptr;
+        }
+
+        /// Copies a consistent snapshot, false when the engine kept writing through every attempt
+        bool read(TelemetryLayout::Segment &out) const {
+            for (int attempt = 0; attempt < 100; attempt++) {
+                const uint64_t before = m_segment->sequence.load(std::memory_order_acquire);
+                if (before & 1) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                out.processId = m_segment->processId;
+                out.frame = m_segment->frame;
+                out.publishNs = m_segment->publishNs;
+                out.counterCount = std::min(m_segment->counterCount, TelemetryLayout::kMaxCounters);
+                out.histogramCount = std::min(m_segment->histogramCount, TelemetryLayout::kMaxHistograms);
+                std::memcpy(out.counters, m_segment->counters, sizeof(out.counters));
+                std::memcpy(out.histograms, m_segment->histograms, sizeof(out.histograms));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_segment->sequence.load(std::memory_order_relaxed) == before) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool attached() const { return m_segment != nullptr; }
+
+    private:
+        const TelemetryLayout::Segment *m_segment = nullptr;
+#ifdef _WIN32
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+
+    /// Upper bound of the bucket holding the q-th fraction of the samples
+    uint64_t percentile(const uint64_t *buckets, uint64_t count, double q) {
+        const auto target = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (uint32_t bucket = 0; bucket < TelemetryLayout::kHistogramBuckets; bucket++) {
+            seen += buckets[bucket];
+            if (seen >= target) {
+                return TelemetryLayout::bucketUpperBound(bucket);
+            }
+        }
+        return TelemetryLayout::bucketUpperBound(TelemetryLayout::kHistogramBuckets - 1);
+    }
+
+    /// Counters show their rate and histograms their distribution since the previous snapshot
+    void print(const TelemetryLayout::Segment &current, const TelemetryLayout::Segment &previous, bool hasPrevious) {
+        const double seconds = hasPrevious ? static_cast<double>(current.publishNs - previous.publishNs) * 1e-9 : 0.0;
+        const bool rates = hasPrevious && seconds > 0.0 && current.processId == previous.processId;
+
+        std::printf("TrinVK telemetry, pid %u, frame %llu", current.processId,
+                    static_cast<unsigned long long>(current.frame));
+        if (rates) {
+            std::printf(", %.1f frames/s", static_cast<double>(current.frame - previous.frame) / seconds);
+        }
+        std::printf("\n\n%-40s %16s %14s\n", "counter", "value", "per second");
+        for (uint32_t i = 0; i < current.counterCount; i++) {
+            const TelemetryLayout::CounterEntry &entry = current.counters[i];
+            std::printf("%-40s %16llu", entry.name, static_cast<unsigned long long>(entry.value));
+            if (entry.kind == TelemetryLayout::CounterKind::Counter && rates && i < previous.counterCount) {
+                std::printf(" %14.1f", static_cast<double>(entry.value - previous.counters[i].value) / seconds);
+            }
+            std::printf("\n");
+        }
+
+        std::printf("\n%-40s %10s %12s %10s %10s %10s\n", "histogram", "samples", "mean", "p50 <=", "p90 <=", "p99 <=");
+        for (uint32_t i = 0; i < current.histogramCount; i++) {
+            const TelemetryLayout::HistogramEntry &entry = current.histograms[i];
+            uint64_t buckets[TelemetryLayout::kHistogramBuckets];
+            uint64_t count = entry.count;
+            uint64_t sum = entry.sum;
+            std::memcpy(buckets, entry.buckets, sizeof(buckets));
+            // Only the samples recorded since the last snapshot, totals when nothing new came in
+            if (rates && i < previous.histogramCount && entry.count > previous.histograms[i].count) {
+                for (uint32_t bucket = 0; bucket < TelemetryLayout::kHistogramBuckets; bucket++) {
+                    buckets[bucket] -= previous.histograms[i].buckets[bucket];
+                }
+                count -= previous.histograms[i].count;
+                sum -= previous.histograms[i].sum;
+            }
+            if (count == 0) {
+                std::printf("%-40s %10s\n", entry.name, "-");
+                continue;
+            }
+            std::printf("%-40s %10llu %12.1f %10llu %10llu %10llu\n", entry.name,
+                        static_cast<unsigned long long>(count), static_cast<double>(sum) / static_cast<double>(count),
+                        static_cast<unsigned long long>(percentile(buckets, count, 0.5)),
+                        static_cast<unsigned long long>(percentile(buckets, count, 0.9)),
+                        static_cast<unsigned long long>(percentile(buckets, count, 0.99)));
+        }
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string name = TelemetryLayout::kDefaultSegmentName;
+    int intervalMs = 500;
+    bool once = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            intervalMs = std::max(50, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else {
+            printUsage();
+            return -1;
+        }
+    }
+
+    // Segments are close to 30KB, kept off the stack
+    auto current = std::make_unique<TelemetryLayout::Segment>();
+    auto previous = std::make_unique<TelemetryLayout::Segment>();
+    bool hasPrevious = false;
+    auto lastProgress = std::chrono::steady_clock::now();
+
+    SegmentView view;
+    for (;;) {
+        if (!view.attached() && !view.attach(name.c_str())) {
+            if (once) {
+                std::cerr << "No telemetry segment named " << name << ", is the engine running?" << std::endl;
+                return 1;
+            }
+            std::printf("\x1b[H\x1b[2JWaiting for the engine to publish %s ...\n", name.c_str());
+            std::fflush(stdout);
+            hasPrevious = false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            continue;
+        }
+
+        if (!view.read(*current)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // A segment that stopped moving belongs to an engine that exited, look for a new one
+        const auto now = std::chrono::steady_clock::now();
+        if (!hasPrevious || current->frame != previous->frame || current->processId != previous->processId) {
+            lastProgress = now;
+        } else if (now - lastProgress > std::chrono::seconds(2)) {
+            view.detach();
+            continue;
+        }
+
+        if (!once) {
+            std::printf("\x1b[H\x1b[2J");
+        }
+        print(*current, *previous, hasPrevious);
+        if (once) {
+            return 0;
+        }
+
+        std::swap(current, previous);
+        hasPrevious = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Compares the per-frame timings of two replays of the same capture.
+
+Usage: compare_replay.py baseline.csv current.csv [--threshold 10] [--top 10]
+
+Both files come from TrinVK --replay <capture> --headless --timings <file.csv>. Exits with 1
+when the mean or any percentile slowed down by more than the threshold, so it can gate CI.
+"""
+
+import argparse
+import csv
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8", newline="") as file:
+        return [(int(row["recorded_us"]), int(row["cpu_us"])) for row in csv.DictReader(file)]
+
+
+def summarize(times):
+    ordered = sorted(times)
+    def percentile(q):
+        return ordered[int(q * (len(ordered) - 1))]
+    return {
+        "mean": sum(ordered) / len(ordered),
+        "p50": percentile(0.5),
+        "p95": percentile(0.95),
+        "p99": percentile(0.99),
+        "max": ordered[-1],
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percent slowdown that counts as a regression (default 10)")
+    parser.add_argument("--top", type=int, default=10,
+                        help="how many of the most slowed down frames to list (default 10)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    if not baseline or not current:
+        print("One of the files has no frames")
+        return 1
+
+    # Frame by frame only means something when both runs replayed the same capture
+    frames = min(len(baseline), len(current))
+    if len(baseline) != len(current):
+        print(f"Frame counts differ ({len(baseline)} vs {len(current)}), comparing the first {frames}")
+    if any(baseline[i][0] != current[i][0] for i in range(frames)):
+        print("Recorded delta times differ, these replays are not of the same capture")
+        return 1
+
+    before = summarize([cpu for _, cpu in baseline[:frames]])
+    after = summarize([cpu for _, cpu in current[:frames]])
+    regressions = 0
+    print(f"{'frame time (us)':<16} {'baseline':>12} {'current':>12} {'change':>9}")
+    for key in before:
+        old, new = before[key], after[key]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{key:<16} {old:>12.1f} {new:>12.1f} {change:>+8.1f}%{flag}")
+
+    slowest = sorted(range(frames), key=lambda i: current[i][1] - baseline[i][1], reverse=True)[:args.top]
+    print(f"\n{'frame':<16} {'baseline':>12} {'current':>12} {'delta':>9}")
+    for i in slowest:
+        print(f"{i:<16} {baseline[i][1]:>12} {current[i][1]:>12} {current[i][1] - baseline[i][1]:>+9}")
+
+    if regressions:
+        print(f"\n{regressions} statistic(s) regressed by more than {args.threshold}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,11 +1,39 @@
+#include <cstring>
 #include <iostream>
 #include "Core/Engine.h"
 
 using namespace Trin::Runtime::Core;
 
-int main() {
+namespace {
+    void printUsage() {
+        std::cout << "Usage: TrinVK [--capture <file.tcap>] [--replay <file.tcap> [--headless] [--timings <file.csv>]]"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    EngineCreateInfo info;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            info.capturePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            info.replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--timings") == 0 && i + 1 < argc) {
+            info.timingsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            info.headless = true;
+        } else {
+            printUsage();
+            return -1;
+        }
+    }
+    if (!info.capturePath.empty() && !info.replayPath.empty()) {
+        std::cerr << "--capture and --replay can't be combined" << std::endl;
+        return -1;
+    }
+
     try {
-        const auto engine = std::make_unique<Engine>();
+        const auto engine = std::make_unique<Engine>(info);
         if (bool result = engine->init(); !result) {
             std::cerr << "Failed to initialize engine!" << std::endl;
             return -1;